@@ -29,6 +29,31 @@ namespace neblib
 
         /// @brief Resets the internal state of the controller.
         virtual void reset() = 0;
+
+        /// @brief Resets the internal state of the controller, continuing from a previous output.
+        ///
+        /// Used when motions are chained so the next motion starts from the
+        /// current output instead of from zero. Defaults to a regular reset.
+        ///
+        /// @param initialOutput Output the controller continues from
+        virtual void reset(double /*initialOutput*/)
+        {
+            reset();
+        }
+    };
+
+    /// @brief Conditions for exiting a motion early so the next motion can continue from it
+    ///
+    /// exitRadius: Remaining error at which the motion exits without stopping
+    /// minSpeed: Minimum output magnitude held until the motion exits
+    struct ChainConditions
+    {
+        double exitRadius;
+        double minSpeed;
+
+        explicit ChainConditions(
+            double exitRadius,
+            double minSpeed = 0.0);
     };
 
     /// @brief Proportional-Integral-Derivative (PID) controller with optional slew limiting
@@ -98,6 +123,7 @@ namespace neblib
         bool hasPreviousError; //< True if previousError is valid
         double previousOutput; //< Output from the previous iteration, used in slew limiting
         int timeSettled; //< Time (ms) within settle tolerance
+        bool carriedOver; //< True if the controller was reset with an initial output
 
     public:
         /// @brief Construct a new PID controller
@@ -128,6 +154,14 @@ namespace neblib
 
         /// @brief Resets PID state
         void reset() override;
+
+        /// @brief Resets PID state, continuing from a previous output
+        ///
+        /// Slew limiting starts from initialOutput and the derivative term
+        /// is skipped on the first iteration to avoid a kick.
+        ///
+        /// @param initialOutput Output the PID continues from
+        void reset(double initialOutput) override;
     };
 
 } // namespace neblib
\ No newline at end of file
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "neblib/loop_stats.hpp"
+#include "neblib/util.hpp"
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief Response curve for a joystick axis, precomputed into a lookup table
+    ///
+    /// The curve maps stick magnitude to output magnitude and is mirrored for
+    /// negative inputs. Inputs inside the deadband give 0; past it the curve
+    /// starts at minOutput and reaches 100 at full stick.
+    class InputCurve
+    {
+    public:
+        /// @brief Number of entries in the lookup table
+        static constexpr std::size_t tableSize = 256;
+
+        /// @brief Shape of the curve past the deadband
+        ///
+        /// Linear: output follows the stick
+        /// Cubic: blend of linear and cubic, curvature from 0 (linear) to 1 (cubic)
+        /// Exponential: (e^(curvature * x) - 1) / (e^curvature - 1), higher curvature is softer near center
+        enum Type
+        {
+            Linear,
+            Cubic,
+            Exponential
+        };
+
+    private:
+        float deadband; //< Stick magnitude (0 to 1) below which the output is 0
+        float table[tableSize]; //< Output magnitude (0 to 1) at evenly spaced stick magnitudes from 0 to 1
+
+    public:
+        /// @brief Creates a new InputCurve
+        ///
+        /// @param type shape of the curve
+        /// @param deadband stick magnitude (%) below which the output is 0
+        /// @param curvature strength of the curve, see neblib::InputCurve::Type
+        /// @param minOutput output magnitude (%) just past the deadband
+        InputCurve(
+            Type type = Linear,
+            double deadband = 0.0,
+            double curvature = 0.0,
+            double minOutput = 0.0);
+
+        /// @brief Applies the curve to a stick position
+        ///
+        /// @param input stick position from -100 to 100
+        /// @return output from -100 to 100
+        double apply(double input) const;
+    };
+
+    /// @brief Samples a controller's joysticks at a fixed rate and shapes them with input curves
+    ///
+    /// Run update() as a sensing job of a neblib::Executor, and drive from
+    /// the shaped values in a control job of the same tick so a stick
+    /// movement reaches the motors within one tick. Call markApplied() once
+    /// the values have been sent to the drivetrain to measure that latency.
+    class DriverInput
+    {
+    public:
+        /// @brief Joystick axes of a V5 controller
+        enum Axis
+        {
+            Axis1,
+            Axis2,
+            Axis3,
+            Axis4
+        };
+
+    private:
+        // ---------- Devices ----------
+        vex::controller &controller;
+
+        // ---------- Configuration ----------
+        neblib::InputCurve curves[4];
+        int periodMS;
+
+        // ---------- State ----------
+        double values[4];
+        std::uint64_t sampleTime; //< System time (us) of the last sample
+        bool applied; //< True once the last sample's latency was recorded
+        neblib::LoopStats::Histogram latency;
+        bool running;
+
+    public:
+        /// @brief Creates a new DriverInput with linear curves on every axis
+        ///
+        /// @param controller V5 controller to read
+        /// @param periodMS time (ms) between samples when run with begin()
+        DriverInput(
+            vex::controller &controller,
+            int periodMS = 10);
+
+        /// @brief Sets the curve of an axis
+        ///
+        /// @param axis axis to set
+        /// @param curve curve applied to the axis
+        void setCurve(
+            Axis axis,
+            const neblib::InputCurve &curve);
+
+        /// @brief Reads every axis once and applies its curve
+        void update();
+
+        /// @brief Begins a self-contained loop sampling the axes until stopped
+        ///
+        /// Designed to work best with neblib::spawnTask() at a high priority
+        ///
+        /// @return returns 0 when the loop ends
+        int begin();
+
+        /// @brief Stops the sampling loop
+        void stop();
+
+        /// @brief Gets the shaped value of an axis from the last sample
+        ///
+        /// @param axis axis to get
+        /// @return value from -100 to 100
+        double get(Axis axis) const;
+
+        /// @brief Records the time from the last sample to now as stick-to-command latency
+        ///
+        /// Only the first call after each sample is recorded.
+        void markApplied();
+
+        /// @brief Gets the histogram of stick-to-command latency
+        /// @return latency of every applied sample, in microseconds
+        const neblib::LoopStats::Histogram &getLatency() const;
+    };
+
+} // namespace neblib
@@ -0,0 +1,762 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "neblib/control_algorithms.hpp"
+#include "neblib/executor.hpp"
+#include "neblib/loop_stats.hpp"
+#include "neblib/motor_output.hpp"
+#include "neblib/path_recording.hpp"
+#include "neblib/position_tracking.hpp"
+#include "neblib/sensor_snapshot.hpp"
+#include "neblib/telemetry.hpp"
+#include "neblib/units.hpp"
+#include "neblib/util.hpp"
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief State shared by every chassis: sensors, controllers, and chaining state
+    ///
+    /// Chassis policies derive from this class and add their motors and kinematics.
+    class Chassis
+    {
+    protected:
+        // ---------- Devices ----------
+        vex::inertial &imu;
+        neblib::PositionTracking *positionTracking;
+        neblib::SensorSnapshot *sensorSnapshot; //< Shared sensor values, nullptr to read the devices directly
+
+        // ---------- Controllers ----------
+        neblib::FeedbackController *linearController;
+        neblib::FeedbackController *angularController;
+        neblib::FeedbackController *turnController;
+        neblib::FeedbackController *swingController;
+
+        // ---------- Output ----------
+        neblib::MotorOutput *motorOutput; //< Output stage motor commands go through, nullptr to command the motors directly
+
+        // ---------- Scheduling ----------
+        neblib::Executor *executor; //< Executor whose ticks pace motion loops, nullptr to sleep instead
+        std::uint32_t controlStep; //< Handoff of the executor the motion loop was last woken for
+
+        // ---------- Telemetry ----------
+        neblib::TelemetryQueue *telemetry; //< Queue motion loops record into, nullptr to not record
+        std::uint64_t previousRecordTime; //< System time (us) of the last record
+        vex::motor_group *telemetryGroups[neblib::TelemetryRecord::voltageCount]; //< Motor groups whose voltages are recorded, in record order
+        std::size_t telemetryGroupCount;
+        double commandedVoltages[neblib::TelemetryRecord::voltageCount]; //< Voltage last commanded to each telemetry group
+
+        // ---------- Loop Statistics ----------
+        neblib::LoopStats motionStats[4]; //< Timing of each kind of motion loop, indexed by neblib::TelemetryRecord::Source
+        neblib::LoopStats *activeStats; //< Statistics of the running motion
+
+        // ---------- Playback ----------
+        double playbackForwardGain; //< Volts of drive per inch the recording is ahead
+        double playbackLateralGain; //< Volts of strafe per inch the recording is to the side
+        double playbackHeadingGain; //< Volts of turn per degree of heading error
+
+        // ---------- Chaining State ----------
+        std::atomic<bool> cancelRequested; //< Set by cancelMotion(), cleared when a motion begins
+        bool chained; //< True if the last motion exited early without stopping
+        double previousLinearOutput; //< Last linear output of a chained motion
+        double previousAngularOutput; //< Last angular output of a chained motion
+
+        /// @brief Creates the shared chassis state
+        ///
+        /// @param imu reference to a VEX V5 Inertial sensor
+        /// @param positionTracking pointer to any neblib::PositionTracking object or nullptr
+        Chassis(
+            vex::inertial &imu,
+            neblib::PositionTracking *positionTracking);
+
+        /// @brief Resets a controller, carrying over the previous output if the last motion was chained
+        ///
+        /// @param controller the controller to reset
+        /// @param previousOutput output the controller continues from when chained
+        void resetController(
+            neblib::FeedbackController *controller,
+            double previousOutput);
+
+        /// @brief Waits for the next iteration of a motion loop
+        ///
+        /// Steps in the Control stage of the executor's next tick when one
+        /// is set, so each iteration sees that tick's sensor and odometry
+        /// data and its commands go out in the same tick's Output stage.
+        ///
+        /// @return time (ms) an iteration represents
+        int waitForTick();
+
+        /// @brief Ends a motion loop paced by waitForTick(), call once the loop exits
+        void leaveControl();
+
+        /// @brief Adds a motor group to the voltages recorded in telemetry, call from the constructor
+        ///
+        /// @param motors motor group, recorded in the order groups are added
+        void addTelemetryGroup(vex::motor_group &motors);
+
+        /// @brief Remembers the voltage commanded to a motor group for the next record
+        ///
+        /// @param motors motor group being commanded
+        /// @param voltage voltage (V) commanded
+        void setCommandedVoltage(
+            vex::motor_group &motors,
+            double voltage);
+
+        /// @brief Commands a motor group, through the output stage when the group is registered with one
+        ///
+        /// @param motors motor group to command
+        /// @param voltage voltage to apply
+        /// @param unit unit of the voltage
+        void spinMotors(
+            vex::motor_group &motors,
+            double voltage,
+            vex::voltageUnits unit = vex::voltageUnits::volt);
+
+        /// @brief Commands a motor group, through the output stage when the group is registered with one
+        ///
+        /// The output stage only takes voltages, so percent velocities are
+        /// sent to it as the same percent of 12 volts. Other velocity units
+        /// always go straight to the motors and are recorded as 0 volts.
+        ///
+        /// @param motors motor group to command
+        /// @param velocity velocity to spin at
+        /// @param unit unit of the velocity
+        void spinMotors(
+            vex::motor_group &motors,
+            double velocity,
+            vex::velocityUnits unit);
+
+        /// @brief Stops a motor group, resetting its rate limiting in the output stage if it has one
+        ///
+        /// @param motors motor group to stop
+        /// @param brakeType how the motors stop
+        void stopMotors(
+            vex::motor_group &motors,
+            vex::brakeType brakeType);
+
+        /// @brief Gets the heading of the IMU, from the sensor snapshot when one is set
+        /// @return heading in degrees
+        double currentHeading();
+
+        /// @brief Gets the rotation of the IMU, from the sensor snapshot when one is set
+        /// @return rotation in degrees
+        double currentRotation();
+
+        /// @brief Gets the position of a tracker wheel, from the sensor snapshot when one is set
+        /// @param trackerWheel tracker wheel to read
+        /// @return position of the tracker wheel
+        double trackerPosition(neblib::TrackerWheel &trackerWheel);
+
+        /// @brief Starts timing the loop of a new motion and clears any earlier cancel request
+        ///
+        /// @param source kind of motion starting
+        void beginMotion(neblib::TelemetryRecord::Source source);
+
+        /// @brief Determines if cancelMotion() was called since the running motion began
+        /// @return true if the motion loop should stop
+        bool motionCancelled() const;
+
+        /// @brief Records an iteration of a motion loop if a telemetry queue is set
+        ///
+        /// Never blocks, the record is dropped if the queue is full.
+        ///
+        /// @param source motion making the record
+        /// @param linearError error fed to the linear controller
+        /// @param angularError error fed to the angular, turn, or swing controller
+        /// @param linearOutput output of the linear controller
+        /// @param angularOutput output of the angular, turn, or swing controller
+        void record(
+            neblib::TelemetryRecord::Source source,
+            double linearError,
+            double angularError,
+            double linearOutput,
+            double angularOutput);
+
+    public:
+        /// @brief Sets the linear controller for the drivetrain
+        ///
+        /// @param linearController pointer to any neblib::FeedbackController
+        void setLinearController(neblib::FeedbackController *linearController);
+
+        /// @brief Sets the angular controller, used to hold heading while driving
+        ///
+        /// @param angularController pointer to any neblib::FeedbackController
+        void setAngularController(neblib::FeedbackController *angularController);
+
+        /// @brief Sets the controller used for turns, falls back to the angular controller when unset
+        ///
+        /// @param turnController pointer to any neblib::FeedbackController
+        void setTurnController(neblib::FeedbackController *turnController);
+
+        /// @brief Sets the controller used for swings
+        ///
+        /// @param swingController pointer to any neblib::FeedbackController
+        void setSwingController(neblib::FeedbackController *swingController);
+
+        /// @brief Paces motion loops with an executor instead of a fixed 10ms sleep
+        ///
+        /// @param executor pointer to a running neblib::Executor or nullptr
+        void setExecutor(neblib::Executor *executor);
+
+        /// @brief Records every iteration of every motion loop into a telemetry queue
+        ///
+        /// Motions must run from a single task, the queue only supports one producer.
+        ///
+        /// @param telemetry pointer to a neblib::TelemetryQueue or nullptr
+        void setTelemetry(neblib::TelemetryQueue *telemetry);
+
+        /// @brief Reads sensors from a shared snapshot instead of the devices
+        ///
+        /// @param sensorSnapshot pointer to a neblib::SensorSnapshot updated every tick, or nullptr
+        void setSensorSnapshot(neblib::SensorSnapshot *sensorSnapshot);
+
+        /// @brief Sets how hard recording playback corrects drift from the recorded path
+        ///
+        /// Corrections are added to the recorded commands. A chassis that
+        /// can't strafe turns toward the side of the path instead.
+        ///
+        /// @param forwardGain volts of drive per inch the recording is ahead or behind
+        /// @param lateralGain volts of strafe per inch the recording is to the side
+        /// @param headingGain volts of turn per degree of heading error
+        void setPlaybackGains(
+            double forwardGain,
+            double lateralGain,
+            double headingGain);
+
+        /// @brief Stops the running motion at its next iteration, safe to call from another task
+        ///
+        /// The motion stops the drivetrain and returns the time it ran. A
+        /// request made before a motion begins is dropped, so it cannot stop
+        /// the next one.
+        void cancelMotion();
+
+        /// @brief Gets the loop timing statistics of a kind of motion
+        ///
+        /// @param source kind of motion: Drive, Turn, Swing, or Arc
+        /// @return statistics of every loop iteration of that kind of motion so far
+        neblib::LoopStats &getMotionStats(neblib::TelemetryRecord::Source source);
+    };
+
+    /// @brief Drivetrain with motion algorithms shared by every chassis type
+    ///
+    /// The loop of each motion is written once here. Everything specific to
+    /// how the chassis moves comes from the Kinematics policy it derives
+    /// from, resolved at compile time. A policy derives from neblib::Chassis
+    /// and provides:
+    ///
+    /// typedef Timeout, the type motion timeouts take: int (ms) or neblib::Time
+    /// typedef Elapsed and static Elapsed toElapsed(int milliseconds), the type motions return their time in,
+    ///     passing negative error codes through unchanged
+    /// static constexpr bool canSwing, true if swing() can hold one side still
+    /// void swing(vex::turnType side, double output), only called when canSwing is true
+    /// void stop(vex::brakeType brakeType)
+    /// void rotate(double output)
+    /// double pointHeading(const Pose &current, double x, double y)
+    /// double angularError(const Pose &current, const Pose &target, double distance)
+    /// bool atPose(const Pose &current, const Pose &target, double distance), true once driving cannot get closer
+    /// void driveToward(const Pose &current, const Pose &target, double drive, double turn)
+    /// void driveCommand(double drive, double strafe, double turn)
+    ///
+    /// @tparam Kinematics chassis policy, neblib::DifferentialChassis or a neblib::HolonomicChassis
+    template <class Kinematics>
+    class Drivetrain : public Kinematics
+    {
+    public:
+        /// @brief Type every timeout is given in, set by the chassis policy
+        typedef typename Kinematics::Timeout Timeout;
+
+        /// @brief Type every motion returns its time in, set by the chassis policy
+        ///
+        /// Seconds as a double for neblib::StandardDrive, as it always
+        /// returned, and int milliseconds for holonomic drivetrains.
+        typedef typename Kinematics::Elapsed Elapsed;
+
+    private:
+        /// @brief State of the pose or turn motion in progress, kept between iterations
+        struct Motion
+        {
+            enum Kind
+            {
+                None,
+                Drive,
+                Turn,
+                Swing
+            };
+
+            Kind kind;
+            bool stepped; //< True if started with a start function and advanced by stepMotion()
+            bool pending; //< True until the first stepMotion() of a stepped motion
+            neblib::Pose target; //< Target pose of a drive, or the heading or rotation of a turn in heading
+            neblib::ChainConditions chain;
+            bool continuous; //< True if a turn or swing targets the unwrapped rotation
+            neblib::FeedbackController *controller; //< Controller of a turn
+            vex::turnType side; //< Direction of a swing, the other side holds still
+            double lower; //< Range a swing's heading error is wrapped into
+            double upper;
+            int timeout;
+            double minOutput;
+            double maxOutput;
+            int time; //< Time (ms) the motion has run
+
+            Motion()
+                : kind(None),
+                  stepped(false),
+                  pending(false),
+                  target(),
+                  chain(0.0),
+                  continuous(false),
+                  controller(nullptr),
+                  side(vex::turnType::right),
+                  lower(-180.0),
+                  upper(180.0),
+                  timeout(0),
+                  minOutput(0.0),
+                  maxOutput(0.0),
+                  time(0)
+            {
+            }
+        };
+
+        Motion motion;
+
+    public:
+        /// @brief Creates a new Drivetrain, forwarding all arguments to the chassis policy
+        template <class... Args>
+        Drivetrain(Args &&...args)
+            : Kinematics(std::forward<Args>(args)...),
+              motion()
+        {
+        }
+
+        /// @brief Drives to a pose
+        ///
+        /// @param x target 'x' position
+        /// @param y target 'y' position
+        /// @param heading target heading
+        /// @param timeout time (ms) before the motion exits
+        /// @param minOutput minimum controller output
+        /// @param maxOutput maximum controller output
+        /// @return time the motion took in Elapsed units, -1 without position tracking, -2 without a linear controller
+        Elapsed driveToPose(
+            double x,
+            double y,
+            double heading,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Drives to a pose, exiting early within a radius of the target without stopping
+        ///
+        /// The next motion continues from the current output instead of
+        /// resetting from zero, so consecutive motions do not stop at every point.
+        ///
+        /// @param x target 'x' position
+        /// @param y target 'y' position
+        /// @param heading target heading
+        /// @param chain exit radius and minimum speed of the motion
+        /// @param timeout time (ms) before the motion exits
+        /// @param minOutput minimum controller output
+        /// @param maxOutput maximum controller output
+        /// @return time the motion took in Elapsed units, -1 without position tracking, -2 without a linear controller
+        Elapsed driveToPose(
+            double x,
+            double y,
+            double heading,
+            neblib::ChainConditions chain,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Drives to a point
+        ///
+        /// @param x target 'x' position
+        /// @param y target 'y' position
+        /// @param timeout time (ms) before the motion exits
+        /// @param minOutput minimum controller output
+        /// @param maxOutput maximum controller output
+        /// @return time the motion took in Elapsed units, -1 without position tracking, -2 without a linear controller
+        Elapsed driveTo(
+            double x,
+            double y,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Drives to a point, exiting early within a radius of the target without stopping
+        ///
+        /// @param x target 'x' position
+        /// @param y target 'y' position
+        /// @param chain exit radius and minimum speed of the motion
+        /// @param timeout time (ms) before the motion exits
+        /// @param minOutput minimum controller output
+        /// @param maxOutput maximum controller output
+        /// @return time the motion took in Elapsed units, -1 without position tracking, -2 without a linear controller
+        Elapsed driveTo(
+            double x,
+            double y,
+            neblib::ChainConditions chain,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Drives through a list of poses, chaining every pose but the last
+        ///
+        /// @param path poses to drive through, in order
+        /// @param count number of poses
+        /// @param chain exit conditions used for every pose but the last
+        /// @param timeout time (ms) before the whole path exits
+        /// @param minOutput minimum controller output
+        /// @param maxOutput maximum controller output
+        /// @return time the path took in Elapsed units, negative if a motion could not run
+        Elapsed followPath(
+            const neblib::Pose *path,
+            std::size_t count,
+            neblib::ChainConditions chain,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Drives through a list of poses, chaining every pose but the last
+        ///
+        /// @param path poses to drive through, in order
+        /// @param chain exit conditions used for every pose but the last
+        /// @param timeout time (ms) before the whole path exits
+        /// @param minOutput minimum controller output
+        /// @param maxOutput maximum controller output
+        /// @return time the path took in Elapsed units, negative if a motion could not run
+        Elapsed followPath(
+            const std::vector<neblib::Pose> &path,
+            neblib::ChainConditions chain,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Plays back a recording of a driven path in time with when it was recorded
+        ///
+        /// Every iteration sends the recorded command for the time since the
+        /// start plus a correction toward the recorded pose, see
+        /// setPlaybackGains(). Start from the recording's first pose.
+        ///
+        /// @param recording recording to play back, loaded before the motion starts
+        /// @param timeout time (ms) before the motion exits
+        /// @return time the motion took in Elapsed units, -1 without position tracking, -2 if the recording is empty
+        Elapsed followRecording(
+            const neblib::PathRecording &recording,
+            Timeout timeout = Timeout(noTimeout()));
+
+        /// @brief Turns relative to the current rotation
+        ///
+        /// @param degrees degrees to turn, clockwise is positive
+        /// @param timeout time (ms) before the motion exits
+        /// @param minOutput minimum controller output
+        /// @param maxOutput maximum controller output
+        /// @return time the motion took in Elapsed units, -1 without a turn or angular controller
+        Elapsed turnFor(
+            double degrees,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Turns to a heading using the shortest direction
+        ///
+        /// @param heading target heading
+        /// @param timeout time (ms) before the motion exits
+        /// @param minOutput minimum controller output
+        /// @param maxOutput maximum controller output
+        /// @return time the motion took in Elapsed units, -1 without a turn or angular controller
+        Elapsed turnTo(
+            double heading,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        // ---------- Stepped Motions ----------
+        // The same motions without blocking, for neblib::RoutineScheduler or any
+        // loop that calls stepMotion() once per tick. Only one motion runs at a time.
+
+        /// @brief Starts driving to a pose, see driveToPose()
+        /// @return 0 if started, -1 without position tracking, -2 without a linear controller
+        int startDriveToPose(
+            double x,
+            double y,
+            double heading,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Starts driving to a pose, exiting early within a radius of the target without stopping
+        /// @return 0 if started, -1 without position tracking, -2 without a linear controller
+        int startDriveToPose(
+            double x,
+            double y,
+            double heading,
+            neblib::ChainConditions chain,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Starts driving to a point, see driveTo()
+        /// @return 0 if started, -1 without position tracking, -2 without a linear controller
+        int startDriveTo(
+            double x,
+            double y,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Starts driving to a point, exiting early within a radius of the target without stopping
+        /// @return 0 if started, -1 without position tracking, -2 without a linear controller
+        int startDriveTo(
+            double x,
+            double y,
+            neblib::ChainConditions chain,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Starts turning relative to the current rotation, see turnFor()
+        /// @return 0 if started, -1 without a turn or angular controller
+        int startTurnFor(
+            double degrees,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Starts turning to a heading, see turnTo()
+        /// @return 0 if started, -1 without a turn or angular controller
+        int startTurnTo(
+            double heading,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity());
+
+        /// @brief Runs one iteration of a motion begun with a start function
+        ///
+        /// Call once per tick after the sensors update. Blocking motions
+        /// running in another task are left alone.
+        ///
+        /// @param elapsed time (ms) since the last step, ignored on the first step of a motion
+        /// @return true while the motion is running
+        bool stepMotion(int elapsed);
+
+        /// @brief Determines if a motion begun with a start function is still running
+        /// @return true until the motion settles, exits early, times out, or is cancelled
+        bool isMoving() const;
+
+        /// @brief Gets how long the last motion begun with a start function has run
+        /// @return time (ms) the motion has run
+        int getMotionTime() const;
+
+        // ---------- Swings ----------
+        // Turns with one side held still, only on chassis that can swing. Templates so
+        // that calling them on any other drivetrain fails to compile.
+
+        /// @brief Swings relative to the current rotation
+        ///
+        /// @param direction side that drives, right swings clockwise
+        /// @param degrees degrees to swing
+        /// @return time the motion took in Elapsed units, -1 without a swing controller
+        template <class K = Kinematics>
+        Elapsed swingFor(
+            vex::turnType direction,
+            double degrees,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity())
+        {
+            static_assert(K::canSwing, "this drivetrain cannot hold one side still to swing");
+            const double target = this->currentRotation() + ((direction == vex::turnType::right) ? degrees : -degrees);
+            return runSwing(direction, target, true, 0.0, 0.0, neblib::toTimeout(timeout), minOutput, maxOutput);
+        }
+
+        /// @brief Swings to a heading, driving one side only forward or only backward
+        ///
+        /// @param turnDirection side that drives, right swings clockwise
+        /// @param direction direction the driving side spins
+        /// @return time the motion took in Elapsed units, -1 without a swing controller
+        template <class K = Kinematics>
+        Elapsed swingTo(
+            vex::turnType turnDirection,
+            vex::directionType direction,
+            double heading,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity())
+        {
+            static_assert(K::canSwing, "this drivetrain cannot hold one side still to swing");
+            const bool forward = direction == vex::directionType::fwd;
+            return runSwing(turnDirection, heading, false, (forward) ? 0.0 : -360.0, (forward) ? 360.0 : 0.0, neblib::toTimeout(timeout), minOutput, maxOutput);
+        }
+
+        /// @brief Swings to a heading the shortest way
+        ///
+        /// @param turnDirection side that drives, right swings clockwise
+        /// @return time the motion took in Elapsed units, -1 without a swing controller
+        template <class K = Kinematics>
+        Elapsed swingTo(
+            vex::turnType turnDirection,
+            double heading,
+            Timeout timeout = Timeout(noTimeout()),
+            double minOutput = -infinity(),
+            double maxOutput = infinity())
+        {
+            static_assert(K::canSwing, "this drivetrain cannot hold one side still to swing");
+            return runSwing(turnDirection, heading, false, -180.0, 180.0, neblib::toTimeout(timeout), minOutput, maxOutput);
+        }
+
+        /// @brief Swings to a heading the shortest way
+        template <class K = Kinematics>
+        Elapsed swingTo(
+            vex::turnType turnDirection,
+            Angle heading,
+            Time timeout = Time(noTimeout()),
+            Voltage minOutput = Voltage(-infinity()),
+            Voltage maxOutput = Voltage(infinity()))
+        {
+            return swingTo<K>(turnDirection, heading.degrees(), Timeout(timeout), minOutput.volts(), maxOutput.volts());
+        }
+
+        // ---------- Typed Overloads ----------
+        // Same motions taking neblib/units.hpp quantities, converted at the call
+
+        /// @brief Drives to a pose
+        /// @return time the motion took in Elapsed units, -1 without position tracking, -2 without a linear controller
+        Elapsed driveToPose(
+            Length x,
+            Length y,
+            Angle heading,
+            Time timeout = Time(noTimeout()),
+            Voltage minOutput = Voltage(-infinity()),
+            Voltage maxOutput = Voltage(infinity()));
+
+        /// @brief Drives to a pose, exiting early within a radius of the target without stopping
+        /// @return time the motion took in Elapsed units, -1 without position tracking, -2 without a linear controller
+        Elapsed driveToPose(
+            Length x,
+            Length y,
+            Angle heading,
+            neblib::ChainConditions chain,
+            Time timeout = Time(noTimeout()),
+            Voltage minOutput = Voltage(-infinity()),
+            Voltage maxOutput = Voltage(infinity()));
+
+        /// @brief Drives to a point
+        /// @return time the motion took in Elapsed units, -1 without position tracking, -2 without a linear controller
+        Elapsed driveTo(
+            Length x,
+            Length y,
+            Time timeout = Time(noTimeout()),
+            Voltage minOutput = Voltage(-infinity()),
+            Voltage maxOutput = Voltage(infinity()));
+
+        /// @brief Drives to a point, exiting early within a radius of the target without stopping
+        /// @return time the motion took in Elapsed units, -1 without position tracking, -2 without a linear controller
+        Elapsed driveTo(
+            Length x,
+            Length y,
+            neblib::ChainConditions chain,
+            Time timeout = Time(noTimeout()),
+            Voltage minOutput = Voltage(-infinity()),
+            Voltage maxOutput = Voltage(infinity()));
+
+        /// @brief Turns relative to the current rotation, clockwise is positive
+        /// @return time the motion took in Elapsed units, -1 without a turn or angular controller
+        Elapsed turnFor(
+            Angle angle,
+            Time timeout = Time(noTimeout()),
+            Voltage minOutput = Voltage(-infinity()),
+            Voltage maxOutput = Voltage(infinity()));
+
+        /// @brief Turns to a heading using the shortest direction
+        /// @return time the motion took in Elapsed units, -1 without a turn or angular controller
+        Elapsed turnTo(
+            Angle heading,
+            Time timeout = Time(noTimeout()),
+            Voltage minOutput = Voltage(-infinity()),
+            Voltage maxOutput = Voltage(infinity()));
+
+    private:
+        /// @brief Resets the controllers and fills in the motion state for a pose motion
+        /// @return 0 on success, -1 without position tracking, -2 without a linear controller
+        int beginPose(
+            const neblib::Pose &target,
+            neblib::ChainConditions chain,
+            int timeout,
+            double minOutput,
+            double maxOutput);
+
+        /// @brief Resets the controller and fills in the motion state for a turn
+        /// @return 0 on success, -1 without a turn or angular controller
+        int beginTurn(
+            double target,
+            bool continuous,
+            int timeout,
+            double minOutput,
+            double maxOutput);
+
+        /// @brief Resets the swing controller and runs a swing until it settles
+        ///
+        /// @param side side that drives
+        /// @param target target heading, or rotation if continuous
+        /// @param continuous true to use the unwrapped rotation instead of heading
+        /// @param lower lowest heading error, unused if continuous
+        /// @param upper highest heading error, unused if continuous
+        /// @return time the motion took in Elapsed units, -1 without a swing controller
+        Elapsed runSwing(
+            vex::turnType side,
+            double target,
+            bool continuous,
+            double lower,
+            double upper,
+            int timeout,
+            double minOutput,
+            double maxOutput);
+
+        /// @brief Drives one side of a chassis that can swing
+        template <bool CanSwing>
+        typename std::enable_if<CanSwing>::type swingSide(
+            vex::turnType side,
+            double output)
+        {
+            this->swing(side, output);
+        }
+
+        /// @brief Never called, keeps advanceMotion() compiling for chassis that cannot swing
+        template <bool CanSwing>
+        typename std::enable_if<!CanSwing>::type swingSide(
+            vex::turnType,
+            double)
+        {
+        }
+
+        /// @brief Runs one iteration of the motion in progress, finishing it once it exits
+        ///
+        /// @param elapsed time (ms) since the last iteration
+        /// @return true while the motion is running
+        bool advanceMotion(int elapsed);
+
+        /// @brief Advances the motion in progress every tick until it finishes
+        /// @return time (ms) the motion took
+        int runMotion();
+
+        /// @brief Runs a turn until the controller settles
+        ///
+        /// @param target target heading, or rotation if continuous
+        /// @param continuous true to use the unwrapped rotation instead of heading
+        /// @param timeout time (ms) before the motion exits
+        /// @param minOutput minimum controller output
+        /// @param maxOutput maximum controller output
+        /// @return time (ms) the motion took, -1 without a turn or angular controller
+        int turn(
+            double target,
+            bool continuous,
+            int timeout,
+            double minOutput,
+            double maxOutput);
+    };
+
+} // namespace neblib
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief Runs periodic jobs in a fixed order from a single task
+    ///
+    /// Every tick runs the due jobs stage by stage (sensing, estimation,
+    /// control, output, telemetry), so each job sees the results of the
+    /// stages before it from the same tick. Jobs with a longer period run
+    /// on every n-th tick. Execution time and deadline overruns are
+    /// tracked per job and per tick.
+    ///
+    /// Loops running in their own task, such as motions, step in the
+    /// Control stage through waitForControl(). The executor wakes them
+    /// after its Control jobs and holds the Output stage until they have
+    /// stepped, so their commands go out in the same tick as the sensor
+    /// data they were computed from.
+    class Executor
+    {
+    public:
+        /// @brief Order jobs run in within a tick
+        enum Stage
+        {
+            Sensing,
+            Estimation,
+            Control,
+            Output,
+            Telemetry
+        };
+
+        /// @brief Maximum number of jobs an executor can hold
+        static constexpr std::size_t maxJobs = 16;
+
+        /// @brief Timing statistics of a job, times in microseconds
+        ///
+        /// runs: Number of times the job ran
+        /// overruns: Number of runs longer than the job's budget
+        /// lastTime: Execution time of the last run
+        /// maxTime: Longest execution time
+        /// totalTime: Sum of all execution times
+        struct JobStats
+        {
+            std::uint32_t runs;
+            std::uint32_t overruns;
+            std::uint32_t lastTime;
+            std::uint32_t maxTime;
+            std::uint64_t totalTime;
+
+            JobStats();
+        };
+
+        /// @brief Timing statistics of the executor, times in microseconds
+        ///
+        /// ticks: Number of ticks run
+        /// deadlineMisses: Number of ticks whose jobs ran past the tick period
+        /// maxTickTime: Longest time spent running the jobs of a tick
+        /// maxLateness: Longest delay between when a tick should have started and when it did
+        /// controlTimeouts: Number of ticks that stopped waiting for a loop to step before Output
+        struct TickStats
+        {
+            std::uint32_t ticks;
+            std::uint32_t deadlineMisses;
+            std::uint32_t maxTickTime;
+            std::uint32_t maxLateness;
+            std::uint32_t controlTimeouts;
+
+            TickStats();
+        };
+
+    private:
+        /// @brief A registered job
+        struct Job
+        {
+            const char *name;
+            Stage stage;
+            int periodTicks;
+            std::uint32_t budget;
+            void (*function)(void *);
+            void *context;
+            JobStats stats;
+        };
+
+        /// @brief Wakes loops waiting in waitForControl() and waits for them to step, at most half a tick
+        ///
+        /// @param tickStart system time (us) the tick started
+        void handOffControl(std::uint64_t tickStart);
+
+        /// @brief Calls a member function of an object, used to register member functions as jobs
+        template <class T, void (T::*Method)()>
+        static void callMember(void *object)
+        {
+            (static_cast<T *>(object)->*Method)();
+        }
+
+        // ---------- Configuration ----------
+        int tickMS;
+        Job jobs[maxJobs];
+        std::size_t jobCount;
+
+        // ---------- State ----------
+        bool running;
+        std::atomic<std::uint32_t> tick;
+        TickStats tickStats;
+
+        // ---------- Control Handoff ----------
+        vex::mutex controlLock; //< Guards the counts below and controlPoint together
+        std::atomic<std::uint32_t> controlPoint; //< Number of control handoffs so far
+        int controlWaiting; //< Loops waiting for the next handoff
+        std::atomic<int> controlStepping; //< Loops woken by the last handoff that have not stepped yet
+
+    public:
+        /// @brief Creates a new Executor
+        ///
+        /// @param tickMS period of a tick in milliseconds
+        Executor(int tickMS = 10);
+
+        /// @brief Registers a job, keeping jobs ordered by stage and then by registration order
+        ///
+        /// Jobs should be registered before the executor begins.
+        ///
+        /// @param name name used when reporting statistics
+        /// @param stage stage the job runs in
+        /// @param function function to run
+        /// @param context pointer passed to the function
+        /// @param periodTicks run the job every periodTicks ticks
+        /// @param budget execution time (us) above which a run counts as an overrun, 0 for the whole tick
+        /// @return index of the job, -1 if the executor is full
+        int addJob(
+            const char *name,
+            Stage stage,
+            void (*function)(void *),
+            void *context,
+            int periodTicks = 1,
+            std::uint32_t budget = 0);
+
+        /// @brief Registers a member function of an object as a job
+        ///
+        /// Example: executor.addJob<neblib::PositionTracking, &neblib::PositionTracking::update>("odometry", neblib::Executor::Estimation, &odom);
+        ///
+        /// @tparam T class of the object
+        /// @tparam Method member function to run
+        /// @param name name used when reporting statistics
+        /// @param stage stage the job runs in
+        /// @param object object to run the member function on
+        /// @param periodTicks run the job every periodTicks ticks
+        /// @param budget execution time (us) above which a run counts as an overrun, 0 for the whole tick
+        /// @return index of the job, -1 if the executor is full
+        template <class T, void (T::*Method)()>
+        int addJob(
+            const char *name,
+            Stage stage,
+            T *object,
+            int periodTicks = 1,
+            std::uint32_t budget = 0)
+        {
+            return addJob(name, stage, &callMember<T, Method>, object, periodTicks, budget);
+        }
+
+        /// @brief Begins running ticks until stopped
+        ///
+        /// Designed to work best with neblib::spawnTask() at a high priority
+        ///
+        /// @return returns 0 when the loop ends
+        int begin();
+
+        /// @brief Stops the tick loop
+        void stop();
+
+        /// @brief Blocks until the next tick has run all of its jobs
+        ///
+        /// Lets loops outside the executor act on the data of a complete tick.
+        ///
+        /// @return period of a tick in milliseconds
+        int waitForTick();
+
+        /// @brief Blocks until the Control stage of the next tick
+        ///
+        /// Call once per iteration of a loop, after applying its commands.
+        /// The call tells the executor the previous step is done, letting
+        /// the Output stage send those commands in the tick they were
+        /// computed for, then waits to be woken for the next step. A loop
+        /// that stops calling must call leaveControl() when it exits.
+        ///
+        /// @param step handoff the loop was last woken for, keep one per loop starting at 0
+        /// @return period of a tick in milliseconds
+        int waitForControl(std::uint32_t &step);
+
+        /// @brief Tells the executor a loop woken by waitForControl() has exited
+        ///
+        /// Counts the loop's last step as done, so the tick's Output stage
+        /// doesn't wait for a step that will never come.
+        ///
+        /// @param step handoff the loop was last woken for, the same one passed to waitForControl()
+        void leaveControl(std::uint32_t &step);
+
+        /// @brief Gets the number of ticks run so far
+        /// @return number of ticks
+        std::uint32_t getTick();
+
+        /// @brief Gets the period of a tick
+        /// @return period in milliseconds
+        int getTickMS();
+
+        /// @brief Gets the number of registered jobs
+        /// @return number of jobs
+        std::size_t getJobCount();
+
+        /// @brief Gets the name of a job
+        /// @param index index of the job
+        /// @return name of the job, nullptr if the index is out of range
+        const char *getJobName(std::size_t index);
+
+        /// @brief Gets the timing statistics of a job
+        /// @param index index of the job
+        /// @return statistics of the job, zeroed if the index is out of range
+        JobStats getJobStats(std::size_t index);
+
+        /// @brief Gets the timing statistics of the ticks
+        /// @return statistics of the ticks
+        TickStats getTickStats();
+    };
+
+} // namespace neblib
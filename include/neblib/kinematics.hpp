@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+
+namespace neblib
+{
+    /// @brief Wheel mixing matrix for holonomic drivetrains
+    ///
+    /// Maps a chassis command (drive, strafe, turn) to one command per wheel:
+    /// wheel[i] = drive * drive[i] + strafe * strafe[i] + turn * turn[i]
+    ///
+    /// @tparam Wheels number of independently driven wheels
+    template <std::size_t Wheels>
+    class HolonomicKinematics
+    {
+    public:
+        /// @brief Mixing coefficients of a single wheel
+        ///
+        /// drive: contribution of the forward command
+        /// strafe: contribution of the sideways command, right is positive
+        /// turn: contribution of the turn command, clockwise is positive
+        struct Wheel
+        {
+            double drive;
+            double strafe;
+            double turn;
+
+            Wheel(
+                double drive,
+                double strafe,
+                double turn)
+                : drive(drive),
+                  strafe(strafe),
+                  turn(turn)
+            {
+            }
+        };
+
+    private:
+        // Stored column-major so each chassis component scales one contiguous column
+        double driveColumn[Wheels];
+        double strafeColumn[Wheels];
+        double turnColumn[Wheels];
+
+    public:
+        /// @brief Constructs a mixing matrix from per-wheel coefficients
+        ///
+        /// Wheels not listed are left with all coefficients at 0.0
+        ///
+        /// @param wheels coefficients of each wheel, in motor order
+        HolonomicKinematics(std::initializer_list<Wheel> wheels)
+        {
+            std::size_t i = 0;
+            for (const Wheel &wheel : wheels)
+            {
+                if (i >= Wheels)
+                    break;
+                driveColumn[i] = wheel.drive;
+                strafeColumn[i] = wheel.strafe;
+                turnColumn[i] = wheel.turn;
+                i++;
+            }
+            for (; i < Wheels; i++)
+            {
+                driveColumn[i] = 0.0;
+                strafeColumn[i] = 0.0;
+                turnColumn[i] = 0.0;
+            }
+        }
+
+        /// @brief Computes the command of every wheel
+        ///
+        /// If any wheel would exceed maxOutput, every wheel is scaled down by
+        /// the same factor so the direction of travel and the ratio between
+        /// translation and rotation are preserved.
+        ///
+        /// @param drive forward command
+        /// @param strafe sideways command, right is positive
+        /// @param turn turn command, clockwise is positive
+        /// @param maxOutput largest command a wheel can accept
+        /// @param outputs resulting wheel commands, in motor order
+        void mix(
+            double drive,
+            double strafe,
+            double turn,
+            double maxOutput,
+            double (&outputs)[Wheels]) const
+        {
+            double largest = 0.0;
+            for (std::size_t i = 0; i < Wheels; i++)
+            {
+                outputs[i] = drive * driveColumn[i] + strafe * strafeColumn[i] + turn * turnColumn[i];
+                const double magnitude = std::abs(outputs[i]);
+                if (magnitude > largest)
+                    largest = magnitude;
+            }
+
+            if (largest <= maxOutput)
+                return;
+
+            const double scale = maxOutput / largest;
+            for (std::size_t i = 0; i < Wheels; i++)
+                outputs[i] *= scale;
+        }
+    };
+
+    /// @brief Mixing matrix for an X-drive
+    ///
+    /// Wheel order: left front, right front, left back, right back
+    ///
+    /// @return neblib::HolonomicKinematics for four wheels
+    HolonomicKinematics<4> xDriveKinematics();
+
+    /// @brief Mixing matrix for a mecanum drive
+    ///
+    /// Wheel order: left front, right front, left back, right back
+    ///
+    /// @param strafeGain scale applied to strafing to make up for roller slip
+    /// @return neblib::HolonomicKinematics for four wheels
+    HolonomicKinematics<4> mecanumKinematics(double strafeGain = 1.0);
+
+    /// @brief Mixing matrix for an H-drive with a single centered strafe wheel
+    ///
+    /// Wheel order: left, right, strafe
+    ///
+    /// @param strafeGain scale applied to the strafe wheel
+    /// @return neblib::HolonomicKinematics for three wheels
+    HolonomicKinematics<3> hDriveKinematics(double strafeGain = 1.0);
+
+    /// @brief Mixing matrix for an asterisk drive (X-drive with two forward facing center wheels)
+    ///
+    /// Wheel order: left front, right front, left back, right back, left center, right center
+    ///
+    /// @param centerRatio distance from the turning center to a center wheel divided by the distance to a corner wheel
+    /// @return neblib::HolonomicKinematics for six wheels
+    HolonomicKinematics<6> asteriskKinematics(double centerRatio = 0.5);
+
+} // namespace neblib
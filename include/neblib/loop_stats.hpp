@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief Constant memory timing statistics of a periodic loop
+    ///
+    /// Records the period between the starts of consecutive iterations and
+    /// the execution time of each iteration into fixed-width histograms, so
+    /// percentiles can be queried at runtime without storing every sample.
+    /// An iteration whose execution time exceeds the target period counts
+    /// as an overrun.
+    class LoopStats
+    {
+    public:
+        /// @brief Number of buckets in each histogram, the last bucket also holds every larger sample
+        static constexpr std::size_t bucketCount = 64;
+
+        /// @brief Fixed-width histogram of times in microseconds
+        class Histogram
+        {
+        private:
+            std::uint32_t bucketWidth;
+            std::uint32_t buckets[bucketCount];
+            std::uint32_t count;
+            std::uint32_t min;
+            std::uint32_t max;
+            std::uint64_t total;
+
+        public:
+            /// @brief Creates an empty Histogram
+            /// @param bucketWidth width (us) of each bucket
+            explicit Histogram(std::uint32_t bucketWidth);
+
+            /// @brief Adds a sample
+            /// @param value time (us)
+            void add(std::uint32_t value);
+
+            /// @brief Removes every sample
+            void reset();
+
+            /// @brief Estimates a percentile from the histogram
+            ///
+            /// @param percentile percentile from 0 to 100
+            /// @return upper edge (us) of the bucket containing the percentile, never above the maximum, 0 without samples
+            std::uint32_t getPercentile(double percentile) const;
+
+            /// @brief Gets the number of samples
+            std::uint32_t getCount() const;
+
+            /// @brief Gets the smallest sample (us), 0 without samples
+            std::uint32_t getMin() const;
+
+            /// @brief Gets the largest sample (us)
+            std::uint32_t getMax() const;
+
+            /// @brief Gets the mean of the samples (us), 0 without samples
+            double getMean() const;
+
+            /// @brief Gets the width (us) of each bucket
+            std::uint32_t getBucketWidth() const;
+
+            /// @brief Gets the number of samples in a bucket
+            /// @param index index of the bucket, covering [index * width, (index + 1) * width)
+            /// @return number of samples, 0 if the index is out of range
+            std::uint32_t getBucket(std::size_t index) const;
+        };
+
+    private:
+        // ---------- Configuration ----------
+        const char *name;
+        std::uint32_t targetPeriod;
+
+        // ---------- State ----------
+        Histogram period;
+        Histogram execution;
+        std::uint32_t overruns;
+        std::uint64_t iterationStart; //< System time (us) the current iteration started, 0 if none
+        std::uint64_t previousStart; //< System time (us) the previous iteration started, 0 after a restart
+
+    public:
+        /// @brief Creates a new LoopStats
+        ///
+        /// @param name name used when printing
+        /// @param targetPeriod period (us) the loop is meant to run at, also the overrun threshold
+        /// @param periodBucketWidth width (us) of each period histogram bucket
+        /// @param executionBucketWidth width (us) of each execution time histogram bucket
+        LoopStats(
+            const char *name,
+            std::uint32_t targetPeriod = 10000,
+            std::uint32_t periodBucketWidth = 500,
+            std::uint32_t executionBucketWidth = 100);
+
+        /// @brief Marks the start of an iteration, recording the period since the previous start
+        void startIteration();
+
+        /// @brief Marks the end of an iteration, recording its execution time
+        void endIteration();
+
+        /// @brief Starts a new run of the loop, the next iteration does not record a period
+        ///
+        /// Call when a loop starts again after a pause, such as at the start of a motion.
+        void restart();
+
+        /// @brief Removes every sample
+        void reset();
+
+        /// @brief Gets the name given on construction
+        const char *getName() const;
+
+        /// @brief Gets the histogram of periods between iteration starts
+        const Histogram &getPeriod() const;
+
+        /// @brief Gets the histogram of iteration execution times
+        const Histogram &getExecution() const;
+
+        /// @brief Gets the number of iterations that took longer than the target period
+        std::uint32_t getOverruns() const;
+
+        /// @brief Writes a one line summary, for logs
+        ///
+        /// @param buffer buffer the summary is written to
+        /// @param size size of the buffer
+        /// @return length of the full summary, as std::snprintf
+        int format(
+            char *buffer,
+            std::size_t size) const;
+
+        /// @brief Prints a summary over two lines of a screen
+        ///
+        /// @param screen screen to print to, such as Brain.Screen
+        /// @param row first row to print on
+        void print(
+            vex::brain::lcd &screen,
+            int row) const;
+    };
+
+} // namespace neblib
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "neblib/util.hpp"
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief Output stage collecting motor group voltages and sending them once per tick
+    ///
+    /// Drive classes write target voltages with set(). flush() moves each
+    /// group's output toward its target within the group's slew and jerk
+    /// limits, clamps it to the maximum voltage, and only sends a command
+    /// to a group whose output changed. Run flush() as the output job of a
+    /// neblib::Executor, or call it once per loop.
+    ///
+    /// stop() is sent immediately rather than at the next flush, so a group
+    /// always stops when asked to.
+    class MotorOutput
+    {
+    public:
+        /// @brief Maximum number of motor groups an output stage can hold
+        static constexpr std::size_t maxGroups = 8;
+
+        /// @brief Rate limits of a motor group
+        ///
+        /// slew: Largest change in voltage per second (V/s)
+        /// jerk: Largest change in slew per second (V/s^2)
+        struct Limits
+        {
+            double slew;
+            double jerk;
+
+            /// @brief Creates a new Limits object
+            /// @param slew largest change in voltage per second (V/s)
+            /// @param jerk largest change in slew per second (V/s^2)
+            Limits(
+                double slew = infinity(),
+                double jerk = infinity());
+        };
+
+    private:
+        /// @brief State of a registered motor group
+        struct Group
+        {
+            vex::motor_group *motors;
+            Limits limits;
+            double target; //< Voltage requested by set()
+            double output; //< Voltage after rate limiting
+            double rate; //< Change in output per second at the last flush
+            double sent; //< Last voltage sent to the motors
+            bool stopped; //< True after stop() until the next nonzero target
+            vex::brakeType brake; //< Brake type of the last stop
+            bool hasSent; //< True once any command was sent
+
+            Group();
+        };
+
+        // ---------- Configuration ----------
+        double maxVoltage;
+        double changeThreshold;
+
+        // ---------- State ----------
+        Group groups[maxGroups];
+        std::size_t groupCount;
+        std::uint64_t previousFlush; //< System time (us) of the last flush, 0 before the first
+        std::uint32_t commandsSent;
+        std::uint32_t commandsSuppressed;
+
+    public:
+        /// @brief Creates a new MotorOutput
+        ///
+        /// @param maxVoltage largest voltage magnitude sent to a group
+        /// @param changeThreshold smallest change in voltage that is sent to a group
+        MotorOutput(
+            double maxVoltage = 12.0,
+            double changeThreshold = 0.01);
+
+        /// @brief Registers a motor group
+        ///
+        /// @param motors motor group to drive, must outlive the output stage
+        /// @param limits rate limits of the group
+        /// @return index of the group, -1 if the output stage is full
+        int addGroup(
+            vex::motor_group &motors,
+            Limits limits = Limits());
+
+        /// @brief Finds a registered motor group
+        ///
+        /// @param motors the motor group
+        /// @return index of the group, -1 if it is not registered
+        int indexOf(const vex::motor_group &motors) const;
+
+        /// @brief Changes the rate limits of a group
+        ///
+        /// @param group index of the group
+        /// @param limits new rate limits
+        void setLimits(
+            int group,
+            Limits limits);
+
+        /// @brief Sets the voltage a group moves toward at the next flush
+        ///
+        /// @param group index of the group
+        /// @param voltage target voltage
+        void set(
+            int group,
+            double voltage);
+
+        /// @brief Stops a group immediately and resets its rate limiting
+        ///
+        /// Repeating the same stop on a stopped group is suppressed.
+        ///
+        /// @param group index of the group
+        /// @param brakeType how the motors stop
+        void stop(
+            int group,
+            vex::brakeType brakeType);
+
+        /// @brief Applies rate limits and sends every changed output
+        void flush();
+
+        /// @brief Gets the voltage a group was last sent
+        ///
+        /// @param group index of the group
+        /// @return voltage, 0 if the group does not exist
+        double getOutput(int group) const;
+
+        /// @brief Gets the number of commands sent to motor groups
+        std::uint32_t getCommandsSent() const;
+
+        /// @brief Gets the number of commands skipped because the output did not change
+        std::uint32_t getCommandsSuppressed() const;
+    };
+
+} // namespace neblib
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "neblib/position_tracking.hpp"
+
+namespace neblib
+{
+    /// @brief Grid based path planner using A* or any-angle Lazy Theta*
+    ///
+    /// The occupancy grid is inflated by the robot radius once on construction,
+    /// so planning treats the robot as a point. All search storage is
+    /// allocated on construction, planning itself does not allocate.
+    class PathPlanner
+    {
+    private:
+        /// @brief Search state of a single cell
+        struct Node
+        {
+            float g; //< Cost from the start
+            float f; //< Cost from the start plus heuristic
+            std::uint32_t parent; //< Index of the parent cell
+            std::uint32_t search; //< Search the state belongs to, stale when not the current search
+            std::uint32_t heapIndex; //< Position in the open list
+            bool closed; //< True once expanded
+        };
+
+        // ---------- Configuration ----------
+        int width;
+        int height;
+        double cellSize;
+        double originX;
+        double originY;
+
+        // ---------- Storage ----------
+        std::vector<std::uint8_t> blocked; //< Inflated occupancy, nonzero when blocked
+        std::vector<Node> nodes; //< Node pool, one per cell
+        std::vector<std::uint32_t> openList; //< Binary min-heap of cell indices ordered by f
+        std::vector<std::uint32_t> cellPath; //< Scratch space used to reverse a path
+        std::size_t openSize;
+        std::uint32_t search;
+
+        /// @brief Determines if a cell is outside the grid or blocked
+        bool isBlockedCell(
+            int column,
+            int row) const;
+
+        /// @brief Determines if the straight line between two cells only crosses free cells
+        bool lineOfSight(
+            int column0,
+            int row0,
+            int column1,
+            int row1) const;
+
+        /// @brief Starts or refreshes the state of a node for the current search
+        Node &node(std::uint32_t index);
+
+        /// @brief Adds a cell to the open list, or moves it up if it is already there
+        void push(std::uint32_t index);
+
+        /// @brief Removes the cell with the lowest f from the open list
+        std::uint32_t pop();
+
+        /// @brief Determines if a cell comes before another in the open list
+        bool before(
+            std::uint32_t a,
+            std::uint32_t b) const;
+
+        void siftUp(std::size_t position);
+        void siftDown(std::size_t position);
+
+        /// @brief Converts a position to the cell containing it
+        /// @return false if the position is outside the grid
+        bool toCell(
+            double x,
+            double y,
+            int &column,
+            int &row) const;
+
+    public:
+        /// @brief Creates a new PathPlanner, inflating the occupancy grid by the robot radius
+        ///
+        /// @param occupancy row-major grid of width * height cells, nonzero when blocked, row 0 is the lowest 'y'
+        /// @param width number of columns
+        /// @param height number of rows
+        /// @param cellSize length of the side of a cell
+        /// @param robotRadius radius of a circle around the robot's turning center containing the whole robot
+        /// @param originX 'x' position of the outer corner of cell (0, 0)
+        /// @param originY 'y' position of the outer corner of cell (0, 0)
+        PathPlanner(
+            const std::uint8_t *occupancy,
+            int width,
+            int height,
+            double cellSize,
+            double robotRadius,
+            double originX = 0.0,
+            double originY = 0.0);
+
+        /// @brief Determines if the robot's turning center cannot be at a position
+        ///
+        /// @param x 'x' position
+        /// @param y 'y' position
+        /// @return true if the position is outside the grid or too close to an obstacle
+        bool isBlocked(
+            double x,
+            double y) const;
+
+        /// @brief Hashes the grid after inflation, its size, cell size, and origin
+        ///
+        /// Changes whenever the field or the robot radius does, so paths
+        /// saved with one planner are not reused with another.
+        ///
+        /// @return signature of the planner
+        std::uint32_t getSignature() const;
+
+        /// @brief Plans a path between two poses
+        ///
+        /// Waypoints exclude the start. Each waypoint faces along the segment
+        /// leading to it, except the last, which is the goal pose.
+        ///
+        /// @param start start pose
+        /// @param goal goal pose
+        /// @param path array the waypoints are written to
+        /// @param maxWaypoints size of the array
+        /// @param anyAngle true for Lazy Theta*, false for 8-connected A*
+        /// @return number of waypoints, -1 if the start is blocked, -2 if the goal is blocked,
+        ///         -3 if no path exists, -4 if the path does not fit in the array
+        int plan(
+            const neblib::Pose &start,
+            const neblib::Pose &goal,
+            neblib::Pose *path,
+            int maxWaypoints,
+            bool anyAngle = true);
+
+        /// @brief Plans a path between two poses
+        ///
+        /// @param start start pose
+        /// @param goal goal pose
+        /// @param path vector the waypoints are written to, only allocates the first time it is used
+        /// @param anyAngle true for Lazy Theta*, false for 8-connected A*
+        /// @return number of waypoints, or the same error codes as the array overload
+        int plan(
+            const neblib::Pose &start,
+            const neblib::Pose &goal,
+            std::vector<neblib::Pose> &path,
+            bool anyAngle = true);
+    };
+
+} // namespace neblib
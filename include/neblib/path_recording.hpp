@@ -0,0 +1,223 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "neblib/position_tracking.hpp"
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief Path driven by hand, sampled at a fixed rate, for playback in autonomous
+    ///
+    /// Each sample holds the pose and the drive command at that moment in
+    /// fixed point, 12 bytes, so a minute sampled every 10 ms takes 72 KB.
+    /// Sample i was taken i periods after the recording started, so the
+    /// samples need no timestamps. Storage is reserved on construction and
+    /// never grows while recording.
+    ///
+    /// Saved files are a 12 byte header, the magic "NBPR", a uint16
+    /// version, a uint16 period (ms) and a uint32 sample count, followed
+    /// by the samples, all little-endian. Load the file before autonomous
+    /// starts, such as in pre_auton, and playback starts without reading
+    /// the card.
+    class PathRecording
+    {
+    public:
+        /// @brief One sample as stored
+        ///
+        /// x, y: position in hundredths of an inch
+        /// heading: heading in 65536ths of a turn
+        /// drive, strafe, turn: drive command in millivolts
+        struct Sample
+        {
+            std::int16_t x;
+            std::int16_t y;
+            std::uint16_t heading;
+            std::int16_t drive;
+            std::int16_t strafe;
+            std::int16_t turn;
+        };
+
+        /// @brief Pose and drive command at a point of the recording
+        ///
+        /// pose: Pose of the robot
+        /// drive: forward command (V)
+        /// strafe: sideways command (V), right is positive, 0 on a chassis that can't strafe
+        /// turn: turn command (V), clockwise is positive
+        struct State
+        {
+            Pose pose;
+            double drive;
+            double strafe;
+            double turn;
+
+            /// @brief Creates a zeroed State
+            State();
+        };
+
+        /// @brief Size (bytes) of the file header
+        static constexpr std::size_t headerSize = 12;
+
+        /// @brief Size (bytes) of each sample in a file
+        static constexpr std::size_t sampleSize = 12;
+
+    private:
+        std::vector<Sample> samples;
+        std::size_t maxSamples;
+        int periodMS;
+
+        static Sample encode(
+            const Pose &pose,
+            double drive,
+            double strafe,
+            double turn);
+
+        static State decode(const Sample &sample);
+
+    public:
+        /// @brief Creates an empty PathRecording, reserving its storage
+        ///
+        /// @param capacity largest number of samples, 6000 is one minute at 10 ms
+        /// @param periodMS time (ms) between samples
+        PathRecording(
+            std::size_t capacity = 6000,
+            int periodMS = 10);
+
+        /// @brief Removes every sample, keeping the storage
+        void clear();
+
+        /// @brief Adds a sample at the end, never allocates
+        ///
+        /// Positions must be within 327 inches of the origin.
+        ///
+        /// @param pose pose of the robot
+        /// @param drive forward command (V)
+        /// @param strafe sideways command (V), right is positive
+        /// @param turn turn command (V), clockwise is positive
+        /// @return false if the recording is full and the sample was dropped
+        bool add(
+            const Pose &pose,
+            double drive,
+            double strafe,
+            double turn);
+
+        /// @brief Gets the number of samples
+        std::size_t size() const;
+
+        /// @brief Gets the largest number of samples
+        std::size_t capacity() const;
+
+        /// @brief Gets the time (ms) between samples
+        int getPeriod() const;
+
+        /// @brief Gets the time (ms) from the first sample to the last
+        int getDuration() const;
+
+        /// @brief Gets a sample
+        ///
+        /// @param index index of the sample, clamped to the last sample
+        /// @return pose and command of the sample, zeroed if the recording is empty
+        State get(std::size_t index) const;
+
+        /// @brief Gets the recording at a time, interpolating between samples
+        ///
+        /// @param time time (ms) since the first sample, clamped to the recording
+        /// @return pose and command at that time, zeroed if the recording is empty
+        State at(double time) const;
+
+        /// @brief Writes the recording to a file, replacing it
+        ///
+        /// Writes the whole file at once, so call it after recording stops.
+        ///
+        /// @param sdCard SD card of the brain, usually Brain.SDcard
+        /// @param fileName name of the file
+        /// @return 0 on success, -1 if no SD card is inserted, -2 if the file could not be written
+        int save(
+            vex::brain::sdcard &sdCard,
+            const char *fileName) const;
+
+        /// @brief Replaces the recording with one read from a file
+        ///
+        /// @param sdCard SD card of the brain, usually Brain.SDcard
+        /// @param fileName name of the file
+        /// @return 0 on success, -1 if no SD card is inserted, -2 if the file could not be read,
+        ///         -3 if it is not a recording or holds more samples than the capacity
+        int load(
+            vex::brain::sdcard &sdCard,
+            const char *fileName);
+    };
+
+    /// @brief Samples the pose and the driver's commands into a neblib::PathRecording at a fixed rate
+    ///
+    /// The driver loop only stores its command with setCommand(), which
+    /// never blocks. Sampling runs in the recorder's own task or executor
+    /// job, and nothing touches the SD card until the recording is saved.
+    class PathRecorder
+    {
+    private:
+        // ---------- Sources ----------
+        neblib::PositionTracking &positionTracking;
+        neblib::PathRecording &recording;
+
+        // ---------- Command ----------
+        // Written by the driver loop, read when sampling
+        std::atomic<float> drive;
+        std::atomic<float> strafe;
+        std::atomic<float> turn;
+
+        // ---------- State ----------
+        bool running;
+        std::uint32_t dropped; //< Samples that did not fit in the recording
+
+    public:
+        /// @brief Creates a new PathRecorder
+        ///
+        /// @param positionTracking pose source, usually the neblib::Odometry the drivetrain uses
+        /// @param recording recording samples are added to
+        PathRecorder(
+            neblib::PositionTracking &positionTracking,
+            neblib::PathRecording &recording);
+
+        /// @brief Stores the command the driver loop sent to the drive, never blocks
+        ///
+        /// @param drive forward command (V)
+        /// @param strafe sideways command (V), right is positive
+        /// @param turn turn command (V), clockwise is positive
+        void setCommand(
+            double drive,
+            double strafe,
+            double turn);
+
+        /// @brief Stores a tank drive command as its forward and turn parts, never blocks
+        ///
+        /// @param left left side command (V)
+        /// @param right right side command (V)
+        void setTankCommand(
+            double left,
+            double right);
+
+        /// @brief Adds one sample of the current pose and command
+        ///
+        /// For an executor job; the executor's tick must match the recording's period.
+        void update();
+
+        /// @brief Clears the recording and samples at its period until stopped
+        ///
+        /// Sleeps until each sample is due rather than a fixed time after the
+        /// last, and catches up after a late wake, so sample i is always i
+        /// periods after the start. Designed to work best with
+        /// neblib::spawnTask() at a high priority.
+        ///
+        /// @return returns 0 when the loop ends
+        int begin();
+
+        /// @brief Stops the sampling loop
+        void stop();
+
+        /// @brief Gets the number of samples dropped because the recording was full
+        std::uint32_t getDropped();
+    };
+
+} // namespace neblib
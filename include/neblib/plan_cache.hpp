@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "neblib/path_planner.hpp"
+#include "neblib/position_tracking.hpp"
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief Paths of every selectable autonomous routine, built before the match
+    ///
+    /// Each routine registers a build function that computes its paths,
+    /// such as with neblib::PathPlanner, and adds them in the order the
+    /// routine drives them. build() runs every build function during
+    /// pre_auton, so autonomous only looks paths up by routine name and
+    /// index and starts moving on its first tick.
+    ///
+    /// Every path lives in one pose array allocated on construction;
+    /// building never allocates. The cache can be saved to the SD card and
+    /// loaded on the next boot instead of building, see prepare(). A saved
+    /// file is only loaded while its signature matches getSignature(),
+    /// which changes with the registered routine names, the grid of every
+    /// registered planner, the start, goal and search of every addPlan(),
+    /// the poses of every addPath(), and a version to bump when anything
+    /// else a build function depends on changes. Saved files are a 20 byte header, the magic
+    /// "NBPC" and uint32 version, signature, path count and pose count,
+    /// then 16 bytes per path and each pose as three doubles stored bit
+    /// for bit, all little-endian.
+    ///
+    /// void buildSkills(neblib::PlanCache &cache, const char *routine, void *)
+    /// {
+    ///     cache.addPlan(routine, planner, neblib::Pose(12.0, 12.0, 0.0), neblib::Pose(72.0, 130.0, 0.0));
+    ///     cache.addPlan(routine, planner, neblib::Pose(72.0, 130.0, 0.0), neblib::Pose(130.0, 72.0, 90.0));
+    /// }
+    ///
+    /// cache.addPlanner(planner);
+    /// cache.addRoutine("skills", buildSkills);
+    /// cache.prepare(Brain.SDcard, "plans.nbpc"); // in pre_auton
+    /// const neblib::PlanCache::Plan plan = cache.get("skills", 0); // in autonomous
+    /// drive.followPath(plan.poses, plan.count, chain);
+    class PlanCache
+    {
+    public:
+        /// @brief Path stored in the cache
+        ///
+        /// poses: first pose of the path, nullptr if there is no such path
+        /// count: number of poses, 0 if there is no such path
+        struct Plan
+        {
+            const neblib::Pose *poses;
+            std::size_t count;
+
+            /// @brief Creates an empty Plan
+            Plan();
+        };
+
+        /// @brief Adds the paths of one routine to the cache
+        ///
+        /// @param cache cache to add the paths to
+        /// @param routine name of the routine being built, pass it to addPath() and addPlan()
+        /// @param context pointer given to addRoutine()
+        typedef void (*BuildFunction)(
+            neblib::PlanCache &cache,
+            const char *routine,
+            void *context);
+
+    private:
+        /// @brief Location of one path in the pose array
+        struct Entry
+        {
+            std::uint32_t routine; //< Key of the routine's name
+            std::uint32_t index; //< Order of the path within its routine
+            std::uint32_t offset; //< First pose in the pose array
+            std::uint32_t count;
+        };
+
+        struct Routine
+        {
+            const char *name;
+            BuildFunction build;
+            void *context;
+        };
+
+        // ---------- Storage ----------
+        std::vector<neblib::Pose> poses;
+        std::size_t usedPoses;
+        std::vector<Entry> entries;
+        std::size_t maxEntries;
+
+        // ---------- Routines ----------
+        std::vector<Routine> routines;
+        std::vector<const neblib::PathPlanner *> planners; //< Planners folded into the signature
+
+        // ---------- State ----------
+        bool built;
+        bool failed; //< True if a path failed or did not fit since the last clear
+        bool hashing; //< True while getSignature() runs the build functions, which then only hash what they add
+        std::uint32_t inputs; //< Hash of what the build functions added while hashing
+
+        /// @brief Hashes a routine name, FNV-1a
+        static std::uint32_t key(const char *routine);
+
+        /// @brief Counts the paths of a routine
+        std::uint32_t countPlans(std::uint32_t routine) const;
+
+        /// @brief Records a path already written after the used poses
+        int commit(
+            const char *routine,
+            std::size_t count);
+
+    public:
+        /// @brief Creates an empty PlanCache, allocating all of its storage
+        ///
+        /// @param poseCapacity number of poses every path together can hold
+        /// @param planCapacity number of paths every routine together can hold
+        PlanCache(
+            std::size_t poseCapacity = 2048,
+            std::size_t planCapacity = 128);
+
+        /// @brief Registers a routine, call before build() or prepare()
+        ///
+        /// @param name name of the routine, such as the text AutonSelector::getAuton() returns
+        /// @param build function adding the routine's paths
+        /// @param context pointer passed to the build function
+        void addRoutine(
+            const char *name,
+            BuildFunction build,
+            void *context = nullptr);
+
+        /// @brief Registers a planner the build functions use, call before prepare()
+        ///
+        /// @param planner planner of the field, must outlive the cache
+        void addPlanner(const neblib::PathPlanner &planner);
+
+        /// @brief Hashes the registered routine names and planners, the paths the build functions add, and a version
+        ///
+        /// Runs every build function without planning, addPath() and addPlan()
+        /// only hash their arguments and return 0, so the cache is left as it was.
+        ///
+        /// @param version number to change whenever a build function changes its paths in a way not passed to addPath() or addPlan()
+        /// @return signature prepare() saves and loads the cache with
+        std::uint32_t getSignature(std::uint32_t version = 0);
+
+        /// @brief Removes every path, keeping the registered routines
+        void clear();
+
+        /// @brief Clears the cache and runs the build function of every routine
+        ///
+        /// @return number of paths stored, -1 if a path failed or did not fit
+        int build();
+
+        /// @brief Loads the cache from the SD card, building and saving it instead if that fails
+        ///
+        /// A file saved with another set of routines, planners, starts, goals
+        /// or paths, or another version, is rebuilt and replaced.
+        ///
+        /// @param sdCard SD card of the brain, usually Brain.SDcard
+        /// @param fileName name of the cache file
+        /// @param version number to change whenever a build function changes its paths in a way not passed to addPath() or addPlan()
+        /// @return 1 if loaded, 0 if built, -1 if building failed
+        int prepare(
+            vex::brain::sdcard &sdCard,
+            const char *fileName,
+            std::uint32_t version = 0);
+
+        /// @brief Adds a path to a routine
+        ///
+        /// @param routine name of the routine
+        /// @param path poses of the path, copied into the cache
+        /// @param count number of poses
+        /// @return index of the path within the routine, -1 if it does not fit
+        int addPath(
+            const char *routine,
+            const neblib::Pose *path,
+            std::size_t count);
+
+        /// @brief Plans a path straight into the cache and adds it to a routine
+        ///
+        /// @param routine name of the routine
+        /// @param planner planner of the field
+        /// @param start start pose
+        /// @param goal goal pose
+        /// @param anyAngle true for Lazy Theta*, false for 8-connected A*
+        /// @return index of the path within the routine, -1 if the start is blocked, -2 if the goal is blocked,
+        ///         -3 if no path exists, -4 if the path does not fit
+        int addPlan(
+            const char *routine,
+            neblib::PathPlanner &planner,
+            const neblib::Pose &start,
+            const neblib::Pose &goal,
+            bool anyAngle = true);
+
+        /// @brief Looks up a path, never allocates
+        ///
+        /// @param routine name of the routine
+        /// @param index index of the path within the routine
+        /// @return the path, empty if the routine has no such path
+        Plan get(
+            const char *routine,
+            std::size_t index) const;
+
+        /// @brief Gets the number of paths of a routine
+        std::size_t getPlanCount(const char *routine) const;
+
+        /// @brief Gets the number of poses stored
+        std::size_t getPoseCount() const;
+
+        /// @brief Determines if the cache was built or loaded since it was last cleared
+        bool isBuilt() const;
+
+        /// @brief Writes the cache to a file, replacing it
+        ///
+        /// @param sdCard SD card of the brain, usually Brain.SDcard
+        /// @param fileName name of the file
+        /// @param signature number identifying the routines, checked by load(), usually getSignature()
+        /// @return 0 on success, -1 if no SD card is inserted, -2 if the file could not be written, -3 if the cache is not built
+        int save(
+            vex::brain::sdcard &sdCard,
+            const char *fileName,
+            std::uint32_t signature) const;
+
+        /// @brief Replaces the cache with one read from a file
+        ///
+        /// @param sdCard SD card of the brain, usually Brain.SDcard
+        /// @param fileName name of the file
+        /// @param signature number the file must have been saved with
+        /// @return 0 on success, -1 if no SD card is inserted, -2 if the file could not be read,
+        ///         -3 if it is not a cache, has another signature or does not fit
+        int load(
+            vex::brain::sdcard &sdCard,
+            const char *fileName,
+            std::uint32_t signature);
+    };
+
+} // namespace neblib
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "neblib/devices/tracker_wheel.hpp"
+#include "neblib/loop_stats.hpp"
+#include "neblib/sensor_snapshot.hpp"
 #include "neblib/util.hpp"
 #include "vex.h"
 
@@ -26,6 +28,15 @@ namespace neblib
             double y,
             double heading);
 
+        /// @brief Creates a new Pose object from typed quantities
+        /// @param x x position
+        /// @param y y position
+        /// @param heading orientation
+        Pose(
+            Length x,
+            Length y,
+            Angle heading);
+
         /// @brief Creates a new Pose object
         ///
         /// Sets 'x', 'y', and 'heading' to 0.0
@@ -45,6 +56,11 @@ namespace neblib
         /// @return returns 0 when the loop ends
         virtual int begin() = 0;
 
+        /// @brief Runs a single update of the Pose
+        ///
+        /// Used by neblib::Executor to run position tracking as a job instead of its own loop
+        virtual void update() = 0;
+
         /// @brief Stops the self-contained update loop
         virtual void stop() = 0;
 
@@ -78,6 +94,7 @@ namespace neblib
         neblib::TrackerWheel &parallelTrackerWheel;
         neblib::TrackerWheel &perpendicularTrackerWheel;
         vex::inertial &imu;
+        neblib::SensorSnapshot *sensorSnapshot;
 
         // ---------- Configuration ----------
         double parallelDistance;
@@ -90,6 +107,8 @@ namespace neblib
         double previousParallel;
         double previousPerpendicular;
         double previousRotation;
+        neblib::LoopStats loopStats;
+        std::uint32_t resetSequence; //< Snapshot sequence when the pose was last set, older data is skipped
 
     public:
         /// @brief Constructs an Odometry object
@@ -112,6 +131,9 @@ namespace neblib
         /// @return returns 0 when the loop ends
         int begin() override;
 
+        /// @brief Runs a single update of the Pose from the change in sensor data since the last update
+        void update() override;
+
         /// @brief Stops the self-contained update loop
         void stop() override;
 
@@ -135,6 +157,18 @@ namespace neblib
         /// @brief Gets the current pose of the robot
         /// @return neblib::Pose containing 'x', 'y', and orientation values
         Pose getPose() override;
+
+        /// @brief Reads sensors from a shared snapshot instead of the devices
+        ///
+        /// Register the IMU and both tracker wheels with the snapshot, and
+        /// run the snapshot's update before this odometry's update each tick.
+        ///
+        /// @param sensorSnapshot pointer to a neblib::SensorSnapshot or nullptr
+        void setSensorSnapshot(neblib::SensorSnapshot *sensorSnapshot);
+
+        /// @brief Gets the timing statistics of the update loop
+        /// @return period and execution time of every update so far
+        neblib::LoopStats &getLoopStats();
     };
 
 } // namespace neblib
\ No newline at end of file
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "neblib/executor.hpp"
+#include "neblib/position_tracking.hpp"
+#include "neblib/util.hpp"
+#include "vex.h"
+
+/// Cooperative routines
+///
+/// A routine is a resumable function written between NEBLIB_ROUTINE_BEGIN()
+/// and NEBLIB_ROUTINE_END(). NEBLIB_AWAIT(condition) returns to the
+/// scheduler until the condition is true, and the routine continues from
+/// that point the next time it is resumed, so many routines share one task
+/// without a stack each. Local variables do not survive an await; keep
+/// state that must last across awaits in members of the routine. Only one
+/// await may appear per source line.
+///
+/// Motions are started with the stepped functions of neblib::Drivetrain
+/// and advanced by the scheduler every tick once the drivetrain is added
+/// with addDrivetrain(), so the routine can react to conditions while the
+/// robot moves without a task of its own:
+///
+/// struct Score : public neblib::Routine
+/// {
+///     bool resume() override
+///     {
+///         NEBLIB_ROUTINE_BEGIN();
+///         drive.startDriveToPose(24.0, 24.0, 90.0);
+///         NEBLIB_AWAIT(neblib::withinDistance(odom, 24.0, 24.0, 6.0));
+///         intake.spin(vex::directionType::fwd);
+///         NEBLIB_AWAIT(!drive.isMoving());
+///         NEBLIB_AWAIT_FOR(250);
+///         NEBLIB_ROUTINE_END();
+///     }
+/// };
+///
+/// scheduler.addDrivetrain(&drive);
+/// scheduler.spawn<Score>();
+/// scheduler.run(15000);
+
+#define NEBLIB_ROUTINE_BEGIN() \
+    switch (this->resumePoint) \
+    {                          \
+    case 0:
+
+#define NEBLIB_AWAIT(condition)          \
+    do                                   \
+    {                                    \
+        this->resumePoint = __LINE__;    \
+    case __LINE__:                       \
+        if (!(condition))                \
+            return false;                \
+    } while (0)
+
+#define NEBLIB_AWAIT_FOR(ms)                                                    \
+    do                                                                          \
+    {                                                                           \
+        this->wakeTime = vex::timer::system() + static_cast<std::uint32_t>(ms); \
+        NEBLIB_AWAIT(vex::timer::system() >= this->wakeTime);                   \
+    } while (0)
+
+#define NEBLIB_ROUTINE_END()  \
+    }                         \
+    this->resumePoint = -1;   \
+    return true
+
+namespace neblib
+{
+    /// @brief Base class of routines run by a neblib::RoutineScheduler
+    class Routine
+    {
+    protected:
+        int resumePoint; //< Line to continue from, 0 before starting, -1 once finished
+        std::uint32_t wakeTime; //< System time (ms) NEBLIB_AWAIT_FOR waits until
+
+    public:
+        /// @brief Creates a routine that starts from the beginning
+        Routine();
+
+        virtual ~Routine() = default;
+
+        /// @brief Runs the routine until its next await or its end
+        ///
+        /// Implement with NEBLIB_ROUTINE_BEGIN(), NEBLIB_AWAIT(), and NEBLIB_ROUTINE_END().
+        ///
+        /// @return true once the routine has finished
+        virtual bool resume() = 0;
+
+        /// @brief Determines if the routine has finished
+        /// @return true once the routine has reached its end
+        bool isFinished() const;
+    };
+
+    /// @brief Runs routines cooperatively from the task that calls it
+    ///
+    /// Each tick resumes every routine once, in the order they were added,
+    /// then steps the motion of every added drivetrain. Routines created
+    /// with spawn() are placed in a fixed arena owned by the scheduler
+    /// instead of the heap; the arena is reused once every spawned routine
+    /// has finished.
+    class RoutineScheduler
+    {
+    public:
+        /// @brief Maximum number of routines a scheduler can run at once
+        static constexpr std::size_t maxRoutines = 16;
+
+        /// @brief Bytes of arena for routines created with spawn()
+        static constexpr std::size_t arenaSize = 4096;
+
+        /// @brief Maximum number of drivetrains a scheduler can step
+        static constexpr std::size_t maxDrivetrains = 4;
+
+    private:
+        // ---------- Configuration ----------
+        int periodMS;
+        neblib::Executor *executor;
+
+        // ---------- Routines ----------
+        neblib::Routine *routines[maxRoutines];
+        bool owned[maxRoutines]; //< True if the routine lives in the arena
+        std::size_t routineCount;
+
+        // ---------- Arena ----------
+        alignas(8) unsigned char arena[arenaSize];
+        std::size_t arenaUsed;
+        std::size_t ownedCount; //< Routines alive in the arena
+
+        // ---------- Drivetrains ----------
+        struct Mover
+        {
+            void *drivetrain;
+            bool (*step)(void *, int);
+            void (*cancel)(void *);
+        };
+
+        Mover movers[maxDrivetrains];
+        std::size_t moverCount;
+
+        template <class D>
+        static bool stepDrivetrain(
+            void *drivetrain,
+            int elapsed)
+        {
+            return static_cast<D *>(drivetrain)->stepMotion(elapsed);
+        }
+
+        template <class D>
+        static void cancelDrivetrain(void *drivetrain)
+        {
+            // Stops a motion in another task at its next iteration, and a stepped one now
+            static_cast<D *>(drivetrain)->cancelMotion();
+            static_cast<D *>(drivetrain)->stepMotion(0);
+        }
+
+        /// @brief Takes memory from the arena
+        /// @return pointer to the memory, nullptr if the arena is full
+        void *allocate(
+            std::size_t size,
+            std::size_t alignment);
+
+        /// @brief Adds a routine to the run list
+        /// @return index of the routine, -1 if the scheduler is full
+        int insert(
+            neblib::Routine *routine,
+            bool isOwned);
+
+        /// @brief Removes the routine at an index, destroying it if it lives in the arena
+        void remove(std::size_t index);
+
+    public:
+        /// @brief Creates a new RoutineScheduler
+        ///
+        /// @param periodMS time (ms) between ticks when no executor is set
+        RoutineScheduler(int periodMS = 10);
+
+        ~RoutineScheduler();
+
+        RoutineScheduler(const RoutineScheduler &) = delete;
+        RoutineScheduler &operator=(const RoutineScheduler &) = delete;
+
+        /// @brief Adds a routine owned by the caller
+        ///
+        /// @param routine routine to run, must outlive its run
+        /// @return 0 on success, -1 if the scheduler is full
+        int add(neblib::Routine *routine);
+
+        /// @brief Creates a routine in the scheduler's arena and adds it
+        ///
+        /// @tparam R class of the routine, derived from neblib::Routine
+        /// @param args arguments passed to the routine's constructor
+        /// @return pointer to the routine, nullptr if the arena or scheduler is full
+        template <class R, class... Args>
+        R *spawn(Args &&...args)
+        {
+            static_assert(std::is_base_of<neblib::Routine, R>::value, "spawned routines must derive from neblib::Routine");
+            static_assert(alignof(R) <= 8, "routine needs more alignment than the arena provides");
+
+            void *memory = allocate(sizeof(R), alignof(R));
+            if (!memory)
+                return nullptr;
+
+            R *routine = new (memory) R(std::forward<Args>(args)...);
+            if (insert(routine, true) < 0)
+            {
+                routine->~R();
+                return nullptr;
+            }
+            return routine;
+        }
+
+        /// @brief Steps the motions of a drivetrain every tick and cancels them with the routines
+        ///
+        /// @tparam D class of the drivetrain, such as neblib::StandardDrive
+        /// @param drivetrain drivetrain whose stepped motions the routines start, must outlive the scheduler
+        /// @return 0 on success, -1 if the scheduler is full
+        template <class D>
+        int addDrivetrain(D *drivetrain)
+        {
+            if (!drivetrain || moverCount >= maxDrivetrains)
+                return -1;
+
+            movers[moverCount].drivetrain = drivetrain;
+            movers[moverCount].step = &stepDrivetrain<D>;
+            movers[moverCount].cancel = &cancelDrivetrain<D>;
+            moverCount++;
+            return 0;
+        }
+
+        /// @brief Resumes every routine once, steps every drivetrain, and removes the finished routines
+        ///
+        /// @return true while any routine or stepped motion is still running
+        bool step();
+
+        /// @brief Runs ticks until every routine and stepped motion has finished
+        ///
+        /// @param timeout time (ms) before the remaining routines and motions are cancelled
+        /// @return time (ms) spent running
+        int run(int timeout = noTimeout());
+
+        /// @brief Removes every routine without finishing it and cancels the motions of every drivetrain
+        ///
+        /// Stepped motions stop the drivetrain at once; blocking motions
+        /// running in another task stop at their next iteration.
+        void cancelAll();
+
+        /// @brief Ticks with an executor instead of sleeping for the period
+        ///
+        /// @param executor pointer to a running neblib::Executor or nullptr
+        void setExecutor(neblib::Executor *executor);
+
+        /// @brief Gets the number of routines still running
+        /// @return number of routines
+        std::size_t getCount();
+    };
+
+    /// @brief Determines if the robot is inside a rectangle, for use in NEBLIB_AWAIT
+    ///
+    /// @param positionTracking position tracking of the robot
+    /// @param minX lowest 'x' of the region
+    /// @param minY lowest 'y' of the region
+    /// @param maxX highest 'x' of the region
+    /// @param maxY highest 'y' of the region
+    /// @return true if the robot's position is in the region
+    bool inRegion(
+        neblib::PositionTracking &positionTracking,
+        double minX,
+        double minY,
+        double maxX,
+        double maxY);
+
+    /// @brief Determines if the robot is within a distance of a point, for use in NEBLIB_AWAIT
+    ///
+    /// @param positionTracking position tracking of the robot
+    /// @param x 'x' position of the point
+    /// @param y 'y' position of the point
+    /// @param distance distance from the point
+    /// @return true if the robot's position is within the distance
+    bool withinDistance(
+        neblib::PositionTracking &positionTracking,
+        double x,
+        double y,
+        double distance);
+
+} // namespace neblib
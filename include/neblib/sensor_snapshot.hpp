@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "neblib/devices/tracker_wheel.hpp"
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief Reads every registered sensor once per tick and shares the values
+    ///
+    /// update() reads the devices and publishes the values as one
+    /// timestamped snapshot, so odometry and every controller in a tick see
+    /// the same data and each device is only read once. Run update() as the
+    /// first job of a neblib::Executor.
+    ///
+    /// Reads of a device that is not registered fall through to the device.
+    class SensorSnapshot
+    {
+    public:
+        /// @brief Maximum number of tracker wheels a snapshot can hold
+        static constexpr std::size_t maxTrackerWheels = 8;
+
+        /// @brief Values of every registered sensor at one moment
+        ///
+        /// timestamp: System time (us) the sensors were read
+        /// sequence: Number of snapshots published before this one
+        /// heading: Heading of the IMU in degrees
+        /// rotation: Rotation of the IMU in degrees
+        /// trackerPositions: Position of each tracker wheel, in registration order
+        struct Data
+        {
+            std::uint64_t timestamp;
+            std::uint32_t sequence;
+            double heading;
+            double rotation;
+            double trackerPositions[maxTrackerWheels];
+
+            /// @brief Creates an empty snapshot
+            Data();
+        };
+
+    private:
+        // ---------- Devices ----------
+        vex::inertial *imu;
+        neblib::TrackerWheel *trackerWheels[maxTrackerWheels];
+        std::size_t trackerWheelCount;
+
+        // ---------- State ----------
+        Data buffers[2];
+        std::atomic<int> published; //< Buffer holding the latest snapshot
+        std::uint32_t sequence;
+
+        /// @brief Finds the index of a registered tracker wheel
+        /// @return index, -1 if the wheel is not registered
+        int indexOf(const neblib::TrackerWheel &trackerWheel) const;
+
+    public:
+        /// @brief Creates a SensorSnapshot without any devices
+        SensorSnapshot();
+
+        /// @brief Registers the IMU read every tick
+        ///
+        /// @param imu VEX V5 Inertial sensor
+        void setImu(vex::inertial &imu);
+
+        /// @brief Registers a tracker wheel read every tick
+        ///
+        /// @param trackerWheel tracker wheel to read
+        /// @return index of the wheel in the snapshot, -1 if the snapshot is full
+        int addTrackerWheel(neblib::TrackerWheel &trackerWheel);
+
+        /// @brief Reads every registered device and publishes a new snapshot
+        void update();
+
+        /// @brief Gets a copy of the latest snapshot
+        /// @return the latest snapshot
+        Data get() const;
+
+        /// @brief Gets the heading of the IMU from the latest snapshot
+        ///
+        /// @param imu IMU to read, read directly if it is not the registered IMU
+        /// @return heading in degrees
+        double heading(vex::inertial &imu) const;
+
+        /// @brief Gets the rotation of the IMU from the latest snapshot
+        ///
+        /// @param imu IMU to read, read directly if it is not the registered IMU
+        /// @return rotation in degrees
+        double rotation(vex::inertial &imu) const;
+
+        /// @brief Gets the position of a tracker wheel from the latest snapshot
+        ///
+        /// @param trackerWheel tracker wheel to read, read directly if it is not registered
+        /// @return position of the tracker wheel
+        double position(neblib::TrackerWheel &trackerWheel) const;
+
+        /// @brief Determines if the IMU's values come from the snapshot
+        bool hasImu(const vex::inertial &imu) const;
+
+        /// @brief Determines if a tracker wheel's position comes from the snapshot
+        bool hasTrackerWheel(const neblib::TrackerWheel &trackerWheel) const;
+
+        /// @brief Gets the number of snapshots published
+        /// @return sequence number of the next snapshot
+        std::uint32_t getSequence() const;
+    };
+
+} // namespace neblib
@@ -1,35 +1,94 @@
 #pragma once
 
 #include "vex.h"
+#include "neblib/drivetrain.hpp"
 #include "neblib/position_tracking.hpp"
-#include "neblib/pid.hpp"
+#include "neblib/control_algorithms.hpp"
 
-namespace neblib 
+namespace neblib
 {
-    class StandardDrive
+    /// @brief Chassis policy for differential (tank) drivetrains
+    ///
+    /// Used through neblib::StandardDrive, which adds the shared motion algorithms.
+    class DifferentialChassis : public Chassis
     {
     private:
         vex::motor_group leftMotors;
         vex::motor_group rightMotors;
 
-        PositionTracking* positionTracking;
-
         TrackerWheel &parallelTrackerWheel;
-        vex::inertial &imu;
 
-        PID* turnPID;
-        PID* linearPID;
-        PID* angularPID;
-        PID* swingPID;
+        double lead;
+        double settleRadius;
+
+        double trackWidth;
+        double arcLookahead;
+
+        int followArc(double centerX, double centerY, double radius, bool clockwise, bool reverse, double angle, ChainConditions chain, int timeout, double minOutput, double maxOutput);
+
+    protected:
+        void rotate(double output);
+        double pointHeading(const Pose &current, double x, double y);
+        double angularError(const Pose &current, const Pose &target, double distance);
+        bool atPose(const Pose &current, const Pose &target, double distance);
+        void driveToward(const Pose &current, const Pose &target, double drive, double turn);
+        void driveCommand(double drive, double strafe, double turn);
+        void swing(vex::turnType side, double output);
 
     public:
-        StandardDrive(vex::motor_group&& leftMotors, vex::motor_group&& rightMotors, PositionTracking* positionTracking, TrackerWheel &parallelTrackerWheel, vex::inertial &imu);
+        /// @brief Type motion timeouts are given in, such as 1500_ms or neblib::Time::fromSeconds(1.5)
+        ///
+        /// StandardDrive motions used to take a timeout in seconds after the
+        /// output limits. A distinct type makes those calls fail to compile
+        /// instead of running with the limits read as a timeout.
+        typedef neblib::Time Timeout;
+
+        /// @brief Type motions return their time in, seconds as StandardDrive motions always have
+        ///
+        /// Negative values are the error codes of each motion.
+        typedef double Elapsed;
+
+        /// @brief Converts the time (ms) a motion took to seconds, passing negative error codes through
+        static double toElapsed(int milliseconds);
+
+        /// @brief Differential drivetrains can hold one side still, see Drivetrain::swingTo()
+        static constexpr bool canSwing = true;
+
+        DifferentialChassis(vex::motor_group&& leftMotors, vex::motor_group&& rightMotors, PositionTracking* positionTracking, TrackerWheel &parallelTrackerWheel, vex::inertial &imu);
 
         void setTurnPID(PID* turnPID);
         void setLinearPID(PID* linearPID);
         void setAngularPID(PID* angularPID);
         void setSwingPID(PID* swingPID);
 
+        /// @brief Sets how driveToPose approaches the target heading
+        ///
+        /// The robot steers at a point behind the target, lead * distance away along the target heading.
+        /// Within settleRadius of the target it only holds the target heading, and the motion ends
+        /// once it faces the target heading with the rest of the error to the side, where driving cannot reach.
+        ///
+        /// @param lead 0.0 drives straight at the target, larger values swing wider into the target heading
+        /// @param settleRadius distance from the target where steering stops
+        void setBoomerang(double lead, double settleRadius);
+
+        /// @brief Sets the distance between the left and right wheels, used to drive arcs at the right wheel speed ratio
+        ///
+        /// Without a track width arcs rely on heading and cross-track feedback alone.
+        ///
+        /// @param trackWidth distance between the left and right wheels
+        void setTrackWidth(double trackWidth);
+
+        /// @brief Sets how sharply arcs steer back onto the arc
+        ///
+        /// @param arcLookahead distance along the arc used to correct cross-track error, smaller is sharper
+        void setArcLookahead(double arcLookahead);
+
+        /// @brief Sends every motor command through an output stage, registering both sides with it
+        ///
+        /// @param motorOutput pointer to a neblib::MotorOutput flushed every tick, or nullptr
+        /// @param limits rate limits of each side
+        void setMotorOutput(neblib::MotorOutput *motorOutput, neblib::MotorOutput::Limits limits = neblib::MotorOutput::Limits());
+
         void tankDrive(double leftInput, double rightInput, vex::velocityUnits unit = vex::velocityUnits::pct);
         void tankDrive(double leftInput, double rightInput, vex::voltageUnits unit = vex::voltageUnits::volt);
         void arcadeDrive(double linearInput, double angularInput, vex::velocityUnits unit = vex::velocityUnits::pct);
@@ -37,21 +96,34 @@ namespace neblib
 
         void stop(vex::brakeType stopType = vex::brakeType::hold);
 
-        double turnFor(double degrees, double minOutput, double maxOutput, double timeout = infinity());
-        double turnFor(double degrees, double timeout = infinity());
-        double turnTo(double heading, double minOutput, double maxOutput, double timeout = infinity());
-        double turnTo(double heading, double timeout = infinity());
-
-        double driveFor(double distance, double heading, double minOutput, double maxOutput, double timeout = infinity());
-        double driveFor(double distance, double minOutput, double maxOutput, double timeout = infinity());
-        double driveFor(double distance, double heading, double timeout = infinity());
-        double driveFor(double distance, double timeout = infinity());
-
-        double swingFor(vex::turnType direction, double degrees, double minOutput, double maxOutput, double timeout = infinity());
-        double swingFor(vex::turnType direction, double degrees, double timeout = infinity());
-        double swingTo(vex::turnType turnDirection, vex::directionType direction, double heading, double minOutput, double maxOutput, double timeout = infinity());
-        double swingTo(vex::turnType turnDirection, vex::directionType direction, double heading, double timeout = infinity());
-        double swingTo(vex::turnType turnDirection, double heading, double minOutput, double maxOutput, double timeout = infinity());
-        double swingTo(vex::turnType turnDirection, double heading, double timeout = infinity());
+        double driveFor(double distance, double heading, Time timeout = Time(noTimeout()), double minOutput = -infinity(), double maxOutput = infinity());
+        double driveFor(double distance, Time timeout = Time(noTimeout()), double minOutput = -infinity(), double maxOutput = infinity());
+        double driveFor(double distance, double heading, ChainConditions chain, Time timeout = Time(noTimeout()), double minOutput = -infinity(), double maxOutput = infinity());
+        double driveFor(double distance, ChainConditions chain, Time timeout = Time(noTimeout()), double minOutput = -infinity(), double maxOutput = infinity());
+        double driveFor(Length distance, Angle heading, Time timeout = Time(noTimeout()), Voltage minOutput = Voltage(-infinity()), Voltage maxOutput = Voltage(infinity()));
+        double driveFor(Length distance, Time timeout = Time(noTimeout()), Voltage minOutput = Voltage(-infinity()), Voltage maxOutput = Voltage(infinity()));
+
+        /// @brief Drives the circular arc that ends at a pose, using position tracking
+        ///
+        /// The arc passes through the current position and is tangent to the target heading at the target.
+        /// Drives the arc in reverse if the robot faces away from it, ending opposite the target heading.
+        /// Drives straight if the robot is on the line of the target heading.
+        ///
+        /// @return time (s) the motion took, -1 without position tracking, -2 without a linear controller,
+        /// -3 if the target heading points back at the robot along its line, which no arc can end at
+        double arcTo(double x, double y, double heading, Time timeout = Time(noTimeout()), double minOutput = -infinity(), double maxOutput = infinity());
+        double arcTo(double x, double y, double heading, ChainConditions chain, Time timeout = Time(noTimeout()), double minOutput = -infinity(), double maxOutput = infinity());
+
+        /// @brief Drives forward along a circular arc of a set radius, using position tracking
+        ///
+        /// @param radius radius of the arc, measured to the turning center of the robot
+        /// @param degrees degrees to turn along the arc, clockwise is positive
+        /// @return time (s) the motion took, -1 without position tracking, -2 without a linear controller
+        double arcFor(double radius, double degrees, Time timeout = Time(noTimeout()), double minOutput = -infinity(), double maxOutput = infinity());
+        double arcFor(double radius, double degrees, ChainConditions chain, Time timeout = Time(noTimeout()), double minOutput = -infinity(), double maxOutput = infinity());
+
     };
+
+    /// @brief Differential drive with the shared motion algorithms
+    using StandardDrive = Drivetrain<DifferentialChassis>;
 }
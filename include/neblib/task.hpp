@@ -0,0 +1,346 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief Bytes of inline storage for a task's callable and its return value
+    constexpr std::size_t taskStorageSize = 64;
+
+    /// @brief Number of tasks launched through neblib that can be alive at once
+    constexpr std::size_t maxTasks = 16;
+
+    /// @brief Storage for one launched task, taken from a fixed pool instead of the heap
+    ///
+    /// The callable and its return value live in the inline storage. A slot is
+    /// returned to the pool once both the running task and its neblib::Task
+    /// handle (if any) are done with it.
+    struct TaskSlot
+    {
+        enum State
+        {
+            Free = 0, //< In the pool, the value the static pool starts with
+            Running,
+            Finished,
+            Cancelled
+        };
+
+        alignas(8) unsigned char storage[taskStorageSize];
+        void (*run)(TaskSlot &slot); //< Invokes the callable and stores the result
+        void (*destroyCallable)(TaskSlot &slot); //< Destroys the callable
+        void (*destroyResult)(TaskSlot &slot); //< Destroys the stored result
+        std::atomic<int> state; //< Leaves Running only by compare-exchange, so finishing and cancelling can't both tear the slot down
+        std::atomic<bool> returned; //< True once the callable returned and its result is stored
+        std::atomic<int> references; //< Owners of the slot: the running task and the handle
+        vex::task task;
+    };
+
+    /// @brief Takes a free slot from the pool
+    ///
+    /// @param references number of owners that will release the slot
+    /// @return pointer to the slot, nullptr if every slot is in use
+    TaskSlot *acquireTaskSlot(int references);
+
+    /// @brief Drops one owner of a slot, returning it to the pool after the last
+    ///
+    /// The last owner destroys a stored result before the slot is marked
+    /// free, so it cannot be taken again while that is running.
+    ///
+    /// @param slot the slot
+    void releaseTaskSlot(TaskSlot *slot);
+
+    /// @brief Entry point of every task launched through neblib
+    ///
+    /// @param parameters pointer to the neblib::TaskSlot
+    /// @return 0
+    int runTaskSlot(void *parameters);
+
+    /// @brief Stops a slot's task if it is still running and drops the task's ownership
+    ///
+    /// @param slot the slot
+    /// @return true if the task was stopped before finishing
+    bool cancelTaskSlot(TaskSlot *slot);
+
+    /// @brief Layout of a callable and its return value inside a neblib::TaskSlot
+    ///
+    /// The result comes first so it can be found without knowing the callable's type.
+    template <class F, class R>
+    struct TaskStorage
+    {
+        typename std::aligned_storage<sizeof(R), alignof(R)>::type result;
+        F function;
+
+        static void run(TaskSlot &slot)
+        {
+            TaskStorage &self = *reinterpret_cast<TaskStorage *>(slot.storage);
+            new (&self.result) R(self.function());
+            slot.returned.store(true);
+        }
+
+        static void destroyCallable(TaskSlot &slot)
+        {
+            reinterpret_cast<TaskStorage *>(slot.storage)->function.~F();
+        }
+
+        static void destroyResult(TaskSlot &slot)
+        {
+            reinterpret_cast<R *>(slot.storage)->~R();
+        }
+    };
+
+    /// @brief Layout of a callable without a return value inside a neblib::TaskSlot
+    template <class F>
+    struct TaskStorage<F, void>
+    {
+        F function;
+
+        static void run(TaskSlot &slot)
+        {
+            TaskStorage &self = *reinterpret_cast<TaskStorage *>(slot.storage);
+            self.function();
+            slot.returned.store(true);
+        }
+
+        static void destroyCallable(TaskSlot &slot)
+        {
+            reinterpret_cast<TaskStorage *>(slot.storage)->function.~F();
+        }
+
+        static void destroyResult(TaskSlot &slot)
+        {
+        }
+    };
+
+    /// @brief Places a callable in a slot and starts it as a vex::task
+    ///
+    /// Fails to compile if the callable and its return value do not fit in neblib::taskStorageSize.
+    ///
+    /// @param function callable to run
+    /// @param references number of owners that will release the slot
+    /// @param priority vex::task priority
+    /// @return the running slot, nullptr if every slot is in use
+    template <class F>
+    TaskSlot *startTaskSlot(F &&function, int references, int priority)
+    {
+        typedef typename std::decay<F>::type Function;
+        typedef typename std::result_of<Function()>::type Result;
+        typedef TaskStorage<Function, Result> Storage;
+        static_assert(sizeof(Storage) <= taskStorageSize, "callable is too large for inline task storage, capture less or raise neblib::taskStorageSize");
+        static_assert(alignof(Storage) <= 8, "callable needs more alignment than inline task storage provides");
+
+        TaskSlot *slot = acquireTaskSlot(references);
+        if (!slot)
+            return nullptr;
+
+        new (&reinterpret_cast<Storage *>(slot->storage)->function) Function(std::forward<F>(function));
+        slot->run = &Storage::run;
+        slot->destroyCallable = &Storage::destroyCallable;
+        slot->destroyResult = &Storage::destroyResult;
+        slot->task = vex::task(runTaskSlot, slot, priority);
+        return slot;
+    }
+
+    /// @brief Handle to a task launched with neblib::spawnTask
+    ///
+    /// Destroying the handle without joining detaches the task, which keeps running.
+    ///
+    /// @tparam R return type of the task
+    template <class R>
+    class Task
+    {
+    private:
+        TaskSlot *slot;
+
+        /// @brief Waits until the task stops running
+        /// @return true if the task finished, false if it was cancelled or never started
+        bool wait()
+        {
+            if (!slot)
+                return false;
+            while (slot->state.load() == TaskSlot::Running)
+                vex::task::sleep(1);
+            return slot->state.load() == TaskSlot::Finished;
+        }
+
+        /// @brief Drops the handle's ownership of the slot
+        void release()
+        {
+            if (slot)
+                releaseTaskSlot(slot);
+            slot = nullptr;
+        }
+
+    public:
+        /// @brief Wraps a running slot
+        /// @param slot the slot, nullptr for a task that could not start
+        explicit Task(TaskSlot *slot)
+            : slot(slot)
+        {
+        }
+
+        Task(Task &&other)
+            : slot(other.slot)
+        {
+            other.slot = nullptr;
+        }
+
+        Task &operator=(Task &&other)
+        {
+            if (this != &other)
+            {
+                release();
+                slot = other.slot;
+                other.slot = nullptr;
+            }
+            return *this;
+        }
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        ~Task()
+        {
+            release();
+        }
+
+        /// @brief Determines if the handle refers to a task
+        /// @return false if the task could not start or was already joined or cancelled
+        bool valid() const
+        {
+            return slot != nullptr;
+        }
+
+        /// @brief Determines if the task has stopped running
+        /// @return true once the task has finished or been cancelled
+        bool isDone() const
+        {
+            return !slot || slot->state.load() != TaskSlot::Running;
+        }
+
+        /// @brief Blocks until the task finishes and takes its return value
+        ///
+        /// @param result set to the task's return value
+        /// @return true if the task finished, false if it was cancelled or never started
+        bool join(R &result)
+        {
+            const bool finished = wait();
+            if (finished)
+                result = std::move(*reinterpret_cast<R *>(slot->storage));
+            release();
+            return finished;
+        }
+
+        /// @brief Stops the task if it is still running
+        ///
+        /// @return true if the task was stopped before finishing
+        bool cancel()
+        {
+            if (!slot)
+                return false;
+
+            const bool cancelled = cancelTaskSlot(slot);
+            release();
+            return cancelled;
+        }
+    };
+
+    /// @brief Handle to a task launched with neblib::spawnTask that does not return a value
+    template <>
+    class Task<void>
+    {
+    private:
+        TaskSlot *slot;
+
+        void release()
+        {
+            if (slot)
+                releaseTaskSlot(slot);
+            slot = nullptr;
+        }
+
+    public:
+        explicit Task(TaskSlot *slot)
+            : slot(slot)
+        {
+        }
+
+        Task(Task &&other)
+            : slot(other.slot)
+        {
+            other.slot = nullptr;
+        }
+
+        Task &operator=(Task &&other)
+        {
+            if (this != &other)
+            {
+                release();
+                slot = other.slot;
+                other.slot = nullptr;
+            }
+            return *this;
+        }
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        ~Task()
+        {
+            release();
+        }
+
+        bool valid() const
+        {
+            return slot != nullptr;
+        }
+
+        bool isDone() const
+        {
+            return !slot || slot->state.load() != TaskSlot::Running;
+        }
+
+        /// @brief Blocks until the task finishes
+        /// @return true if the task finished, false if it was cancelled or never started
+        bool join()
+        {
+            if (!slot)
+                return false;
+            while (slot->state.load() == TaskSlot::Running)
+                vex::task::sleep(1);
+            const bool finished = slot->state.load() == TaskSlot::Finished;
+            release();
+            return finished;
+        }
+
+        bool cancel()
+        {
+            if (!slot)
+                return false;
+
+            const bool cancelled = cancelTaskSlot(slot);
+            release();
+            return cancelled;
+        }
+    };
+
+    /// @brief Launches a task without allocating, keeping a handle to join or cancel it
+    ///
+    /// The callable is stored in a fixed pool of neblib::maxTasks slots. Fails to
+    /// compile if the callable and its return value do not fit in neblib::taskStorageSize.
+    ///
+    /// @param function callable to run as a task
+    /// @param priority vex::task priority
+    /// @return neblib::Task handle, not valid if every slot is in use
+    template <class F>
+    Task<typename std::result_of<typename std::decay<F>::type()>::type> spawnTask(F &&function, int priority = vex::task::taskPriorityNormal)
+    {
+        typedef typename std::result_of<typename std::decay<F>::type()>::type Result;
+        return Task<Result>(startTaskSlot(std::forward<F>(function), 2, priority));
+    }
+
+} // namespace neblib
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "neblib/telemetry_format.hpp"
+
+namespace neblib
+{
+    /// @brief Fixed capacity lock-free queue for one producer task and one consumer task
+    ///
+    /// Both ends are wait-free: push() fails immediately and counts the
+    /// dropped element when the queue is full instead of blocking the producer.
+    ///
+    /// @tparam T type of the elements, copied in and out
+    /// @tparam Capacity number of elements, must be a power of two
+    template <class T, std::size_t Capacity>
+    class SpscQueue
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    private:
+        T elements[Capacity];
+        std::atomic<std::uint32_t> head; //< Number of elements pushed, only written by the producer
+        std::atomic<std::uint32_t> tail; //< Number of elements popped, only written by the consumer
+        std::atomic<std::uint32_t> dropped; //< Number of elements pushed while full, only written by the producer
+
+    public:
+        /// @brief Creates an empty SpscQueue
+        SpscQueue()
+            : head(0),
+              tail(0),
+              dropped(0)
+        {
+        }
+
+        SpscQueue(const SpscQueue &) = delete;
+        SpscQueue &operator=(const SpscQueue &) = delete;
+
+        /// @brief Adds an element, only call from the producer task
+        ///
+        /// @param element element to copy into the queue
+        /// @return false if the queue was full and the element was dropped
+        bool push(const T &element)
+        {
+            const std::uint32_t currentHead = head.load(std::memory_order_relaxed);
+            if (currentHead - tail.load(std::memory_order_acquire) >= Capacity)
+            {
+                dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            elements[currentHead & (Capacity - 1)] = element;
+            head.store(currentHead + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Removes the oldest element, only call from the consumer task
+        ///
+        /// @param element set to the removed element
+        /// @return false if the queue was empty
+        bool pop(T &element)
+        {
+            const std::uint32_t currentTail = tail.load(std::memory_order_relaxed);
+            if (currentTail == head.load(std::memory_order_acquire))
+                return false;
+
+            element = elements[currentTail & (Capacity - 1)];
+            tail.store(currentTail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Gets the number of elements waiting in the queue
+        /// @return number of elements, may be out of date by the time it returns
+        std::size_t size() const
+        {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+        }
+
+        /// @brief Gets the capacity of the queue
+        /// @return maximum number of elements
+        static constexpr std::size_t capacity()
+        {
+            return Capacity;
+        }
+
+        /// @brief Gets the number of elements dropped because the queue was full
+        /// @return number of dropped elements
+        std::uint32_t getDropped() const
+        {
+            return dropped.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Gets the number of elements pushed successfully
+        /// @return number of pushed elements
+        std::uint32_t getPushed() const
+        {
+            return head.load(std::memory_order_relaxed);
+        }
+    };
+
+    /// @brief Queue carrying telemetry records from a control loop to a neblib::TelemetryLogger
+    typedef SpscQueue<TelemetryRecord, 256> TelemetryQueue;
+
+    /// @brief Drains a telemetry queue in the background and hands each record to a sink
+    ///
+    /// Slow work such as printing or writing to the SD card happens here,
+    /// away from the control loops producing the records.
+    class TelemetryLogger
+    {
+    private:
+        // ---------- Configuration ----------
+        neblib::TelemetryQueue &queue;
+        void (*sink)(const neblib::TelemetryRecord &record, void *context);
+        void *context;
+        int periodMS;
+
+        // ---------- State ----------
+        bool running;
+        std::uint32_t drained;
+
+    public:
+        /// @brief Creates a new TelemetryLogger
+        ///
+        /// @param queue queue to drain
+        /// @param sink function called with every record, in order
+        /// @param context pointer passed to the sink
+        /// @param periodMS time (ms) between drains
+        TelemetryLogger(
+            neblib::TelemetryQueue &queue,
+            void (*sink)(const neblib::TelemetryRecord &record, void *context),
+            void *context = nullptr,
+            int periodMS = 20);
+
+        /// @brief Begins a self-contained loop draining the queue until stopped
+        ///
+        /// Designed to work best with neblib::spawnTask() at a low priority
+        ///
+        /// @return returns 0 when the loop ends
+        int begin();
+
+        /// @brief Stops the drain loop, the remaining records are drained before it ends
+        void stop();
+
+        /// @brief Hands every waiting record to the sink
+        ///
+        /// @return number of records drained
+        int drain();
+
+        /// @brief Gets the number of records handed to the sink
+        /// @return number of records
+        std::uint32_t getDrained();
+    };
+
+} // namespace neblib
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace neblib
+{
+    /// @brief Snapshot of a control loop iteration
+    ///
+    /// time: System time (ms) the record was made
+    /// source: Motion that made the record
+    /// loopTime: Time (us) since the previous record from the same drivetrain, saturates at 65535
+    /// x, y, heading: Pose of the robot
+    /// linearError, angularError: Errors fed to the controllers
+    /// linearOutput, angularOutput: Outputs of the controllers
+    /// voltages: Voltage last commanded to each motor group, left then right on a Standard Drive
+    ///           and in constructor order on a holonomic drive, 0 once stopped or if there is no such group
+    struct TelemetryRecord
+    {
+        enum Source
+        {
+            Drive,
+            Turn,
+            Swing,
+            Arc,
+            User
+        };
+
+        /// @brief Number of motor groups with a recorded voltage, enough for the largest drivetrain
+        static constexpr std::size_t voltageCount = 6;
+
+        std::uint32_t time;
+        std::uint16_t source;
+        std::uint16_t loopTime;
+        float x;
+        float y;
+        float heading;
+        float linearError;
+        float angularError;
+        float linearOutput;
+        float angularOutput;
+        float voltages[voltageCount];
+
+        /// @brief Creates a zeroed TelemetryRecord
+        TelemetryRecord();
+    };
+
+    /// @brief Binary telemetry log format
+    ///
+    /// A log is a file header followed by blocks. The file header is the
+    /// magic "NBTL" and a version byte. Each block is a little-endian
+    /// uint16 payload length and uint16 record count followed by the
+    /// payload, and decodes on its own, so a block cut short by power loss
+    /// only loses that block.
+    ///
+    /// Within a block each record is stored relative to the previous record
+    /// (the first to a zeroed record): the time difference as an unsigned
+    /// varint, source and loopTime as plain unsigned varints, then each float
+    /// quantized to fixed point and its difference stored as a zigzag varint.
+    /// Positions, heading, and errors are stored in hundredths, outputs and
+    /// voltages in thousandths. Version 1 logs end each record after the
+    /// outputs, without voltages.
+    namespace telemetry_format
+    {
+        /// @brief Version written to new logs
+        constexpr std::uint8_t version = 2;
+
+        /// @brief Size of the file header
+        constexpr std::size_t headerSize = 5;
+
+        /// @brief Size of the header in front of every block
+        constexpr std::size_t blockHeaderSize = 4;
+
+        /// @brief Largest number of bytes a single encoded record can take
+        constexpr std::size_t maxRecordSize = 5 + 3 + 3 + (7 + TelemetryRecord::voltageCount) * 5;
+
+        /// @brief Writes the file header
+        /// @param out buffer of at least headerSize bytes
+        /// @return number of bytes written
+        std::size_t writeHeader(std::uint8_t *out);
+
+        /// @brief Reads the file header
+        /// @param in start of the file
+        /// @param size number of bytes available
+        /// @return version of the log, -1 if the header is missing or not a telemetry log
+        int readHeader(
+            const std::uint8_t *in,
+            std::size_t size);
+
+        /// @brief Writes a block header
+        /// @param out buffer of at least blockHeaderSize bytes
+        /// @param payloadSize number of bytes of encoded records in the block
+        /// @param count number of records in the block
+        void writeBlockHeader(
+            std::uint8_t *out,
+            std::uint16_t payloadSize,
+            std::uint16_t count);
+
+        /// @brief Reads a block header
+        /// @param in start of the block
+        /// @param payloadSize set to the number of bytes of encoded records in the block
+        /// @param count set to the number of records in the block
+        void readBlockHeader(
+            const std::uint8_t *in,
+            std::uint16_t &payloadSize,
+            std::uint16_t &count);
+    } // namespace telemetry_format
+
+    /// @brief Encodes telemetry records as differences from the previous record
+    class TelemetryEncoder
+    {
+    private:
+        std::uint32_t previousTime;
+        std::int32_t previous[7 + TelemetryRecord::voltageCount];
+
+    public:
+        /// @brief Creates a new TelemetryEncoder at the start of a block
+        TelemetryEncoder();
+
+        /// @brief Starts a new block, the next record is encoded from a zeroed record
+        void reset();
+
+        /// @brief Encodes a record
+        ///
+        /// @param record record to encode
+        /// @param out buffer of at least telemetry_format::maxRecordSize bytes
+        /// @return number of bytes written
+        std::size_t encode(
+            const neblib::TelemetryRecord &record,
+            std::uint8_t *out);
+    };
+
+    /// @brief Decodes telemetry records written by a neblib::TelemetryEncoder
+    class TelemetryDecoder
+    {
+    private:
+        std::size_t fieldsPerRecord; //< Number of float fields per record in the log's version
+        std::uint32_t previousTime;
+        std::int32_t previous[7 + TelemetryRecord::voltageCount];
+
+    public:
+        /// @brief Creates a new TelemetryDecoder at the start of a block
+        ///
+        /// @param version version of the log, as returned by telemetry_format::readHeader()
+        explicit TelemetryDecoder(int version = telemetry_format::version);
+
+        /// @brief Starts a new block
+        void reset();
+
+        /// @brief Decodes a record
+        ///
+        /// @param in encoded bytes
+        /// @param size number of bytes available
+        /// @param record set to the decoded record
+        /// @return number of bytes read, 0 if the record is cut short
+        std::size_t decode(
+            const std::uint8_t *in,
+            std::size_t size,
+            neblib::TelemetryRecord &record);
+    };
+
+} // namespace neblib
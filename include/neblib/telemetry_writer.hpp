@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "neblib/telemetry_format.hpp"
+#include "vex.h"
+
+namespace neblib
+{
+    /// @brief Writes telemetry records to the SD card in the binary telemetry format
+    ///
+    /// Records are encoded into one of two preallocated buffers. When a
+    /// buffer fills it is handed to the flush loop, which writes it to the
+    /// card as a whole block while the other buffer fills. Encoding never
+    /// waits on the card; if both buffers are full the record is dropped
+    /// and counted instead.
+    ///
+    /// Decode logs on a computer with tools/telemetry_to_csv.cpp.
+    class SdTelemetryWriter
+    {
+    private:
+        // ---------- Devices ----------
+        vex::brain::sdcard &sdCard;
+
+        // ---------- Configuration ----------
+        const char *fileName;
+        std::size_t blockSize;
+        int periodMS;
+
+        // ---------- Buffers ----------
+        std::vector<std::uint8_t> buffers[2];
+        int activeBuffer; //< Buffer records are encoded into
+        std::size_t activeSize; //< Bytes used in the active buffer, including the block header
+        std::uint16_t activeCount; //< Records in the active buffer
+        std::atomic<int> pendingBuffer; //< Full buffer waiting to be written, -1 if none
+        std::size_t pendingSize;
+        neblib::TelemetryEncoder encoder;
+
+        // ---------- State ----------
+        bool opened;
+        bool running;
+        std::uint32_t written; //< Records handed to the card
+        std::uint32_t dropped; //< Records dropped because the log was not open or both buffers were full
+        std::uint32_t bytesWritten;
+        std::uint32_t writeErrors;
+        std::uint32_t maxFlushTime; //< Longest time (us) a block took to write
+
+        /// @brief Hands the active buffer to the flush loop and starts a new block in the other
+        /// @return false if the other buffer is still waiting to be written
+        bool swapBuffers();
+
+        /// @brief Writes a buffer to the card
+        void writeBuffer(
+            int buffer,
+            std::size_t size);
+
+    public:
+        /// @brief Creates a new SdTelemetryWriter, allocating both buffers
+        ///
+        /// @param sdCard SD card of the brain, usually Brain.SDcard
+        /// @param fileName name of the log file, replaced when opened
+        /// @param blockSize size (bytes) of each buffer, at most 65535
+        /// @param periodMS time (ms) between checks for a full buffer
+        SdTelemetryWriter(
+            vex::brain::sdcard &sdCard,
+            const char *fileName,
+            std::size_t blockSize = 8192,
+            int periodMS = 50);
+
+        /// @brief Creates the log file and writes its header
+        ///
+        /// @return 0 on success, -1 if no SD card is inserted, -2 if the file could not be written
+        int open();
+
+        /// @brief Encodes a record into the active buffer, never blocks on the SD card
+        ///
+        /// Only call from a single task, usually the sink of a neblib::TelemetryLogger.
+        ///
+        /// @param record record to write
+        /// @return false if the record was dropped
+        bool write(const neblib::TelemetryRecord &record);
+
+        /// @brief Sink for a neblib::TelemetryLogger
+        ///
+        /// @param record record to write
+        /// @param writer pointer to the neblib::SdTelemetryWriter
+        static void sink(
+            const neblib::TelemetryRecord &record,
+            void *writer);
+
+        /// @brief Begins a self-contained loop writing full buffers to the card until stopped
+        ///
+        /// Designed to work best with neblib::spawnTask() at a low priority
+        ///
+        /// @return returns 0 when the loop ends
+        int begin();
+
+        /// @brief Stops the flush loop
+        void stop();
+
+        /// @brief Writes every buffered record to the card, including a partially filled block
+        ///
+        /// Call after stopping the flush loop once no more records are being
+        /// written, such as at the end of a match.
+        void flush();
+
+        /// @brief Gets the number of records written to the card
+        /// @return number of records
+        std::uint32_t getWritten();
+
+        /// @brief Gets the number of records dropped because both buffers were full
+        /// @return number of records
+        std::uint32_t getDropped();
+
+        /// @brief Gets the number of bytes written to the card
+        /// @return number of bytes
+        std::uint32_t getBytesWritten();
+
+        /// @brief Gets the number of blocks the card failed to write
+        /// @return number of failed writes
+        std::uint32_t getWriteErrors();
+
+        /// @brief Gets the longest time a block took to write
+        /// @return time in microseconds
+        std::uint32_t getMaxFlushTime();
+    };
+
+} // namespace neblib
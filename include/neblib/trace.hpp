@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// Scoped tracing
+///
+/// NEBLIB_TRACE_SCOPE("name") records when the enclosing scope begins and
+/// ends into a fixed ring of events, overwriting the oldest once full.
+/// Build with NEBLIB_TRACE defined (make TRACE=1) to enable it; otherwise
+/// the macro expands to nothing and no trace storage is compiled in.
+///
+/// After a run, neblib::exportChromeTrace() writes the events as Chrome
+/// trace JSON, which can be opened in chrome://tracing or ui.perfetto.dev.
+
+#if defined(NEBLIB_TRACE)
+#define NEBLIB_TRACE_CONCAT_INNER(a, b) a##b
+#define NEBLIB_TRACE_CONCAT(a, b) NEBLIB_TRACE_CONCAT_INNER(a, b)
+#define NEBLIB_TRACE_SCOPE(name) neblib::TraceScope NEBLIB_TRACE_CONCAT(neblibTraceScope, __LINE__)(name)
+#else
+#define NEBLIB_TRACE_SCOPE(name) ((void)0)
+#endif
+
+namespace neblib
+{
+    /// @brief Number of events the trace ring holds
+    constexpr std::size_t traceCapacity = 4096;
+
+    /// @brief A completed trace scope
+    ///
+    /// name: Name given to the scope, must be a string literal or otherwise outlive the trace
+    /// start: System time (us) the scope began
+    /// duration: Time (us) the scope lasted
+    /// task: ID of the task the scope ran in
+    struct TraceEvent
+    {
+        const char *name;
+        std::uint32_t start;
+        std::uint32_t duration;
+        std::int32_t task;
+    };
+
+    /// @brief Records a completed scope into the trace ring
+    ///
+    /// Does nothing unless NEBLIB_TRACE is defined.
+    ///
+    /// @param name name of the scope
+    /// @param start system time (us) the scope began
+    /// @param end system time (us) the scope ended
+    void recordTrace(
+        const char *name,
+        std::uint64_t start,
+        std::uint64_t end);
+
+    /// @brief Gets the number of events held in the trace ring
+    /// @return number of events, at most neblib::traceCapacity
+    std::size_t getTraceCount();
+
+    /// @brief Gets the number of events overwritten because the ring was full
+    /// @return number of lost events
+    std::size_t getTraceLost();
+
+    /// @brief Removes every event from the trace ring
+    void clearTrace();
+
+    /// @brief Writes the trace ring as Chrome trace JSON, oldest event first
+    ///
+    /// Slow, call once tracing is finished such as after a match.
+    ///
+    /// @param fileName file to write, on the SD card when run on the brain
+    /// @return number of events written, -1 if the file could not be opened
+    int exportChromeTrace(const char *fileName);
+
+    /// @brief Records the lifetime of a scope, use through NEBLIB_TRACE_SCOPE
+    class TraceScope
+    {
+    private:
+        const char *name;
+        std::uint64_t start;
+
+    public:
+        /// @brief Begins a trace scope
+        /// @param name name of the scope, must be a string literal or otherwise outlive the trace
+        explicit TraceScope(const char *name);
+
+        /// @brief Ends the trace scope and records it
+        ~TraceScope();
+
+        TraceScope(const TraceScope &) = delete;
+        TraceScope &operator=(const TraceScope &) = delete;
+    };
+
+} // namespace neblib
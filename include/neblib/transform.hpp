@@ -0,0 +1,373 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include "neblib/position_tracking.hpp"
+
+namespace neblib
+{
+    // Frame convention used by every module: x is right, y is forward and
+    // headings are degrees clockwise from +y. A robot's local frame follows
+    // the same convention, with x to its right and y straight ahead.
+
+    /// @brief Heading with its sine and cosine cached
+    ///
+    /// Rotating a point costs four multiplies once the rotation exists, and
+    /// adding rotations uses the angle sum identities, so a chain of
+    /// conversions calls sin and cos once.
+    class Rotation
+    {
+    private:
+        double heading;
+        double sine;
+        double cosine;
+
+        Rotation(
+            double heading,
+            double sine,
+            double cosine)
+            : heading(heading),
+              sine(sine),
+              cosine(cosine)
+        {
+        }
+
+    public:
+        /// @brief Creates a rotation facing +y
+        Rotation()
+            : heading(0.0),
+              sine(0.0),
+              cosine(1.0)
+        {
+        }
+
+        /// @brief Creates a rotation from a heading
+        /// @param heading heading (deg), clockwise from +y
+        explicit Rotation(double heading)
+            : heading(heading),
+              sine(std::sin(heading * M_PI / 180.0)),
+              cosine(std::cos(heading * M_PI / 180.0))
+        {
+        }
+
+        /// @brief Creates a rotation from a heading in radians, clockwise from +y
+        static Rotation fromRadians(double radians)
+        {
+            return Rotation(radians * 180.0 / M_PI, std::sin(radians), std::cos(radians));
+        }
+
+        /// @brief Gets the heading (deg), unwrapped
+        double degrees() const
+        {
+            return heading;
+        }
+
+        double radians() const
+        {
+            return heading * M_PI / 180.0;
+        }
+
+        double sin() const
+        {
+            return sine;
+        }
+
+        double cos() const
+        {
+            return cosine;
+        }
+
+        /// @brief Converts a point from the rotated frame to the frame the rotation is given in
+        ///
+        /// @param right distance to the right in the rotated frame
+        /// @param forward distance ahead in the rotated frame
+        /// @param x set to the x of the point
+        /// @param y set to the y of the point
+        void toGlobal(
+            double right,
+            double forward,
+            double &x,
+            double &y) const
+        {
+            x = right * cosine + forward * sine;
+            y = forward * cosine - right * sine;
+        }
+
+        /// @brief Converts a point into the rotated frame
+        ///
+        /// @param x x of the point
+        /// @param y y of the point
+        /// @param right set to the distance to the right in the rotated frame
+        /// @param forward set to the distance ahead in the rotated frame
+        void toLocal(
+            double x,
+            double y,
+            double &right,
+            double &forward) const
+        {
+            right = x * cosine - y * sine;
+            forward = x * sine + y * cosine;
+        }
+
+        /// @brief Turns by another rotation, clockwise is positive
+        Rotation operator+(const Rotation &other) const
+        {
+            return Rotation(
+                heading + other.heading,
+                sine * other.cosine + cosine * other.sine,
+                cosine * other.cosine - sine * other.sine);
+        }
+
+        /// @brief Gets the opposite rotation
+        Rotation operator-() const
+        {
+            return Rotation(-heading, -sine, cosine);
+        }
+
+        Rotation operator-(const Rotation &other) const
+        {
+            return *this + -other;
+        }
+    };
+
+    /// @brief Velocity in a robot's own frame, or a motion of one loop when integrated over unit time
+    ///
+    /// right: sideways distance (in), right is positive
+    /// forward: forward distance (in)
+    /// turn: change in heading (deg), clockwise is positive
+    struct Twist
+    {
+        double right;
+        double forward;
+        double turn;
+
+        Twist(
+            double right,
+            double forward,
+            double turn)
+            : right(right),
+              forward(forward),
+              turn(turn)
+        {
+        }
+
+        Twist()
+            : right(0.0),
+              forward(0.0),
+              turn(0.0)
+        {
+        }
+    };
+
+    /// @brief Rigid transform in the plane (SE(2)), a neblib::Pose with its heading's sine and cosine cached
+    ///
+    /// A transform is both a pose and the change of frame from the pose's
+    /// local frame to the frame it is given in. Composition with operator*
+    /// reads left to right: a * b is b expressed in a's frame, moved into
+    /// the frame a is given in.
+    class Transform
+    {
+    private:
+        double x;
+        double y;
+        Rotation rotation;
+
+    public:
+        /// @brief Creates the identity transform
+        Transform()
+            : x(0.0),
+              y(0.0),
+              rotation()
+        {
+        }
+
+        /// @brief Creates a new Transform
+        /// @param x x position
+        /// @param y y position
+        /// @param heading heading (deg), clockwise from +y
+        Transform(
+            double x,
+            double y,
+            double heading)
+            : x(x),
+              y(y),
+              rotation(heading)
+        {
+        }
+
+        /// @brief Creates a new Transform
+        /// @param x x position
+        /// @param y y position
+        /// @param rotation heading
+        Transform(
+            double x,
+            double y,
+            const Rotation &rotation)
+            : x(x),
+              y(y),
+              rotation(rotation)
+        {
+        }
+
+        /// @brief Creates a transform at a pose
+        explicit Transform(const Pose &pose)
+            : x(pose.x),
+              y(pose.y),
+              rotation(pose.heading)
+        {
+        }
+
+        double getX() const
+        {
+            return x;
+        }
+
+        double getY() const
+        {
+            return y;
+        }
+
+        const Rotation &getRotation() const
+        {
+            return rotation;
+        }
+
+        /// @brief Gets the transform as a pose, heading wrapped to [0, 360)
+        Pose toPose() const;
+
+        /// @brief Converts a point from the local frame to the frame the transform is given in
+        ///
+        /// @param right distance to the right of the pose
+        /// @param forward distance ahead of the pose
+        /// @param globalX set to the x of the point
+        /// @param globalY set to the y of the point
+        void toGlobal(
+            double right,
+            double forward,
+            double &globalX,
+            double &globalY) const
+        {
+            rotation.toGlobal(right, forward, globalX, globalY);
+            globalX += x;
+            globalY += y;
+        }
+
+        /// @brief Converts a point into the local frame
+        ///
+        /// @param globalX x of the point
+        /// @param globalY y of the point
+        /// @param right set to the distance to the right of the pose
+        /// @param forward set to the distance ahead of the pose
+        void toLocal(
+            double globalX,
+            double globalY,
+            double &right,
+            double &forward) const
+        {
+            rotation.toLocal(globalX - x, globalY - y, right, forward);
+        }
+
+        /// @brief Composes two transforms
+        /// @param local transform given in this transform's frame
+        /// @return local, given in the frame this transform is given in
+        Transform operator*(const Transform &local) const
+        {
+            double globalX;
+            double globalY;
+            toGlobal(local.x, local.y, globalX, globalY);
+            return Transform(globalX, globalY, rotation + local.rotation);
+        }
+
+        /// @brief Gets the transform that undoes this one
+        Transform inverse() const
+        {
+            double right;
+            double forward;
+            rotation.toLocal(-x, -y, right, forward);
+            return Transform(right, forward, -rotation);
+        }
+
+        /// @brief Gets this pose as seen from another pose
+        /// @param origin pose whose frame the result is given in
+        Transform relativeTo(const Transform &origin) const
+        {
+            return origin.inverse() * *this;
+        }
+
+        /// @brief Integrates a constant twist over unit time, following an arc
+        ///
+        /// Moving by exp(twist) from a pose is the exact motion of a robot
+        /// turning at a constant rate, as odometry assumes within one loop.
+        static Transform exp(const Twist &twist);
+
+        /// @brief Finds the constant twist that moves from the identity to this transform in unit time
+        Twist log() const;
+    };
+
+    // ---------- Batch Kernels ----------
+    // Transform whole arrays in one pass, for paths, particles and field
+    // maps. Points are stored as structures of arrays, and the loops have
+    // no calls or branches so the compiler can vectorize them. Outputs may
+    // be the same arrays as the inputs.
+
+    /// @brief Converts points from a transform's local frame to the frame it is given in
+    ///
+    /// @param transform transform to apply
+    /// @param right distance of each point to the right of the pose
+    /// @param forward distance of each point ahead of the pose
+    /// @param x set to the x of each point
+    /// @param y set to the y of each point
+    /// @param count number of points
+    void transformPoints(
+        const Transform &transform,
+        const double *right,
+        const double *forward,
+        double *x,
+        double *y,
+        std::size_t count);
+
+    /// @brief Converts points into a transform's local frame
+    ///
+    /// @param transform transform whose frame the results are given in
+    /// @param x x of each point
+    /// @param y y of each point
+    /// @param right set to the distance of each point to the right of the pose
+    /// @param forward set to the distance of each point ahead of the pose
+    /// @param count number of points
+    void inverseTransformPoints(
+        const Transform &transform,
+        const double *x,
+        const double *y,
+        double *right,
+        double *forward,
+        std::size_t count);
+
+    /// @brief Composes a transform with many poses, such as moving every particle of a filter
+    ///
+    /// Headings within [0, 360) stay within [0, 360).
+    ///
+    /// @param transform transform to apply
+    /// @param x x of each pose, replaced by the result
+    /// @param y y of each pose, replaced by the result
+    /// @param heading heading (deg) of each pose, replaced by the result
+    /// @param count number of poses
+    void transformPoses(
+        const Transform &transform,
+        double *x,
+        double *y,
+        double *heading,
+        std::size_t count);
+
+    /// @brief Composes a transform with many poses stored as neblib::Pose, such as a planned path
+    ///
+    /// Headings within [0, 360) stay within [0, 360).
+    ///
+    /// @param transform transform to apply
+    /// @param poses poses, replaced by the result
+    /// @param count number of poses
+    void transformPoses(
+        const Transform &transform,
+        Pose *poses,
+        std::size_t count);
+
+} // namespace neblib
@@ -0,0 +1,403 @@
+#pragma once
+
+#include <cmath>
+
+namespace neblib
+{
+    /// @brief Strongly typed physical quantity, stored as a double in the quantity's base unit
+    ///
+    /// Quantities of the same kind add, subtract, compare and scale by
+    /// numbers. Mixing kinds, or passing a bare number where a quantity is
+    /// expected, does not compile. Everything is inline and constexpr where
+    /// C++11 allows, so a quantity compiles to the double it holds.
+    ///
+    /// @tparam Derived the quantity type, e.g. neblib::Angle
+    template <class Derived>
+    class Quantity
+    {
+    protected:
+        double value;
+
+        constexpr explicit Quantity(double value)
+            : value(value)
+        {
+        }
+
+    public:
+        /// @brief Gets the value in the base unit of the quantity
+        constexpr double raw() const
+        {
+            return value;
+        }
+
+        // ---------- Arithmetic ----------
+
+        friend constexpr Derived operator+(Derived a, Derived b)
+        {
+            return Derived(a.raw() + b.raw());
+        }
+
+        friend constexpr Derived operator-(Derived a, Derived b)
+        {
+            return Derived(a.raw() - b.raw());
+        }
+
+        friend constexpr Derived operator-(Derived a)
+        {
+            return Derived(-a.raw());
+        }
+
+        friend constexpr Derived operator*(Derived a, double scale)
+        {
+            return Derived(a.raw() * scale);
+        }
+
+        friend constexpr Derived operator*(double scale, Derived a)
+        {
+            return Derived(a.raw() * scale);
+        }
+
+        friend constexpr Derived operator/(Derived a, double scale)
+        {
+            return Derived(a.raw() / scale);
+        }
+
+        /// @brief Ratio of two quantities of the same kind
+        friend constexpr double operator/(Derived a, Derived b)
+        {
+            return a.raw() / b.raw();
+        }
+
+        Derived &operator+=(Derived other)
+        {
+            value += other.raw();
+            return static_cast<Derived &>(*this);
+        }
+
+        Derived &operator-=(Derived other)
+        {
+            value -= other.raw();
+            return static_cast<Derived &>(*this);
+        }
+
+        Derived &operator*=(double scale)
+        {
+            value *= scale;
+            return static_cast<Derived &>(*this);
+        }
+
+        Derived &operator/=(double scale)
+        {
+            value /= scale;
+            return static_cast<Derived &>(*this);
+        }
+
+        // ---------- Comparison ----------
+
+        friend constexpr bool operator==(Derived a, Derived b)
+        {
+            return a.raw() == b.raw();
+        }
+
+        friend constexpr bool operator!=(Derived a, Derived b)
+        {
+            return a.raw() != b.raw();
+        }
+
+        friend constexpr bool operator<(Derived a, Derived b)
+        {
+            return a.raw() < b.raw();
+        }
+
+        friend constexpr bool operator<=(Derived a, Derived b)
+        {
+            return a.raw() <= b.raw();
+        }
+
+        friend constexpr bool operator>(Derived a, Derived b)
+        {
+            return a.raw() > b.raw();
+        }
+
+        friend constexpr bool operator>=(Derived a, Derived b)
+        {
+            return a.raw() >= b.raw();
+        }
+    };
+
+    /// @brief Angle, stored in degrees
+    ///
+    /// Headings use the library's convention: clockwise from +y.
+    class Angle : public Quantity<Angle>
+    {
+    public:
+        /// @brief Creates a zero angle
+        constexpr Angle()
+            : Quantity<Angle>(0.0)
+        {
+        }
+
+        /// @brief Creates an angle from degrees
+        constexpr explicit Angle(double degrees)
+            : Quantity<Angle>(degrees)
+        {
+        }
+
+        static constexpr Angle fromDegrees(double degrees)
+        {
+            return Angle(degrees);
+        }
+
+        static constexpr Angle fromRadians(double radians)
+        {
+            return Angle(radians * 180.0 / M_PI);
+        }
+
+        constexpr double degrees() const
+        {
+            return value;
+        }
+
+        constexpr double radians() const
+        {
+            return value * M_PI / 180.0;
+        }
+
+        /// @brief Same angle within [0, 360) degrees, in constant time
+        Angle normalized() const
+        {
+            double degrees = std::fmod(value, 360.0);
+            if (degrees < 0.0)
+                degrees += 360.0;
+            // A tiny negative remainder rounds up to 360 when shifted
+            return Angle((degrees >= 360.0) ? 0.0 : degrees);
+        }
+
+        /// @brief Same angle within [-180, 180) degrees, in constant time
+        Angle wrapped() const
+        {
+            const double degrees = normalized().value;
+            return Angle((degrees >= 180.0) ? degrees - 360.0 : degrees);
+        }
+    };
+
+    /// @brief Smallest turn from one angle to another
+    ///
+    /// @param from starting angle, may be unwrapped
+    /// @param to target angle, may be unwrapped
+    /// @return turn within [-180, 180) degrees, clockwise is positive
+    inline Angle shortestDifference(
+        Angle from,
+        Angle to)
+    {
+        return (to - from).wrapped();
+    }
+
+    /// @brief Length, stored in inches
+    class Length : public Quantity<Length>
+    {
+    public:
+        /// @brief Creates a zero length
+        constexpr Length()
+            : Quantity<Length>(0.0)
+        {
+        }
+
+        /// @brief Creates a length from inches
+        constexpr explicit Length(double inches)
+            : Quantity<Length>(inches)
+        {
+        }
+
+        static constexpr Length fromInches(double inches)
+        {
+            return Length(inches);
+        }
+
+        static constexpr Length fromMillimeters(double millimeters)
+        {
+            return Length(millimeters / 25.4);
+        }
+
+        static constexpr Length fromMeters(double meters)
+        {
+            return Length(meters / 0.0254);
+        }
+
+        /// @brief Creates a length from field tiles, 24 in each
+        static constexpr Length fromTiles(double tiles)
+        {
+            return Length(tiles * 24.0);
+        }
+
+        constexpr double inches() const
+        {
+            return value;
+        }
+
+        constexpr double millimeters() const
+        {
+            return value * 25.4;
+        }
+
+        constexpr double meters() const
+        {
+            return value * 0.0254;
+        }
+
+        constexpr double tiles() const
+        {
+            return value / 24.0;
+        }
+    };
+
+    /// @brief Voltage, stored in volts
+    class Voltage : public Quantity<Voltage>
+    {
+    public:
+        /// @brief Creates a zero voltage
+        constexpr Voltage()
+            : Quantity<Voltage>(0.0)
+        {
+        }
+
+        /// @brief Creates a voltage from volts
+        constexpr explicit Voltage(double volts)
+            : Quantity<Voltage>(volts)
+        {
+        }
+
+        static constexpr Voltage fromVolts(double volts)
+        {
+            return Voltage(volts);
+        }
+
+        static constexpr Voltage fromMillivolts(double millivolts)
+        {
+            return Voltage(millivolts / 1000.0);
+        }
+
+        constexpr double volts() const
+        {
+            return value;
+        }
+
+        constexpr double millivolts() const
+        {
+            return value * 1000.0;
+        }
+    };
+
+    /// @brief Duration, stored in milliseconds
+    class Time : public Quantity<Time>
+    {
+    public:
+        /// @brief Creates a zero duration
+        constexpr Time()
+            : Quantity<Time>(0.0)
+        {
+        }
+
+        /// @brief Creates a duration from milliseconds
+        constexpr explicit Time(double milliseconds)
+            : Quantity<Time>(milliseconds)
+        {
+        }
+
+        static constexpr Time fromMilliseconds(double milliseconds)
+        {
+            return Time(milliseconds);
+        }
+
+        static constexpr Time fromSeconds(double seconds)
+        {
+            return Time(seconds * 1000.0);
+        }
+
+        constexpr double milliseconds() const
+        {
+            return value;
+        }
+
+        constexpr double seconds() const
+        {
+            return value / 1000.0;
+        }
+    };
+
+    /// @brief Unit suffixes, e.g. 90_deg, 24_in, 6_volt, 2500_ms
+    ///
+    /// Bring into scope with `using namespace neblib::literals;`
+    namespace literals
+    {
+        constexpr Angle operator"" _deg(long double degrees)
+        {
+            return Angle(static_cast<double>(degrees));
+        }
+
+        constexpr Angle operator"" _deg(unsigned long long degrees)
+        {
+            return Angle(static_cast<double>(degrees));
+        }
+
+        constexpr Angle operator"" _rad(long double radians)
+        {
+            return Angle::fromRadians(static_cast<double>(radians));
+        }
+
+        constexpr Length operator"" _in(long double inches)
+        {
+            return Length(static_cast<double>(inches));
+        }
+
+        constexpr Length operator"" _in(unsigned long long inches)
+        {
+            return Length(static_cast<double>(inches));
+        }
+
+        constexpr Length operator"" _mm(long double millimeters)
+        {
+            return Length::fromMillimeters(static_cast<double>(millimeters));
+        }
+
+        constexpr Length operator"" _mm(unsigned long long millimeters)
+        {
+            return Length::fromMillimeters(static_cast<double>(millimeters));
+        }
+
+        constexpr Length operator"" _tiles(long double tiles)
+        {
+            return Length::fromTiles(static_cast<double>(tiles));
+        }
+
+        constexpr Length operator"" _tiles(unsigned long long tiles)
+        {
+            return Length::fromTiles(static_cast<double>(tiles));
+        }
+
+        constexpr Voltage operator"" _volt(long double volts)
+        {
+            return Voltage(static_cast<double>(volts));
+        }
+
+        constexpr Voltage operator"" _volt(unsigned long long volts)
+        {
+            return Voltage(static_cast<double>(volts));
+        }
+
+        constexpr Time operator"" _ms(unsigned long long milliseconds)
+        {
+            return Time(static_cast<double>(milliseconds));
+        }
+
+        constexpr Time operator"" _sec(long double seconds)
+        {
+            return Time::fromSeconds(static_cast<double>(seconds));
+        }
+
+        constexpr Time operator"" _sec(unsigned long long seconds)
+        {
+            return Time::fromSeconds(static_cast<double>(seconds));
+        }
+    } // namespace literals
+} // namespace neblib
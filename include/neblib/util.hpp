@@ -1,26 +1,83 @@
 #pragma once
+#include <cassert>
 #include <functional>
-#include <memory>
 #include <random>
 #include <cstring>
 #include <cctype>
+#include <cstdint>
+#include <limits>
 #include "vex.h"
+#include "neblib/task.hpp"
+#include "neblib/units.hpp"
 
 namespace neblib
 {
-    /// @brief Launches a task using std::bind
+    /// @brief Launches a task without allocating
+    ///
+    /// The callable is stored in the fixed task pool from neblib/task.hpp. Use
+    /// neblib::spawnTask instead to get a return value or to join or cancel the task.
+    ///
+    /// @tparam F
+    /// @param function the function that will be running as a task
+    /// @param task set to the running vex::task, left unchanged on failure
+    /// @return 0 on success, -1 if every slot of the pool is in use
+    template <class F>
+    int launchTask(F &&function, vex::task &task)
+    {
+        TaskSlot *slot = startTaskSlot(std::forward<F>(function), 1, vex::task::taskPriorityNormal);
+        if (!slot)
+            return -1;
+        task = slot->task;
+        return 0;
+    }
+
+    /// @brief Launches a task without allocating
+    ///
+    /// Asserts that a slot of the task pool was free, since the task would
+    /// otherwise silently never run. Use the overload taking a vex::task to
+    /// handle a full pool instead.
+    ///
     /// @tparam F
     /// @param function the function that will be running as a task
     /// @return vex::task
     template <class F>
     vex::task launchTask(F &&function)
     {
-        // static_assert(std::is_invocable_r_v<void, F>);
-        return vex::task([](void *parameters)
-                         {
-    std::unique_ptr<std::function<void()>> ptr{static_cast<std::function<void()>*>(parameters)};
-    (*ptr)();
-    return 0; }, new std::function<void()>(std::forward<F>(function)));
+        vex::task task;
+        const int result = launchTask(std::forward<F>(function), task);
+        assert(result == 0 && "neblib task pool is full, raise neblib::maxTasks");
+        (void)result;
+        return task;
+    }
+
+    /// @brief Positive infinity, used as the default for unbounded limits and timeouts
+    /// @return positive infinity
+    constexpr double infinity()
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    /// @brief Largest representable timeout, used as the default for motions that should not time out
+    /// @return the largest int
+    constexpr int noTimeout()
+    {
+        return std::numeric_limits<int>::max();
+    }
+
+    /// @brief Converts a duration to a motion timeout, saturating at noTimeout()
+    /// @param time duration
+    /// @return timeout (ms)
+    constexpr int toTimeout(Time time)
+    {
+        return (time.milliseconds() >= static_cast<double>(noTimeout())) ? noTimeout() : static_cast<int>(time.milliseconds());
+    }
+
+    /// @brief Passes a timeout already in milliseconds through, so motion code can take either kind
+    /// @param milliseconds timeout (ms)
+    /// @return timeout (ms)
+    constexpr int toTimeout(int milliseconds)
+    {
+        return milliseconds;
     }
 
     /// @brief Determines the sign of a number
@@ -55,6 +112,9 @@ namespace neblib
     double clamp(double num, double min, double max);
 
     /// @brief Keeps a number within a range keeping its local value
+    ///
+    /// Takes the same time however many ranges away the number is.
+    ///
     /// @param num number
     /// @param min minimum acceptable value
     /// @param max maximum acceptable value
@@ -73,9 +133,23 @@ namespace neblib
     /// @return random number
     double uniformRandom(double min, double max);
 
+    /// @brief Seeds the generator behind gaussRandom() and uniformRandom()
+    ///
+    /// It is seeded from std::random_device at startup. Filters and
+    /// simulations that must repeat should own a neblib::Random instead.
+    /// @param seed seed of the sequence
+    void seedRandom(std::uint64_t seed);
+
     /// @brief Determines if a string contains a substring
     /// @param str string
     /// @param substr substring
     /// @return true if string contains substring, false otherwise
     bool contains(const char *str, const char *substr);
+
+    /// @brief Hashes bytes with 32 bit FNV-1a
+    /// @param data first byte
+    /// @param size number of bytes
+    /// @param seed hash of the bytes before these, to hash several blocks as one
+    /// @return hash of the bytes
+    std::uint32_t hash(const void *data, std::size_t size, std::uint32_t seed = 2166136261u);
 }
@@ -1,28 +1,105 @@
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
 #include "neblib/control_algorithms.hpp"
+#include "neblib/drivetrain.hpp"
+#include "neblib/kinematics.hpp"
 #include "neblib/position_tracking.hpp"
 #include "vex.h"
 
 namespace neblib
 {
 
-    class XDrive
+    /// @brief Chassis policy for holonomic drivetrains with one motor group per wheel
+    ///
+    /// Used through neblib::XDrive, neblib::HDrive or neblib::AsteriskDrive,
+    /// which add the shared motion algorithms.
+    ///
+    /// @tparam Wheels number of motor groups, 3, 4 or 6
+    template <std::size_t Wheels>
+    class HolonomicChassis : public Chassis
     {
     private:
-        vex::motor_group &leftFront;
-        vex::motor_group &rightFront;
-        vex::motor_group &leftBack;
-        vex::motor_group &rightBack;
-        vex::inertial &imu;
+        vex::motor_group *motors[Wheels]; //< Motor groups in the wheel order of the kinematics
 
-        neblib::PositionTracking *positionTracking;
+        neblib::HolonomicKinematics<Wheels> kinematics;
 
-        neblib::FeedbackController *linearController;
-        neblib::FeedbackController *angularController;
+    protected:
+        /// @brief Spins the drivetrain in place
+        ///
+        /// @param output turn voltage, clockwise is positive
+        void rotate(double output);
+
+        /// @brief Heading to hold while driving to a point, the current heading
+        ///
+        /// @param current current pose
+        /// @param x target 'x' position
+        /// @param y target 'y' position
+        /// @return heading to hold
+        double pointHeading(
+            const neblib::Pose &current,
+            double x,
+            double y);
+
+        /// @brief Heading error while driving to a pose
+        ///
+        /// @param current current pose
+        /// @param target target pose
+        /// @param distance distance to the target
+        /// @return error between the target heading and the current heading
+        double angularError(
+            const neblib::Pose &current,
+            const neblib::Pose &target,
+            double distance);
+
+        /// @brief Determines if a pose motion is done before its controller settles, never for holonomic drivetrains
+        ///
+        /// A holonomic drivetrain can remove error in any direction, so it
+        /// drives until the linear controller settles.
+        ///
+        /// @return false
+        bool atPose(
+            const neblib::Pose &current,
+            const neblib::Pose &target,
+            double distance);
+
+        /// @brief Drives straight at the target while turning to its heading
+        ///
+        /// @param current current pose
+        /// @param target target pose
+        /// @param drive linear voltage
+        /// @param turn turn voltage
+        void driveToward(
+            const neblib::Pose &current,
+            const neblib::Pose &target,
+            double drive,
+            double turn);
+
+        /// @brief Drives with forward, sideways, and turn voltages
+        ///
+        /// @param drive forward voltage
+        /// @param strafe sideways voltage, right is positive
+        /// @param turn turn voltage, clockwise is positive
+        void driveCommand(
+            double drive,
+            double strafe,
+            double turn);
 
     public:
-        /// @brief Creates a new XDrive object
+        /// @brief Type motion timeouts are given in, milliseconds
+        typedef int Timeout;
+
+        /// @brief Type motions return their time in, milliseconds as XDrive motions always have
+        typedef int Elapsed;
+
+        /// @brief Returns the time (ms) a motion took unchanged
+        static int toElapsed(int milliseconds);
+
+        /// @brief Holonomic drivetrains have no sides to hold still, so they cannot swing
+        static constexpr bool canSwing = false;
+
+        /// @brief Creates a new XDrive object, mixing with neblib::xDriveKinematics()
         ///
         /// @param leftFront reference to a VEX motor group on the front left of the drivetrain
         /// @param rightFront reference to a VEX motor group on the front right of the drivetrain
@@ -30,35 +107,106 @@ namespace neblib
         /// @param rightBack reference to a VEX motor group on the back right of the drivetrain
         /// @param imu reference to a VEX V5 Inertial sensor
         /// @param positionTracking pointer to any neblib::PositionTracking object or nullptr
-        XDrive(vex::motor_group &leftFront,
-               vex::motor_group &rightFront,
-               vex::motor_group &leftBack,
-               vex::motor_group &rightBack,
-               vex::inertial &imu,
-               neblib::PositionTracking *positionTracking);
+        template <std::size_t Count = Wheels, typename std::enable_if<Count == 4, int>::type = 0>
+        HolonomicChassis(vex::motor_group &leftFront,
+                         vex::motor_group &rightFront,
+                         vex::motor_group &leftBack,
+                         vex::motor_group &rightBack,
+                         vex::inertial &imu,
+                         neblib::PositionTracking *positionTracking)
+            : Chassis(imu, positionTracking),
+              motors{&leftFront, &rightFront, &leftBack, &rightBack},
+              kinematics(neblib::xDriveKinematics())
+        {
+            for (std::size_t i = 0; i < Wheels; i++)
+                addTelemetryGroup(*motors[i]);
+        }
 
-        /// @brief Sets the linear controller for the drivetrain
+        /// @brief Creates a new HDrive object, mixing with neblib::hDriveKinematics()
         ///
-        /// @param linearController pointer to any neblib::FeedbackController
-        void setLinearController(neblib::FeedbackController *linearController);
+        /// @param left reference to a VEX motor group on the left of the drivetrain
+        /// @param right reference to a VEX motor group on the right of the drivetrain
+        /// @param strafe reference to the VEX motor group of the sideways wheel
+        /// @param imu reference to a VEX V5 Inertial sensor
+        /// @param positionTracking pointer to any neblib::PositionTracking object or nullptr
+        template <std::size_t Count = Wheels, typename std::enable_if<Count == 3, int>::type = 0>
+        HolonomicChassis(vex::motor_group &left,
+                         vex::motor_group &right,
+                         vex::motor_group &strafe,
+                         vex::inertial &imu,
+                         neblib::PositionTracking *positionTracking)
+            : Chassis(imu, positionTracking),
+              motors{&left, &right, &strafe},
+              kinematics(neblib::hDriveKinematics())
+        {
+            for (std::size_t i = 0; i < Wheels; i++)
+                addTelemetryGroup(*motors[i]);
+        }
 
-        /// @brief Sets the angular controller for the drivetrain
+        /// @brief Creates a new AsteriskDrive object, mixing with neblib::asteriskKinematics()
         ///
-        /// @param angularController pointer to any neblib::FeedbackController
-        void setAngularController(neblib::FeedbackController *angularController);
+        /// @param leftFront reference to a VEX motor group on the front left of the drivetrain
+        /// @param rightFront reference to a VEX motor group on the front right of the drivetrain
+        /// @param leftBack reference to a VEX motor group on the back left of the drivetrain
+        /// @param rightBack reference to a VEX motor group on the back right of the drivetrain
+        /// @param leftCenter reference to the forward facing VEX motor group on the left
+        /// @param rightCenter reference to the forward facing VEX motor group on the right
+        /// @param imu reference to a VEX V5 Inertial sensor
+        /// @param positionTracking pointer to any neblib::PositionTracking object or nullptr
+        template <std::size_t Count = Wheels, typename std::enable_if<Count == 6, int>::type = 0>
+        HolonomicChassis(vex::motor_group &leftFront,
+                         vex::motor_group &rightFront,
+                         vex::motor_group &leftBack,
+                         vex::motor_group &rightBack,
+                         vex::motor_group &leftCenter,
+                         vex::motor_group &rightCenter,
+                         vex::inertial &imu,
+                         neblib::PositionTracking *positionTracking)
+            : Chassis(imu, positionTracking),
+              motors{&leftFront, &rightFront, &leftBack, &rightBack, &leftCenter, &rightCenter},
+              kinematics(neblib::asteriskKinematics())
+        {
+            for (std::size_t i = 0; i < Wheels; i++)
+                addTelemetryGroup(*motors[i]);
+        }
+
+        /// @brief Sets the wheel mixing matrix, such as neblib::mecanumKinematics() on a four wheel drive
+        ///
+        /// @param kinematics mixing matrix in the same wheel order as the constructor's motor groups
+        void setKinematics(const neblib::HolonomicKinematics<Wheels> &kinematics);
+
+        /// @brief Sends every motor command through an output stage, registering every group with it
+        ///
+        /// @param motorOutput pointer to a neblib::MotorOutput flushed every tick, or nullptr
+        /// @param limits rate limits of each motor group
+        void setMotorOutput(
+            neblib::MotorOutput *motorOutput,
+            neblib::MotorOutput::Limits limits = neblib::MotorOutput::Limits());
 
         /// @brief Drives the robot using forward, side, and turn inputs
         ///
-        /// @param drive 
-        /// @param strafe 
-        /// @param turn 
-        /// @param unit 
+        /// Wheel commands are scaled down together when any exceeds what the
+        /// motors can output, keeping the direction of travel intact.
+        ///
+        /// @param drive forward input
+        /// @param strafe sideways input, right is positive
+        /// @param turn turn input, clockwise is positive
+        /// @param unit velocity unit, pct is limited to 100, rpm and dps are not limited
         void driveLocal(
             double drive,
             double strafe,
             double turn,
             vex::velocityUnits unit);
 
+        /// @brief Drives the robot using forward, side, and turn inputs
+        ///
+        /// Wheel commands are scaled down together when any exceeds 12 volts,
+        /// keeping the direction of travel intact.
+        ///
+        /// @param drive forward input
+        /// @param strafe sideways input, right is positive
+        /// @param turn turn input, clockwise is positive
+        /// @param unit voltage unit
         void driveLocal(
             double drive,
             double strafe,
@@ -77,46 +225,68 @@ namespace neblib
             double turn,
             vex::voltageUnits unit = vex::voltageUnits::volt);
 
-        void driveGlobal(
+        /// @brief Drives the robot in field directions, whatever way it faces
+        ///
+        /// @param x input along the field's x axis, right of the driver is positive
+        /// @param y input along the field's y axis, away from the driver is positive
+        /// @param turn turn input, clockwise is positive
+        /// @param unit velocity unit, pct is limited to 100, rpm and dps are not limited
+        void driveField(
             double x,
             double y,
             double turn,
             vex::velocityUnits unit);
 
-        void driveGlobal(
+        /// @brief Drives the robot in field directions, whatever way it faces
+        ///
+        /// @param x input along the field's x axis, right of the driver is positive
+        /// @param y input along the field's y axis, away from the driver is positive
+        /// @param turn turn input, clockwise is positive
+        /// @param unit voltage unit
+        void driveField(
             double x,
             double y,
             double turn,
             vex::voltageUnits unit = vex::voltageUnits::volt);
 
-        void stop(vex::brakeType brakeType = vex::brakeType::hold);
-
-        int driveToPose(
+        /// @brief Drives the robot in field directions with y toward the driver, prefer driveField()
+        ///
+        /// Keeps its original sign for existing callers, the same as driveField(x, -y, turn, unit).
+        ///
+        /// @param x input along the field's x axis, right of the driver is positive
+        /// @param y input along the field's y axis, toward the driver is positive
+        /// @param turn turn input, clockwise is positive
+        /// @param unit velocity unit, pct is limited to 100, rpm and dps are not limited
+        void driveGlobal(
             double x,
             double y,
-            double heading,
-            int timeout = infinity(),
-            double minOutput = -infinity(),
-            double maxOutput = infinity());
+            double turn,
+            vex::velocityUnits unit);
 
-        int driveTo(
+        /// @brief Drives the robot in field directions with y toward the driver, prefer driveField()
+        ///
+        /// Keeps its original sign for existing callers, the same as driveField(x, -y, turn, unit).
+        ///
+        /// @param x input along the field's x axis, right of the driver is positive
+        /// @param y input along the field's y axis, toward the driver is positive
+        /// @param turn turn input, clockwise is positive
+        /// @param unit voltage unit
+        void driveGlobal(
             double x,
             double y,
-            int timeout = infinity(),
-            double minOutput = -infinity(),
-            double maxOutput = infinity());
-
-        int turnFor(
-            double degrees,
-            int timeout = infinity(),
-            double minOutput = -infinity(),
-            double maxOutput = infinity());
-
-        int turnTo(
-            double heading,
-            int timeout = infinity(),
-            double minOutput = -infinity(),
-            double maxOutput = infinity());
+            double turn,
+            vex::voltageUnits unit = vex::voltageUnits::volt);
+
+        void stop(vex::brakeType brakeType = vex::brakeType::hold);
     };
 
-} // namespace neblib
\ No newline at end of file
+    /// @brief X-drive or mecanum drive with the shared motion algorithms
+    using XDrive = Drivetrain<HolonomicChassis<4>>;
+
+    /// @brief H-drive with the shared motion algorithms
+    using HDrive = Drivetrain<HolonomicChassis<3>>;
+
+    /// @brief Asterisk drive with the shared motion algorithms
+    using AsteriskDrive = Drivetrain<HolonomicChassis<6>>;
+
+} // namespace neblib
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace neblib
+{
+    namespace sim
+    {
+        /// @brief Keeps the compiler from optimizing away a value
+        template <class T>
+        inline void doNotOptimize(const T &value)
+        {
+            asm volatile("" : : "r,m"(value) : "memory");
+        }
+
+        /// @brief Micro-benchmark runner with warm-up and outlier rejection
+        ///
+        /// Each case is a function that runs the code under test a given
+        /// number of times. A case is warmed up, then the iteration count is
+        /// raised until one sample takes at least the sample time, then the
+        /// samples are timed. Samples outside 1.5 interquartile ranges of the
+        /// middle half are dropped before the statistics are taken.
+        ///
+        /// Timing uses the host's steady clock; on x86 the time stamp counter
+        /// is read as well, giving reference cycles per operation.
+        class Benchmark
+        {
+        public:
+            /// @brief Runs the code under test
+            ///
+            /// @param iterations number of times to run it
+            /// @param context pointer given when the case was added
+            typedef void (*Function)(
+                std::uint64_t iterations,
+                void *context);
+
+            /// @brief Statistics of one case, per operation
+            struct Result
+            {
+                const char *name;
+                double median; //< ns
+                double mean; //< ns
+                double min; //< ns
+                double max; //< ns
+                double stddev; //< ns
+                double cycles; //< Reference cycles at the median sample, -1 where unavailable
+                std::uint64_t iterations; //< Operations per sample
+                int samples; //< Samples kept
+                int outliers; //< Samples dropped
+
+                Result();
+            };
+
+        private:
+            struct Case
+            {
+                const char *name;
+                Function function;
+                void *context;
+            };
+
+            std::vector<Case> cases;
+            int sampleCount;
+            double warmupTime; //< s
+            double sampleTime; //< s
+
+            /// @brief Runs one case
+            Result run(const Case &benchmark) const;
+
+        public:
+            /// @brief Creates a new Benchmark
+            ///
+            /// @param sampleCount number of timed samples per case
+            /// @param warmupTime time (s) each case runs before timing
+            /// @param sampleTime smallest time (s) of one sample
+            Benchmark(
+                int sampleCount = 31,
+                double warmupTime = 0.05,
+                double sampleTime = 0.005);
+
+            /// @brief Adds a case
+            ///
+            /// @param name name of the case, must outlive the benchmark
+            /// @param function runs the code under test
+            /// @param context pointer passed to the function
+            void add(
+                const char *name,
+                Function function,
+                void *context = nullptr);
+
+            /// @brief Runs every case whose name contains a filter
+            ///
+            /// @param filter text the name must contain, nullptr or empty for every case
+            /// @return results in the order the cases were added
+            std::vector<Result> runAll(const char *filter = nullptr) const;
+
+            /// @brief Prints results as a table
+            static void print(const std::vector<Result> &results);
+
+            /// @brief Writes results as JSON, one case per line
+            ///
+            /// @param results results to write
+            /// @param fileName file to write
+            /// @return 0 on success, -1 if the file could not be opened
+            static int writeJson(
+                const std::vector<Result> &results,
+                const char *fileName);
+
+            /// @brief Compares results to a file written by writeJson() and prints the change
+            ///
+            /// @param results current results
+            /// @param fileName baseline file
+            /// @param threshold slowdown (%) of the median that counts as a regression
+            /// @return number of regressions, -1 if the file could not be opened
+            static int compare(
+                const std::vector<Result> &results,
+                const char *fileName,
+                double threshold);
+        };
+
+    } // namespace sim
+} // namespace neblib
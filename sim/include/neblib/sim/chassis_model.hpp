@@ -0,0 +1,280 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include "neblib/random.hpp"
+#include "neblib/sim/ports.hpp"
+
+namespace neblib
+{
+    namespace sim
+    {
+        /// @brief Planar rigid-body model of a robot driven by motorized wheels
+        ///
+        /// Uses the same frame as neblib::Odometry: x to the right, y
+        /// forward, heading in degrees clockwise from +y. Geometry is in
+        /// inches; mass and inertia are in SI units.
+        ///
+        /// Each wheel pushes along its rolling direction with the torque of
+        /// its motors and rolls freely across it. Differential chassis also
+        /// grip sideways, so they cannot slide.
+        class ChassisModel
+        {
+        public:
+            /// @brief Mass and friction of the robot
+            ///
+            /// mass: mass (kg)
+            /// inertia: moment of inertia (kg*m^2) about the center
+            /// rollingResistance: resisting force as a fraction of weight
+            /// linearDamping: resisting force (N) per m/s of speed
+            /// angularDamping: resisting torque (N*m) per rad/s of turn rate
+            struct Body
+            {
+                double mass;
+                double inertia;
+                double rollingResistance;
+                double linearDamping;
+                double angularDamping;
+
+                /// @brief Creates a new Body object, defaults to a 15 lb, 15 in square robot
+                Body(
+                    double mass = 6.8,
+                    double inertia = 0.17,
+                    double rollingResistance = 0.03,
+                    double linearDamping = 2.0,
+                    double angularDamping = 0.05);
+            };
+
+            /// @brief Powered wheel
+            ///
+            /// x, y: position (in) relative to the center
+            /// angle: rolling direction (deg) clockwise from forward
+            /// diameter: wheel diameter (in)
+            /// gearRatio: wheel turns per motor shaft turn
+            /// ports: smart ports of the motors turning the wheel
+            struct Wheel
+            {
+                double x;
+                double y;
+                double angle;
+                double diameter;
+                double gearRatio;
+                std::vector<int> ports;
+
+                /// @brief Creates a new Wheel object
+                Wheel(
+                    double x,
+                    double y,
+                    double angle,
+                    double diameter,
+                    double gearRatio,
+                    std::initializer_list<int> ports);
+            };
+
+            /// @brief Unpowered tracking wheel read by a rotation sensor
+            ///
+            /// x, y: position (in) relative to the center
+            /// angle: rolling direction (deg) clockwise from forward
+            /// diameter: wheel diameter (in)
+            /// port: smart port of the rotation sensor
+            struct Tracker
+            {
+                double x;
+                double y;
+                double angle;
+                double diameter;
+                int port;
+
+                /// @brief Creates a new Tracker object
+                Tracker(
+                    double x,
+                    double y,
+                    double angle,
+                    double diameter,
+                    int port);
+            };
+
+            /// @brief Position and velocity of the robot
+            ///
+            /// x, y: position (in)
+            /// heading: heading (deg) clockwise from +y, not wrapped
+            /// xVelocity, yVelocity: velocity (in/s)
+            /// angularVelocity: turn rate (deg/s) clockwise
+            struct State
+            {
+                double x;
+                double y;
+                double heading;
+                double xVelocity;
+                double yVelocity;
+                double angularVelocity;
+
+                State();
+            };
+
+            /// @brief Standard deviations of the errors of a real robot, all zero by default
+            ///
+            /// Drawn once per run, see setNoise():
+            /// traction: fraction of each wheel's force lost to slip
+            /// trackerScale: fractional error of each tracking wheel's diameter
+            /// imuScale: fractional error of the gyro's turn rate
+            /// imuDrift: gyro bias (deg/s)
+            ///
+            /// Drawn every step:
+            /// trackerSlip: fractional error of the distance each tracking wheel rolls
+            /// imuNoise: error (deg/s) of the gyro's turn rate
+            struct Noise
+            {
+                double traction;
+                double trackerScale;
+                double imuScale;
+                double imuDrift;
+                double trackerSlip;
+                double imuNoise;
+
+                /// @brief Creates a new Noise object
+                Noise(
+                    double traction = 0.0,
+                    double trackerScale = 0.0,
+                    double imuScale = 0.0,
+                    double imuDrift = 0.0,
+                    double trackerSlip = 0.0,
+                    double imuNoise = 0.0);
+            };
+
+        private:
+            Body body;
+            bool lateralGrip; //< True when the robot cannot slide sideways
+            std::vector<Wheel> wheels;
+            std::vector<Tracker> trackers;
+            int imuPort; //< -1 without an inertial sensor
+
+            // ---------- State, SI ----------
+            double x;
+            double y;
+            double theta; //< Heading (rad) clockwise from +y
+            double xVelocity;
+            double yVelocity;
+            double omega; //< Turn rate (rad/s) clockwise
+
+            // ---------- Noise ----------
+            Noise noise;
+            neblib::Random random;
+            std::vector<double> wheelTraction; //< Fraction of force each wheel keeps
+            std::vector<double> trackerScale; //< Distance each tracker reports per distance rolled
+            double imuScale;
+            double imuBias; //< deg/s
+
+            /// @brief Rolling speed (m/s) of a point moving in a direction, from the body velocity
+            double pointSpeed(
+                double forward,
+                double right,
+                double px,
+                double py,
+                double angle) const;
+
+        public:
+            /// @brief Creates a new ChassisModel without wheels
+            ///
+            /// @param body mass and friction of the robot
+            /// @param lateralGrip true when the robot cannot slide sideways
+            ChassisModel(
+                Body body = Body(),
+                bool lateralGrip = false);
+
+            /// @brief Differential (tank) chassis with one wheel on each side
+            ///
+            /// @param leftPorts motors on the left side
+            /// @param rightPorts motors on the right side
+            /// @param trackWidth distance (in) between the left and right wheels
+            /// @param wheelDiameter wheel diameter (in)
+            /// @param gearRatio wheel turns per motor shaft turn
+            /// @param body mass and friction of the robot
+            static ChassisModel differential(
+                std::initializer_list<int> leftPorts,
+                std::initializer_list<int> rightPorts,
+                double trackWidth,
+                double wheelDiameter,
+                double gearRatio = 1.0,
+                Body body = Body());
+
+            /// @brief X-drive chassis with omni wheels at 45 degrees in each corner
+            ///
+            /// Wheel directions match neblib::xDriveKinematics(), so positive
+            /// voltage on every wheel drives forward.
+            ///
+            /// @param leftFrontPorts motors on the front left wheel
+            /// @param rightFrontPorts motors on the front right wheel
+            /// @param leftBackPorts motors on the back left wheel
+            /// @param rightBackPorts motors on the back right wheel
+            /// @param width distance (in) between the left and right wheels
+            /// @param length distance (in) between the front and back wheels
+            /// @param wheelDiameter wheel diameter (in)
+            /// @param gearRatio wheel turns per motor shaft turn
+            /// @param body mass and friction of the robot
+            static ChassisModel xDrive(
+                std::initializer_list<int> leftFrontPorts,
+                std::initializer_list<int> rightFrontPorts,
+                std::initializer_list<int> leftBackPorts,
+                std::initializer_list<int> rightBackPorts,
+                double width,
+                double length,
+                double wheelDiameter,
+                double gearRatio = 1.0,
+                Body body = Body());
+
+            /// @brief Adds a powered wheel
+            void addWheel(const Wheel &wheel);
+
+            /// @brief Adds a tracking wheel
+            void addTracker(const Tracker &tracker);
+
+            /// @brief Mounts an inertial sensor
+            /// @param port smart port of the sensor
+            void setImu(int port);
+
+            /// @brief Places the robot at rest
+            ///
+            /// @param x position (in)
+            /// @param y position (in)
+            /// @param heading heading (deg) clockwise from +y
+            void setPose(
+                double x,
+                double y,
+                double heading);
+
+            /// @brief Gets the position and velocity of the robot
+            State getState() const;
+
+            /// @brief Adds random errors to the wheels and sensors
+            ///
+            /// Call after adding every wheel and tracker. The same seed gives
+            /// the same errors, so a run can be repeated.
+            ///
+            /// @param noise standard deviations of the errors
+            /// @param seed seed of the random errors
+            void setNoise(
+                const Noise &noise,
+                std::uint32_t seed);
+
+            /// @brief Marks every motor of a wheel as turned by the chassis
+            /// @param ports ports of the simulated brain
+            void attach(neblib::sim::Ports &ports) const;
+
+            /// @brief Moves the robot forward one time step
+            ///
+            /// Updates the motors of every wheel, then the body, then the
+            /// tracking wheels and inertial sensor.
+            ///
+            /// @param dt time step (s)
+            /// @param supplyVoltage battery voltage (V)
+            /// @param ports ports of the simulated brain
+            void step(
+                double dt,
+                double supplyVoltage,
+                neblib::sim::Ports &ports);
+        };
+
+    } // namespace sim
+} // namespace neblib
@@ -0,0 +1,91 @@
+#pragma once
+
+namespace neblib
+{
+    namespace sim
+    {
+        /// @brief Brushed DC motor model, measured at the output shaft of the gear cartridge
+        ///
+        /// Current follows (V - ke * speed) / R, limited to the current
+        /// limit, and torque is kt * current less a friction torque.
+        /// Inductance and rotor inertia are ignored; the load carries the inertia.
+        class MotorModel
+        {
+        public:
+            /// @brief Motor characteristics at the nominal voltage
+            ///
+            /// stallTorque: torque (N*m) at zero speed
+            /// freeSpeed: speed (rpm) with no load
+            /// stallCurrent: current (A) at zero speed
+            /// currentLimit: largest current (A) the motor draws
+            /// nominalVoltage: voltage (V) the other values are measured at
+            /// frictionTorque: torque (N*m) lost to friction while turning
+            struct Parameters
+            {
+                double stallTorque;
+                double freeSpeed;
+                double stallCurrent;
+                double currentLimit;
+                double nominalVoltage;
+                double frictionTorque;
+
+                /// @brief Creates a new Parameters object
+                Parameters(
+                    double stallTorque,
+                    double freeSpeed,
+                    double stallCurrent,
+                    double currentLimit,
+                    double nominalVoltage = 12.0,
+                    double frictionTorque = 0.0);
+
+                /// @brief V5 Smart Motor with a gear cartridge
+                ///
+                /// @param freeSpeed free speed (rpm) of the cartridge, 100, 200 or 600
+                /// @return 11 W motor with a 2.5 A current limit
+                static Parameters v5(double freeSpeed = 200.0);
+            };
+
+        private:
+            Parameters parameters;
+            double resistance; //< Ohms
+            double torqueConstant; //< N*m per A
+            double backEmfConstant; //< V per rad/s
+
+        public:
+            /// @brief Creates a new MotorModel
+            /// @param parameters motor characteristics
+            MotorModel(Parameters parameters = Parameters::v5());
+
+            /// @brief Gets the motor characteristics
+            const Parameters &getParameters() const;
+
+            /// @brief Gets the free speed in rad/s
+            double freeSpeed() const;
+
+            /// @brief Current drawn with a voltage across the motor
+            ///
+            /// @param voltage applied voltage (V)
+            /// @param speed shaft speed (rad/s)
+            /// @return current (A), within the current limit
+            double current(
+                double voltage,
+                double speed) const;
+
+            /// @brief Current drawn with the windings shorted, used by brake mode
+            ///
+            /// @param speed shaft speed (rad/s)
+            /// @return current (A), within the current limit
+            double shortedCurrent(double speed) const;
+
+            /// @brief Torque produced by a current, less friction
+            ///
+            /// @param current current (A)
+            /// @param speed shaft speed (rad/s), friction opposes it
+            /// @return torque (N*m)
+            double torque(
+                double current,
+                double speed) const;
+        };
+
+    } // namespace sim
+} // namespace neblib
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include "neblib/sim/motor_model.hpp"
+
+namespace neblib
+{
+    namespace sim
+    {
+        /// @brief State of a smart port with a motor plugged in
+        ///
+        /// Positions and speeds are in the motor's commanded direction, as
+        /// if every vex::motor was built with the right reversed flag.
+        struct MotorPort
+        {
+            /// @brief What the motor was last told to do
+            enum Mode
+            {
+                Coast,
+                Brake,
+                Hold,
+                Voltage,
+                Velocity
+            };
+
+            bool connected;
+            bool attached; //< True when a chassis model turns the shaft
+            neblib::sim::MotorModel model;
+            Mode mode;
+            double command; //< Voltage (V) in Voltage mode, speed (rpm) in Velocity mode
+            double holdPosition; //< Shaft position (deg) held in Hold mode
+            double position; //< Shaft position (deg)
+            double positionOffset; //< Added to position when read through vex::motor
+            double speed; //< Shaft speed (rad/s)
+            double voltage; //< Voltage (V) across the motor at the last step
+            double current; //< Current (A) at the last step
+            double torque; //< Torque (N*m) at the last step
+            double loadInertia; //< Inertia (kg*m^2) turned by the shaft when no chassis is attached
+
+            MotorPort();
+
+            /// @brief Applies the control mode and finds the torque at the current speed
+            /// @param supplyVoltage battery voltage (V) available to the motor
+            void update(double supplyVoltage);
+
+            /// @brief Turns a shaft that no chassis is attached to
+            /// @param dt time step (s)
+            void integrate(double dt);
+        };
+
+        /// @brief State of a smart port with a rotation sensor plugged in
+        struct RotationPort
+        {
+            bool connected;
+            double position; //< Position (deg) since the start of the simulation
+            double offset; //< Added to position when read through vex::rotation
+            double speed; //< Speed (deg/s)
+
+            RotationPort();
+        };
+
+        /// @brief State of a smart port with an inertial sensor plugged in
+        struct InertialPort
+        {
+            bool connected;
+            double rotation; //< Rotation (deg, clockwise) since the start of the simulation
+            double rate; //< Turn rate (deg/s, clockwise)
+            double headingOffset; //< Added to rotation to get heading
+            double rotationOffset; //< Added to rotation when read through vex::inertial
+            std::uint64_t calibrationEnd; //< Simulated time (us) calibration finishes
+
+            InertialPort();
+        };
+
+        /// @brief Every port of a simulated brain
+        struct Ports
+        {
+            static constexpr int count = 21;
+            static constexpr int threeWireCount = 8;
+
+            MotorPort motors[count];
+            RotationPort rotations[count];
+            InertialPort inertials[count];
+            bool threeWire[threeWireCount];
+
+            Ports();
+        };
+
+    } // namespace sim
+} // namespace neblib
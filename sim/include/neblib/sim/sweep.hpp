@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "neblib/sim/thread_pool.hpp"
+
+namespace neblib
+{
+    namespace sim
+    {
+        /// @brief Monte Carlo runner: repeats a simulated routine under random errors
+        ///
+        /// Every run gets its own neblib::sim::World, current on the pool
+        /// thread running it, and a seed derived from the sweep's seed and
+        /// the run's index. A run that draws its errors only from its seed
+        /// gives the same result on any number of threads.
+        class Sweep
+        {
+        public:
+            /// @brief Outcome of one run
+            struct Run
+            {
+                std::uint32_t seed;
+                bool success;
+                double time; //< Time (ms) the routine took
+                double positionError; //< Distance (in) from where the routine should end
+                double headingError; //< Difference (deg) from the heading the routine should end at
+
+                Run();
+            };
+
+            /// @brief Runs the routine once in the current world
+            ///
+            /// @param seed seed for every random error of the run
+            /// @param run set to the outcome, seed is already filled in
+            /// @param context pointer given to run()
+            typedef void (*Function)(
+                std::uint32_t seed,
+                Run &run,
+                void *context);
+
+            /// @brief Spread of one measurement over the runs
+            struct Distribution
+            {
+                double mean;
+                double stddev;
+                double min;
+                double median;
+                double p90;
+                double p99;
+                double max;
+
+                Distribution();
+            };
+
+            /// @brief Statistics of a sweep
+            struct Summary
+            {
+                std::size_t runs;
+                std::size_t successes;
+                double successRate; //< Fraction of runs that succeeded
+                Distribution time; //< ms
+                Distribution positionError; //< in
+                Distribution headingError; //< deg
+
+                Summary();
+            };
+
+        private:
+            ThreadPool pool;
+            std::atomic<std::size_t> leakedWorlds; //< Worlds left allocated because a task never returned
+
+            struct Job
+            {
+                Sweep *sweep;
+                Function function;
+                void *context;
+                std::uint32_t seed;
+                std::vector<Run> *runs;
+            };
+
+            static void runOne(
+                std::size_t index,
+                void *context);
+
+        public:
+            /// @brief Creates a new Sweep
+            ///
+            /// @param threadCount number of threads, 0 for one per host core
+            Sweep(int threadCount = 0);
+
+            /// @brief Gets the number of threads
+            int threads() const;
+
+            /// @brief Gets the number of worlds that could not be freed, see neblib::sim::World::destroy()
+            std::size_t getLeakedWorlds() const;
+
+            /// @brief Derives the seed of one run
+            ///
+            /// @param seed seed of the sweep
+            /// @param index index of the run
+            static std::uint32_t runSeed(
+                std::uint32_t seed,
+                std::size_t index);
+
+            /// @brief Runs the routine many times, spread over the pool
+            ///
+            /// @param count number of runs
+            /// @param seed seed of the sweep
+            /// @param function runs the routine once
+            /// @param context pointer passed to the function
+            /// @return outcome of every run, in index order
+            std::vector<Run> run(
+                std::size_t count,
+                std::uint32_t seed,
+                Function function,
+                void *context = nullptr);
+
+            /// @brief Computes the statistics of a sweep
+            static Summary summarize(const std::vector<Run> &runs);
+
+            /// @brief Prints the statistics of a sweep
+            static void print(const Summary &summary);
+
+            /// @brief Writes every run as CSV
+            ///
+            /// @param runs outcome of every run
+            /// @param fileName file to write
+            /// @return 0 on success, -1 if the file could not be opened
+            static int writeCsv(
+                const std::vector<Run> &runs,
+                const char *fileName);
+        };
+
+    } // namespace sim
+} // namespace neblib
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace neblib
+{
+    namespace sim
+    {
+        /// @brief Work-stealing pool of host threads for running many independent jobs
+        ///
+        /// run() splits the job indices into a contiguous block per thread.
+        /// A thread takes jobs from the back of its own queue; once that is
+        /// empty it steals from the front of another thread's queue, so
+        /// threads that draw short jobs help the ones that drew long jobs.
+        class ThreadPool
+        {
+        public:
+            /// @brief Runs one job
+            ///
+            /// @param index index of the job, 0 to count - 1
+            /// @param context pointer given to run()
+            typedef void (*Function)(
+                std::size_t index,
+                void *context);
+
+        private:
+            /// @brief Thread and its queue of job indices
+            struct Worker
+            {
+                std::mutex lock;
+                std::deque<std::size_t> jobs;
+                std::thread thread;
+            };
+
+            std::vector<Worker *> workers;
+            std::mutex lock;
+            std::condition_variable wake; //< Signals workers that jobs were queued or the pool is stopping
+            std::condition_variable done; //< Signals run() that the last job finished
+            Function function;
+            void *context;
+            std::uint64_t generation; //< Number of calls to run(), so workers can tell new jobs from old
+            std::size_t remaining; //< Jobs of the current run() not yet finished
+            bool stopping;
+
+            /// @brief Takes a job from a worker's own queue, or steals one from another worker
+            ///
+            /// @param self index of the worker
+            /// @param job set to the job index
+            /// @return true if a job was taken
+            bool take(
+                std::size_t self,
+                std::size_t &job);
+
+            static void work(
+                ThreadPool *pool,
+                std::size_t self);
+
+        public:
+            /// @brief Creates a new ThreadPool and starts its threads
+            ///
+            /// @param threadCount number of threads, 0 for one per host core
+            ThreadPool(int threadCount = 0);
+
+            /// @brief Stops and joins every thread
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool &) = delete;
+            ThreadPool &operator=(const ThreadPool &) = delete;
+
+            /// @brief Gets the number of threads
+            int size() const;
+
+            /// @brief Runs a function for every index from 0 to count - 1, returning once all have finished
+            ///
+            /// @param count number of jobs
+            /// @param function runs one job, called from the pool's threads
+            /// @param context pointer passed to the function
+            void run(
+                std::size_t count,
+                Function function,
+                void *context = nullptr);
+        };
+
+    } // namespace sim
+} // namespace neblib
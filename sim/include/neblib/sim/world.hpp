@@ -0,0 +1,252 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "neblib/sim/chassis_model.hpp"
+#include "neblib/sim/ports.hpp"
+
+namespace neblib
+{
+    namespace sim
+    {
+        /// @brief Simulated V5 brain: clock, task scheduler, ports and physics
+        ///
+        /// Tasks are host threads, but only one runs at a time, like the
+        /// single core on the brain. A task runs until it sleeps or yields;
+        /// then the task with the earliest wake time runs next, by priority
+        /// and then in turn. When every task is asleep the clock jumps to
+        /// the next wake time, stepping the physics on the way, so the
+        /// simulation runs as fast as the host allows and gives the same
+        /// result every run.
+        ///
+        /// Simulated time only passes while tasks sleep, so code measuring
+        /// its own run time sees zero.
+        ///
+        /// Several worlds can run at once on different host threads, see
+        /// create(). Each host thread and every task it starts sees only
+        /// its own world through get().
+        class World
+        {
+        public:
+            /// @brief Called after every physics step
+            ///
+            /// @param world the simulated brain
+            /// @param context pointer given with the observer
+            typedef void (*StepObserver)(
+                World &world,
+                void *context);
+
+            /// @brief Battery model with internal resistance
+            ///
+            /// openCircuitVoltage: voltage (V) with no load
+            /// internalResistance: voltage drop (V) per amp drawn
+            struct Battery
+            {
+                double openCircuitVoltage;
+                double internalResistance;
+
+                /// @brief Creates a new Battery object, defaults to a charged V5 battery
+                Battery(
+                    double openCircuitVoltage = 12.8,
+                    double internalResistance = 0.06);
+            };
+
+            /// @brief Controller inputs, set by the simulation program
+            struct ControllerState
+            {
+                double axes[4]; //< Axis1 to Axis4, -100 to 100
+                bool buttons[12]; //< In vex::controller member order, L1 first and A last
+
+                ControllerState();
+            };
+
+        private:
+            /// @brief A simulated vex::task
+            struct Task
+            {
+                int id;
+                int priority;
+                std::uint64_t wakeTime; //< Simulated time (us) the task can run again
+                std::uint64_t turn; //< Order tasks with the same wake time and priority take turns in
+                bool finished; //< True once the task returned or was stopped
+                bool returned; //< True once the task function returned and its thread can be joined
+                std::condition_variable resume;
+                std::thread thread;
+
+                Task(
+                    int id,
+                    int priority,
+                    std::uint64_t wakeTime,
+                    std::uint64_t turn);
+            };
+
+            // ---------- Scheduler ----------
+            std::mutex lock;
+            std::vector<Task *> tasks;
+            int current; //< Id of the task holding the brain
+            std::uint64_t nextTurn;
+
+            // ---------- Clock ----------
+            std::uint64_t now; //< Simulated time (us)
+            std::uint64_t stepSize; //< Physics step (us)
+            std::chrono::steady_clock::time_point wallStart;
+
+            // ---------- Hardware ----------
+            neblib::sim::Ports ports;
+            neblib::sim::ChassisModel *chassis;
+            Battery battery;
+            double batteryVoltage; //< Voltage (V) under the load of the last step
+            ControllerState controllers[2];
+            bool touching;
+            int touchX;
+            int touchY;
+
+            // ---------- Observation ----------
+            StepObserver stepObserver;
+            void *stepContext;
+
+            World();
+
+            /// @brief Hands the brain to the next task, stepping physics up to its wake time
+            ///
+            /// Called with the lock held by a task that just slept or finished.
+            void dispatch();
+
+            /// @brief Blocks the calling task until it holds the brain again
+            void waitForTurn(
+                std::unique_lock<std::mutex> &guard,
+                Task &self);
+
+            /// @brief Steps physics from now to a later time
+            void advance(std::uint64_t time);
+
+            /// @brief Steps motors, chassis and sensors once
+            void step(double dt);
+
+            static void runTask(
+                World *world,
+                int id,
+                int (*callback)(void *),
+                void *arg);
+
+        public:
+            /// @brief Gets the simulated brain of the calling thread
+            ///
+            /// Without a world made current with makeCurrent(), this is the
+            /// default world; the first thread to call this becomes its main task.
+            static World &get();
+
+            /// @brief Creates a new, independent world
+            ///
+            /// @return the world, free it with destroy()
+            static World *create();
+
+            /// @brief Makes the calling thread the main task of a world
+            ///
+            /// Tasks started from the thread run in the same world.
+            ///
+            /// @param world world from create(), nullptr for the default world
+            static void makeCurrent(World *world);
+
+            /// @brief Frees a world from create() once every task but the main task has returned
+            ///
+            /// A world with a task still sleeping, or stopped by another task,
+            /// is left allocated so that task's thread never sees freed memory.
+            ///
+            /// @param world world from create(), must not be current on any thread
+            /// @return true if the world was freed
+            static bool destroy(World *world);
+
+            // ---------- Scheduler ----------
+
+            /// @brief Starts a task, it first runs when the calling task sleeps
+            ///
+            /// @param callback task function
+            /// @param arg argument passed to the task function
+            /// @param priority vex::task priority
+            /// @return id of the task
+            int createTask(
+                int (*callback)(void *),
+                void *arg,
+                int priority);
+
+            /// @brief Stops a task, it never runs again
+            /// @param id id of the task
+            void stopTask(int id);
+
+            /// @brief Suspends the calling task until a simulated time
+            /// @param time simulated time (us)
+            void sleepUntil(std::uint64_t time);
+
+            /// @brief Gets the id of the calling task
+            int currentTask() const;
+
+            // ---------- Clock ----------
+
+            /// @brief Gets the simulated time (us)
+            std::uint64_t time() const;
+
+            /// @brief Gets the simulated time passed per unit of wall time since the simulation started
+            double realTimeFactor() const;
+
+            /// @brief Sets the physics step
+            /// @param stepSize physics step (us), 1000 by default
+            void setStepSize(std::uint64_t stepSize);
+
+            /// @brief Sets a function called after every physics step, used to record the simulation
+            ///
+            /// @param observer function to call, nullptr for none
+            /// @param context pointer passed to the function
+            void setStepObserver(
+                StepObserver observer,
+                void *context = nullptr);
+
+            // ---------- Hardware ----------
+
+            /// @brief Gets the ports of the brain
+            neblib::sim::Ports &getPorts();
+
+            /// @brief Sets the chassis moved by the motors, nullptr for none
+            ///
+            /// @param chassis chassis model, must outlive the simulation
+            void setChassis(neblib::sim::ChassisModel *chassis);
+
+            /// @brief Gets the chassis model, nullptr without one
+            neblib::sim::ChassisModel *getChassis();
+
+            /// @brief Sets the battery model
+            void setBattery(Battery battery);
+
+            /// @brief Gets the battery voltage (V) under the load of the last step
+            double getBatteryVoltage() const;
+
+            /// @brief Gets the inputs of a controller
+            /// @param index 0 for the primary controller, 1 for the partner controller
+            ControllerState &getController(int index);
+
+            /// @brief Sets where the screen is touched
+            ///
+            /// @param touching true while the screen is touched
+            /// @param x touch x position (px)
+            /// @param y touch y position (px)
+            void setTouch(
+                bool touching,
+                int x = 0,
+                int y = 0);
+
+            /// @brief True while the screen is touched
+            bool isTouching() const;
+
+            /// @brief Touch x position (px)
+            int getTouchX() const;
+
+            /// @brief Touch y position (px)
+            int getTouchY() const;
+        };
+
+    } // namespace sim
+} // namespace neblib
@@ -0,0 +1,641 @@
+#pragma once
+
+// Host stand-in for the parts of the VEX V5 API used by neblib.
+//
+// Devices read and write the ports of neblib::sim::World, which runs
+// tasks one at a time on a simulated clock and moves the robot with
+// the chassis model registered to it. Screen and controller screen
+// drawing is accepted and dropped.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace vex
+{
+    // ---------- Units ----------
+    enum class percentUnits
+    {
+        pct
+    };
+
+    enum class velocityUnits
+    {
+        pct,
+        rpm,
+        dps
+    };
+
+    enum class voltageUnits
+    {
+        volt,
+        mV
+    };
+
+    enum class rotationUnits
+    {
+        deg,
+        rev,
+        raw
+    };
+
+    enum class timeUnits
+    {
+        sec,
+        msec
+    };
+
+    enum class currentUnits
+    {
+        amp
+    };
+
+    enum class torqueUnits
+    {
+        Nm,
+        InLb
+    };
+
+    enum class directionType
+    {
+        fwd,
+        rev,
+        undefined
+    };
+
+    enum class brakeType
+    {
+        coast,
+        brake,
+        hold,
+        undefined
+    };
+
+    enum class turnType
+    {
+        left,
+        right
+    };
+
+    enum class gearSetting
+    {
+        ratio36_1,
+        ratio18_1,
+        ratio6_1
+    };
+
+    enum class controllerType
+    {
+        primary,
+        partner
+    };
+
+    const percentUnits percent = percentUnits::pct;
+    const velocityUnits rpm = velocityUnits::rpm;
+    const velocityUnits dps = velocityUnits::dps;
+    const voltageUnits volt = voltageUnits::volt;
+    const voltageUnits mV = voltageUnits::mV;
+    const rotationUnits degrees = rotationUnits::deg;
+    const rotationUnits turns = rotationUnits::rev;
+    const timeUnits seconds = timeUnits::sec;
+    const timeUnits msec = timeUnits::msec;
+    const timeUnits sec = timeUnits::sec;
+    const directionType forward = directionType::fwd;
+    const directionType reverse = directionType::rev;
+    const directionType fwd = directionType::fwd;
+    const brakeType coast = brakeType::coast;
+    const brakeType brake = brakeType::brake;
+    const brakeType hold = brakeType::hold;
+    const turnType left = turnType::left;
+    const turnType right = turnType::right;
+    const gearSetting ratio36_1 = gearSetting::ratio36_1;
+    const gearSetting ratio18_1 = gearSetting::ratio18_1;
+    const gearSetting ratio6_1 = gearSetting::ratio6_1;
+    const controllerType primary = controllerType::primary;
+    const controllerType partner = controllerType::partner;
+
+    enum
+    {
+        PORT1 = 0,
+        PORT2,
+        PORT3,
+        PORT4,
+        PORT5,
+        PORT6,
+        PORT7,
+        PORT8,
+        PORT9,
+        PORT10,
+        PORT11,
+        PORT12,
+        PORT13,
+        PORT14,
+        PORT15,
+        PORT16,
+        PORT17,
+        PORT18,
+        PORT19,
+        PORT20,
+        PORT21
+    };
+
+    // ---------- Color ----------
+    class color
+    {
+    private:
+        std::uint32_t value;
+
+    public:
+        color();
+        color(int value);
+        color(
+            int red,
+            int green,
+            int blue);
+
+        std::uint32_t rgb() const;
+
+        bool operator==(const color &other) const;
+        bool operator!=(const color &other) const;
+
+        static const color black;
+        static const color white;
+        static const color red;
+        static const color green;
+        static const color blue;
+        static const color yellow;
+        static const color orange;
+        static const color purple;
+        static const color cyan;
+        static const color transparent;
+    };
+
+    // ---------- Timing ----------
+    class timer
+    {
+    private:
+        std::uint64_t start;
+
+    public:
+        timer();
+
+        /// @brief Time (ms or s) since the timer was created or cleared
+        double time(timeUnits units = timeUnits::msec) const;
+        double value() const;
+        void clear();
+        void reset();
+
+        /// @brief Simulated time (ms) since the program started
+        static std::uint32_t system();
+
+        /// @brief Simulated time (us) since the program started
+        static std::uint64_t systemHighResolution();
+    };
+
+    class task
+    {
+    private:
+        int id;
+
+    public:
+        static const int taskPriorityLow = 1;
+        static const int taskPriorityNormal = 7;
+        static const int taskPriorityHigh = 15;
+
+        task();
+        task(
+            int (*callback)(void *),
+            void *arg,
+            std::int32_t priority = taskPriorityNormal);
+        task(
+            int (*callback)(void *),
+            void *arg);
+        task(
+            int (*callback)(),
+            std::int32_t priority = taskPriorityNormal);
+
+        /// @brief Stops the task, it never runs again
+        void stop();
+
+        /// @brief Suspends the calling task for a length of simulated time
+        static void sleep(std::uint32_t time);
+
+        /// @brief Lets other tasks run, advancing simulated time by 1 ms
+        ///
+        /// Yielding without advancing time would spin forever when every
+        /// other task is asleep.
+        static void yield();
+    };
+
+    class mutex
+    {
+    private:
+        bool locked;
+
+    public:
+        mutex();
+        void lock();
+        bool try_lock();
+        void unlock();
+    };
+
+    namespace this_thread
+    {
+        std::int32_t get_id();
+        void sleep_for(std::uint32_t time);
+        void yield();
+    } // namespace this_thread
+
+    void wait(
+        double time,
+        timeUnits units = timeUnits::msec);
+
+    // ---------- Smart Devices ----------
+    class motor
+    {
+    private:
+        std::int32_t port;
+        gearSetting gears;
+        bool reversed;
+
+    public:
+        motor(std::int32_t port);
+        motor(
+            std::int32_t port,
+            bool reversed);
+        motor(
+            std::int32_t port,
+            gearSetting gears,
+            bool reversed = false);
+
+        std::int32_t index() const;
+        bool installed() const;
+        void setReversed(bool reversed);
+
+        void spin(directionType direction);
+        void spin(
+            directionType direction,
+            double velocity,
+            velocityUnits units);
+        void spin(
+            directionType direction,
+            double velocity,
+            percentUnits units);
+        void spin(
+            directionType direction,
+            double voltage,
+            voltageUnits units);
+        void stop();
+        void stop(brakeType mode);
+        void setBrake(brakeType mode);
+        void setVelocity(
+            double velocity,
+            velocityUnits units);
+        void setVelocity(
+            double velocity,
+            percentUnits units);
+
+        double position(rotationUnits units) const;
+        void setPosition(
+            double value,
+            rotationUnits units);
+        void resetPosition();
+        double velocity(velocityUnits units) const;
+        double velocity(percentUnits units) const;
+        double voltage(voltageUnits units = voltageUnits::volt) const;
+        double current(currentUnits units = currentUnits::amp) const;
+        double torque(torqueUnits units = torqueUnits::Nm) const;
+    };
+
+    class motor_group
+    {
+    private:
+        std::vector<motor> motors;
+
+        void add() {}
+
+        template <class... Args>
+        void add(
+            const motor &first,
+            const Args &...rest)
+        {
+            motors.push_back(first);
+            add(rest...);
+        }
+
+    public:
+        motor_group() {}
+
+        template <class... Args>
+        motor_group(
+            const motor &first,
+            const Args &...rest)
+        {
+            add(first, rest...);
+        }
+
+        std::int32_t count() const;
+
+        void spin(directionType direction);
+        void spin(
+            directionType direction,
+            double velocity,
+            velocityUnits units);
+        void spin(
+            directionType direction,
+            double velocity,
+            percentUnits units);
+        void spin(
+            directionType direction,
+            double voltage,
+            voltageUnits units);
+        void stop();
+        void stop(brakeType mode);
+        void setStopping(brakeType mode);
+        void setVelocity(
+            double velocity,
+            velocityUnits units);
+        void setVelocity(
+            double velocity,
+            percentUnits units);
+
+        double position(rotationUnits units) const;
+        void setPosition(
+            double value,
+            rotationUnits units);
+        void resetPosition();
+        double velocity(velocityUnits units) const;
+        double velocity(percentUnits units) const;
+        double voltage(voltageUnits units = voltageUnits::volt) const;
+        double current(currentUnits units = currentUnits::amp) const;
+    };
+
+    class inertial
+    {
+    private:
+        std::int32_t port;
+        double direction; //< 1 when clockwise is positive, -1 when counterclockwise is
+
+    public:
+        inertial(
+            std::int32_t port,
+            turnType direction = turnType::right);
+
+        bool installed() const;
+        void calibrate();
+        void startCalibration();
+        bool isCalibrating() const;
+
+        double heading(rotationUnits units = rotationUnits::deg) const;
+        double rotation(rotationUnits units = rotationUnits::deg) const;
+        void setHeading(
+            double value,
+            rotationUnits units);
+        void setRotation(
+            double value,
+            rotationUnits units);
+        void resetHeading();
+        void resetRotation();
+        double gyroRate(
+            int axis,
+            velocityUnits units = velocityUnits::dps) const;
+    };
+
+    class rotation
+    {
+    private:
+        std::int32_t port;
+
+    public:
+        rotation(
+            std::int32_t port,
+            bool reversed = false);
+
+        bool installed() const;
+        double position(rotationUnits units) const;
+        double angle(rotationUnits units = rotationUnits::deg) const;
+        double velocity(velocityUnits units) const;
+        void setPosition(
+            double value,
+            rotationUnits units);
+        void resetPosition();
+    };
+
+    // ---------- Three Wire Ports ----------
+    class triport
+    {
+    public:
+        class port
+        {
+        private:
+            std::int32_t index;
+
+        public:
+            explicit port(std::int32_t index);
+            std::int32_t getIndex() const;
+        };
+
+        port A;
+        port B;
+        port C;
+        port D;
+        port E;
+        port F;
+        port G;
+        port H;
+
+        triport();
+    };
+
+    class digital_out
+    {
+    private:
+        std::int32_t port;
+
+    public:
+        digital_out(triport::port &port);
+        void set(bool value);
+        std::int32_t value() const;
+    };
+
+    class led
+    {
+    private:
+        std::int32_t port;
+
+    public:
+        led(triport::port &port);
+        void on();
+        void off();
+        std::int32_t value() const;
+    };
+
+    // ---------- Brain ----------
+    class brain
+    {
+    public:
+        class lcd
+        {
+        public:
+            template <class... Args>
+            void print(const Args &...) {}
+
+            template <class... Args>
+            void printAt(
+                int,
+                int,
+                const Args &...)
+            {
+            }
+
+            void setCursor(
+                int row,
+                int column);
+            void clearScreen();
+            void clearScreen(const color &fill);
+            void clearLine();
+            void clearLine(int row);
+            void newLine();
+            void setPenColor(const color &penColor);
+            void setFillColor(const color &fillColor);
+            void drawRectangle(
+                int x,
+                int y,
+                int width,
+                int height);
+            void drawRectangle(
+                int x,
+                int y,
+                int width,
+                int height,
+                const color &fillColor);
+            void drawLine(
+                int x1,
+                int y1,
+                int x2,
+                int y2);
+            void drawCircle(
+                int x,
+                int y,
+                int radius);
+            std::int32_t getStringWidth(const char *text);
+            std::int32_t getStringHeight(const char *text);
+
+            /// @brief True while the simulated screen is touched, see neblib::sim::World::setTouch()
+            bool pressing();
+            std::int32_t xPosition();
+            std::int32_t yPosition();
+            void render();
+        };
+
+        /// @brief SD card backed by files in the working directory
+        class sdcard
+        {
+        public:
+            bool isInserted();
+            std::int32_t savefile(
+                const char *name,
+                std::uint8_t *buffer,
+                std::int32_t length);
+            std::int32_t appendfile(
+                const char *name,
+                std::uint8_t *buffer,
+                std::int32_t length);
+            std::int32_t loadfile(
+                const char *name,
+                std::uint8_t *buffer,
+                std::int32_t length);
+            bool exists(const char *name);
+            std::int32_t size(const char *name);
+        };
+
+        lcd Screen;
+        sdcard SDcard;
+        timer Timer;
+        triport ThreeWirePort;
+    };
+
+    // ---------- Controller ----------
+    class controller
+    {
+    public:
+        class axis
+        {
+        private:
+            int controllerIndex;
+            int axisIndex;
+
+        public:
+            axis(
+                int controllerIndex,
+                int axisIndex);
+
+            std::int32_t value() const;
+            std::int32_t position(percentUnits units = percentUnits::pct) const;
+        };
+
+        class button
+        {
+        private:
+            int controllerIndex;
+            int buttonIndex;
+
+        public:
+            button(
+                int controllerIndex,
+                int buttonIndex);
+
+            bool pressing() const;
+        };
+
+        class lcd
+        {
+        public:
+            template <class... Args>
+            void print(const Args &...) {}
+
+            void setCursor(
+                int row,
+                int column);
+            void clearScreen();
+            void clearLine(int row);
+            void newLine();
+        };
+
+        axis Axis1;
+        axis Axis2;
+        axis Axis3;
+        axis Axis4;
+        button ButtonL1;
+        button ButtonL2;
+        button ButtonR1;
+        button ButtonR2;
+        button ButtonUp;
+        button ButtonDown;
+        button ButtonLeft;
+        button ButtonRight;
+        button ButtonX;
+        button ButtonB;
+        button ButtonY;
+        button ButtonA;
+        lcd Screen;
+
+        controller(controllerType type = controllerType::primary);
+
+        void rumble(const char *pattern);
+    };
+
+} // namespace vex
+
+#define waitUntil(condition) \
+  do                         \
+  {                          \
+    wait(5, msec);           \
+  } while (!(condition))
+
+#define repeat(iterations) \
+  for (int iterator = 0; iterator < iterations; iterator++)
@@ -0,0 +1,549 @@
+// Autonomous timing regression suite: replays scripted routines on the simulated
+// Standard Drive and records how long they take and where they end up.
+//
+//   make -C sim && sim/build/bin/auton [--json file] [--compare file] [--time-threshold percent] [--error-threshold inches]
+//
+// Every routine starts from rest at a fixed pose with a fixed random seed, so
+// a run gives the same numbers every time. --json writes the results, one
+// routine or motion per line. --compare exits with 1 if any routine took more
+// than the time threshold (5% by default) longer than in a saved run, or ended
+// further than the error threshold (0.5 in, or as many degrees) from its
+// targets. `make -C sim check` compares against sim/baselines/auton.json.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include "vex.h"
+#include "neblib/standard_drive.hpp"
+#include "neblib/devices/tracker_wheel.hpp"
+#include "neblib/util.hpp"
+#include "neblib/sim/world.hpp"
+
+using namespace neblib::literals;
+
+vex::motor leftFront = vex::motor(vex::PORT1, vex::ratio6_1, true);
+vex::motor leftMiddle = vex::motor(vex::PORT2, vex::ratio6_1, true);
+vex::motor leftBack = vex::motor(vex::PORT3, vex::ratio6_1, true);
+vex::motor rightFront = vex::motor(vex::PORT4, vex::ratio6_1, false);
+vex::motor rightMiddle = vex::motor(vex::PORT5, vex::ratio6_1, false);
+vex::motor rightBack = vex::motor(vex::PORT6, vex::ratio6_1, false);
+
+vex::inertial imu(vex::PORT10, vex::turnType::right);
+vex::rotation parallelRotation(vex::PORT7, false);
+vex::rotation perpendicularRotation(vex::PORT8, false);
+
+neblib::RotationTrackerWheel parallel(
+    parallelRotation,
+    2.0);
+neblib::RotationTrackerWheel perpendicular(
+    perpendicularRotation,
+    2.0);
+
+neblib::Odometry odom(
+    parallel,
+    0.0,
+    perpendicular,
+    2.0,
+    imu);
+neblib::StandardDrive tank(
+    vex::motor_group(leftFront, leftMiddle, leftBack),
+    vex::motor_group(rightFront, rightMiddle, rightBack),
+    &odom,
+    parallel,
+    imu);
+
+neblib::PID linearPID(
+    neblib::PID::Gains(
+        1.0,
+        0.0,
+        4.0),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        0.5,
+        50));
+
+neblib::PID angularPID(
+    neblib::PID::Gains(
+        0.2,
+        0.0,
+        1.0),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        1.0,
+        50));
+
+neblib::PID turnPID(
+    neblib::PID::Gains(
+        0.25,
+        0.0,
+        1.5),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        1.0,
+        50));
+
+neblib::PID swingPID(
+    neblib::PID::Gains(
+        0.4,
+        0.0,
+        2.0),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        1.0,
+        50));
+
+namespace
+{
+    /// @brief Marks an error that does not apply to a motion, e.g. position after a turn
+    const double notMeasured = -1.0;
+
+    /// @brief One motion of a routine
+    struct MotionResult
+    {
+        std::string name;
+        int result; //< Value returned by the motion, its time (ms) or a negative error
+        double elapsed; //< Simulated time (ms) the call took
+        double positionError; //< Distance (in) from the target position, or notMeasured
+        double headingError; //< Difference (deg) from the target heading, or notMeasured
+    };
+
+    /// @brief One routine, from rest at its start pose to the return of its last motion
+    struct RoutineResult
+    {
+        std::string name;
+        double total; //< ms
+        double positionError; //< Largest position error (in) of its motions
+        double headingError; //< Largest heading error (deg) of its motions
+        double peakVoltage; //< Largest drive motor voltage (V) applied
+        std::vector<MotionResult> motions;
+    };
+
+    /// @brief Records the routine being run
+    struct Recorder
+    {
+        neblib::sim::World *world;
+        neblib::sim::ChassisModel *chassis;
+        RoutineResult routine;
+        std::vector<RoutineResult> routines;
+
+        /// @brief Resets the robot to rest at a pose and starts a routine
+        void begin(
+            const char *name,
+            unsigned int seed,
+            double x,
+            double y,
+            double heading)
+        {
+            tank.stop(vex::brakeType::brake);
+            vex::task::sleep(500);
+            chassis->setPose(x, y, heading);
+            odom.setPose(x, y, heading);
+            srand(seed);
+            vex::task::sleep(20);
+
+            routine = RoutineResult();
+            routine.name = name;
+            routine.positionError = 0.0;
+            routine.headingError = 0.0;
+            routine.peakVoltage = 0.0;
+            routine.total = world->time() / 1e3;
+        }
+
+        /// @brief Runs one motion and measures it against its target
+        ///
+        /// @param name name of the motion
+        /// @param motion calls the motion and returns its time (s) or error code
+        /// @param x target 'x' position, NAN if the motion has none
+        /// @param y target 'y' position, NAN if the motion has none
+        /// @param heading target heading, NAN if the motion has none
+        void run(
+            const char *name,
+            const std::function<double()> &motion,
+            double x,
+            double y,
+            double heading)
+        {
+            MotionResult result;
+            result.name = name;
+            const double start = world->time() / 1e3;
+            const double seconds = motion();
+            result.result = (seconds < 0.0) ? static_cast<int>(seconds) : static_cast<int>(std::lround(seconds * 1000.0));
+            result.elapsed = world->time() / 1e3 - start;
+
+            const neblib::sim::ChassisModel::State state = chassis->getState();
+            result.positionError = std::isnan(x) ? notMeasured : std::hypot(state.x - x, state.y - y);
+            result.headingError = std::isnan(heading) ? notMeasured : std::abs(neblib::wrap(state.heading - heading, -180.0, 180.0));
+            if (result.positionError > routine.positionError)
+                routine.positionError = result.positionError;
+            if (result.headingError > routine.headingError)
+                routine.headingError = result.headingError;
+            routine.motions.push_back(result);
+        }
+
+        /// @brief Ends the routine
+        void end()
+        {
+            routine.total = world->time() / 1e3 - routine.total;
+            routines.push_back(routine);
+        }
+
+        /// @brief Target of driving a distance along the current heading
+        void ahead(
+            double distance,
+            double &x,
+            double &y) const
+        {
+            const neblib::sim::ChassisModel::State state = chassis->getState();
+            x = state.x + distance * std::sin(neblib::toRad(state.heading));
+            y = state.y + distance * std::cos(neblib::toRad(state.heading));
+        }
+    };
+
+    /// @brief Tracks the largest voltage on the drive motors
+    void recordVoltage(
+        neblib::sim::World &world,
+        void *context)
+    {
+        RoutineResult &routine = static_cast<Recorder *>(context)->routine;
+        const neblib::sim::Ports &ports = world.getPorts();
+        for (int port = vex::PORT1; port <= vex::PORT6; port++)
+        {
+            const double voltage = std::abs(ports.motors[port].voltage);
+            if (voltage > routine.peakVoltage)
+                routine.peakVoltage = voltage;
+        }
+    }
+
+    // ---------- Routines ----------
+
+    void square(Recorder &recorder)
+    {
+        recorder.begin("square", 1, 0.0, 0.0, 0.0);
+        for (int side = 0; side < 4; side++)
+        {
+            double x, y;
+            recorder.ahead(24.0, x, y);
+            recorder.run("driveFor(24)", []()
+                         { return tank.driveFor(24.0, 2500_ms); }, x, y, NAN);
+            const double heading = 90.0 * (side + 1);
+            recorder.run(("turnTo(" + std::to_string(static_cast<int>(heading)) + ")").c_str(), [heading]()
+                         { return tank.turnTo(heading, 2000_ms); }, NAN, NAN, heading);
+        }
+        recorder.end();
+    }
+
+    void swing(Recorder &recorder)
+    {
+        recorder.begin("swing", 2, 0.0, 0.0, 0.0);
+        recorder.run("swingTo(right, 90)", []()
+                     { return tank.swingTo(vex::turnType::right, 90.0, 2000_ms); }, NAN, NAN, 90.0);
+        recorder.run("swingTo(left, 0)", []()
+                     { return tank.swingTo(vex::turnType::left, 0.0, 2000_ms); }, NAN, NAN, 0.0);
+        recorder.run("swingTo(left, -90)", []()
+                     { return tank.swingTo(vex::turnType::left, -90.0, 2000_ms); }, NAN, NAN, -90.0);
+        recorder.run("swingTo(right, 0)", []()
+                     { return tank.swingTo(vex::turnType::right, 0.0, 2000_ms); }, NAN, NAN, 0.0);
+        recorder.end();
+    }
+
+    /// @brief Targets shared by the stopping and chained pose routines
+    const double poses[3][3] = {
+        {12.0, 24.0, 45.0},
+        {36.0, 36.0, 90.0},
+        {48.0, 12.0, 180.0}};
+
+    void posesStopping(Recorder &recorder)
+    {
+        recorder.begin("poses stop", 3, 0.0, 0.0, 0.0);
+        for (int i = 0; i < 3; i++)
+        {
+            const double *pose = poses[i];
+            char name[64];
+            snprintf(name, sizeof(name), "driveToPose(%g, %g, %g)", pose[0], pose[1], pose[2]);
+            recorder.run(name, [pose]()
+                         { return tank.driveToPose(pose[0], pose[1], pose[2], 3000_ms); }, pose[0], pose[1], pose[2]);
+        }
+        recorder.end();
+    }
+
+    void posesChained(Recorder &recorder)
+    {
+        recorder.begin("poses chained", 3, 0.0, 0.0, 0.0);
+        for (int i = 0; i < 3; i++)
+        {
+            const double *pose = poses[i];
+            char name[64];
+            snprintf(name, sizeof(name), "driveToPose(%g, %g, %g)", pose[0], pose[1], pose[2]);
+            // Every pose but the last exits early and is only held to reaching its exit radius
+            if (i < 2)
+                recorder.run(name, [pose]()
+                             { return tank.driveToPose(pose[0], pose[1], pose[2], neblib::ChainConditions(4.0, 3.0), 3000_ms); }, NAN, NAN, NAN);
+            else
+                recorder.run(name, [pose]()
+                             { return tank.driveToPose(pose[0], pose[1], pose[2], 3000_ms); }, pose[0], pose[1], pose[2]);
+        }
+        recorder.end();
+    }
+
+    void arcs(Recorder &recorder)
+    {
+        recorder.begin("arcs", 4, 0.0, 0.0, 0.0);
+        recorder.run("arcTo(24, 24, 90)", []()
+                     { return tank.arcTo(24.0, 24.0, 90.0, 3000_ms); }, 24.0, 24.0, 90.0);
+        // Faces away from the arc, so backs along it and ends opposite the target heading
+        recorder.run("arcTo(0, 0, 180) reverse", []()
+                     { return tank.arcTo(0.0, 0.0, 180.0, 3000_ms); }, 0.0, 0.0, 0.0);
+        // On the line of the target heading, so drives straight
+        recorder.run("arcTo(0, 24, 0) straight", []()
+                     { return tank.arcTo(0.0, 24.0, 0.0, 3000_ms); }, 0.0, 24.0, 0.0);
+        recorder.run("arcTo(0, 0, 180) straight", []()
+                     { return tank.arcTo(0.0, 0.0, 180.0, 3000_ms); }, 0.0, 0.0, 0.0);
+        // The target heading points back at the robot, no arc ends there
+        recorder.run("arcTo(0, 48, 180) rejected", []()
+                     { return tank.arcTo(0.0, 48.0, 180.0, 3000_ms); }, 0.0, 0.0, 0.0);
+        recorder.end();
+    }
+
+    // ---------- Output ----------
+
+    void print(const std::vector<RoutineResult> &routines)
+    {
+        for (std::size_t i = 0; i < routines.size(); i++)
+        {
+            const RoutineResult &routine = routines[i];
+            printf("%s\n", routine.name.c_str());
+            for (std::size_t j = 0; j < routine.motions.size(); j++)
+            {
+                const MotionResult &motion = routine.motions[j];
+                printf("  %-28s %6d ms %8.0f ms", motion.name.c_str(), motion.result, motion.elapsed);
+                if (motion.positionError != notMeasured)
+                    printf("   %6.2f in", motion.positionError);
+                if (motion.headingError != notMeasured)
+                    printf("   %6.2f deg", motion.headingError);
+                printf("\n");
+            }
+        }
+
+        printf("\n%-16s %10s %10s %10s %10s\n", "routine", "total ms", "error in", "error deg", "peak V");
+        for (std::size_t i = 0; i < routines.size(); i++)
+        {
+            const RoutineResult &routine = routines[i];
+            printf("%-16s %10.0f %10.2f %10.2f %10.2f\n",
+                   routine.name.c_str(),
+                   routine.total,
+                   routine.positionError,
+                   routine.headingError,
+                   routine.peakVoltage);
+        }
+    }
+
+    int writeJson(
+        const std::vector<RoutineResult> &routines,
+        const char *fileName)
+    {
+        FILE *file = fopen(fileName, "w");
+        if (!file)
+            return -1;
+
+        fprintf(file, "[\n");
+        for (std::size_t i = 0; i < routines.size(); i++)
+        {
+            const RoutineResult &routine = routines[i];
+            fprintf(file,
+                    "  {\"routine\": \"%s\", \"total_ms\": %.0f, \"position_error\": %.4f, \"heading_error\": %.4f, \"peak_voltage\": %.3f},\n",
+                    routine.name.c_str(),
+                    routine.total,
+                    routine.positionError,
+                    routine.headingError,
+                    routine.peakVoltage);
+            for (std::size_t j = 0; j < routine.motions.size(); j++)
+            {
+                const MotionResult &motion = routine.motions[j];
+                const bool last = i + 1 == routines.size() && j + 1 == routine.motions.size();
+                fprintf(file,
+                        "  {\"routine\": \"%s\", \"motion\": \"%s\", \"result\": %d, \"elapsed_ms\": %.0f, \"position_error\": %.4f, \"heading_error\": %.4f}%s\n",
+                        routine.name.c_str(),
+                        motion.name.c_str(),
+                        motion.result,
+                        motion.elapsed,
+                        motion.positionError,
+                        motion.headingError,
+                        last ? "" : ",");
+            }
+        }
+        fprintf(file, "]\n");
+        fclose(file);
+        return 0;
+    }
+
+    double readNumber(
+        const char *line,
+        const char *key)
+    {
+        const char *value = std::strstr(line, key);
+        return value ? std::strtod(value + std::strlen(key), nullptr) : 0.0;
+    }
+
+    /// @brief Compares routines to a file written by writeJson() and prints the change
+    ///
+    /// @return number of regressions, -1 if the file could not be opened
+    int compare(
+        const std::vector<RoutineResult> &routines,
+        const char *fileName,
+        double timeThreshold,
+        double errorThreshold)
+    {
+        FILE *file = fopen(fileName, "r");
+        if (!file)
+            return -1;
+
+        // Each routine is on its own line, so a line scan is all the parsing needed
+        std::vector<RoutineResult> baseline;
+        char line[512];
+        while (fgets(line, sizeof(line), file))
+        {
+            const char *name = std::strstr(line, "\"routine\": \"");
+            if (!name || std::strstr(line, "\"motion\": "))
+                continue;
+            name += std::strlen("\"routine\": \"");
+            const char *nameEnd = std::strchr(name, '"');
+            if (!nameEnd)
+                continue;
+
+            RoutineResult routine;
+            routine.name = std::string(name, nameEnd);
+            routine.total = readNumber(line, "\"total_ms\": ");
+            routine.positionError = readNumber(line, "\"position_error\": ");
+            routine.headingError = readNumber(line, "\"heading_error\": ");
+            routine.peakVoltage = readNumber(line, "\"peak_voltage\": ");
+            baseline.push_back(routine);
+        }
+        fclose(file);
+
+        int regressions = 0;
+        printf("\n%-16s %18s %20s %20s\n", "routine", "total ms", "error in", "error deg");
+        for (std::size_t i = 0; i < routines.size(); i++)
+        {
+            const RoutineResult &routine = routines[i];
+            for (std::size_t j = 0; j < baseline.size(); j++)
+            {
+                const RoutineResult &saved = baseline[j];
+                if (saved.name != routine.name)
+                    continue;
+
+                const bool slower = routine.total > saved.total * (1.0 + timeThreshold / 100.0);
+                const bool lessAccurate = routine.positionError > saved.positionError + errorThreshold ||
+                                          routine.headingError > saved.headingError + errorThreshold;
+                if (slower || lessAccurate)
+                    regressions++;
+                printf("%-16s %8.0f -> %6.0f %9.2f -> %6.2f %9.2f -> %6.2f%s%s\n",
+                       routine.name.c_str(),
+                       saved.total,
+                       routine.total,
+                       saved.positionError,
+                       routine.positionError,
+                       saved.headingError,
+                       routine.headingError,
+                       slower ? "  SLOWER" : "",
+                       lessAccurate ? "  LESS ACCURATE" : "");
+                break;
+            }
+        }
+        return regressions;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *jsonFile = nullptr;
+    const char *compareFile = nullptr;
+    double timeThreshold = 5.0;
+    double errorThreshold = 0.5;
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--json") == 0)
+            jsonFile = argv[i + 1];
+        else if (i + 1 < argc && std::strcmp(argv[i], "--compare") == 0)
+            compareFile = argv[i + 1];
+        else if (i + 1 < argc && std::strcmp(argv[i], "--time-threshold") == 0)
+            timeThreshold = std::atof(argv[i + 1]);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--error-threshold") == 0)
+            errorThreshold = std::atof(argv[i + 1]);
+        else
+        {
+            fprintf(stderr, "usage: %s [--json file] [--compare file] [--time-threshold percent] [--error-threshold inches]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    neblib::sim::World &world = neblib::sim::World::get();
+
+    // 12 in track width, 3.25 in wheels geared 600 to 450 rpm
+    neblib::sim::ChassisModel chassis = neblib::sim::ChassisModel::differential(
+        {vex::PORT1, vex::PORT2, vex::PORT3},
+        {vex::PORT4, vex::PORT5, vex::PORT6},
+        12.0,
+        3.25,
+        0.75);
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, 0.0, 0.0, 2.0, vex::PORT7));
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, -2.0, 90.0, 2.0, vex::PORT8));
+    chassis.setImu(vex::PORT10);
+    chassis.setPose(0.0, 0.0, 0.0);
+    world.setChassis(&chassis);
+
+    odom.calibrate();
+    neblib::Task<int> odomTask = neblib::spawnTask(std::bind(&neblib::Odometry::begin, &odom), vex::task::taskPriorityHigh);
+    tank.setLinearPID(&linearPID);
+    tank.setAngularPID(&angularPID);
+    tank.setTurnPID(&turnPID);
+    tank.setSwingPID(&swingPID);
+    tank.setTrackWidth(12.0);
+
+    Recorder recorder;
+    recorder.world = &world;
+    recorder.chassis = &chassis;
+    world.setStepObserver(recordVoltage, &recorder);
+
+    square(recorder);
+    swing(recorder);
+    posesStopping(recorder);
+    posesChained(recorder);
+    arcs(recorder);
+
+    tank.stop(vex::brakeType::coast);
+    odom.stop();
+    world.setStepObserver(nullptr);
+
+    print(recorder.routines);
+
+    if (jsonFile && writeJson(recorder.routines, jsonFile) != 0)
+    {
+        fprintf(stderr, "could not write %s\n", jsonFile);
+        return 2;
+    }
+
+    if (compareFile)
+    {
+        const int regressions = compare(recorder.routines, compareFile, timeThreshold, errorThreshold);
+        if (regressions < 0)
+        {
+            fprintf(stderr, "could not read %s\n", compareFile);
+            return 2;
+        }
+        if (regressions > 0)
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,345 @@
+// Micro-benchmarks of neblib hot paths
+//
+//   make -C sim && sim/build/bin/bench [--filter text] [--json file] [--compare file] [--threshold percent]
+//
+// --json writes the results for later comparison. --compare prints the
+// change from a saved run and exits with 1 if any case's median slowed
+// down by more than the threshold (10% by default).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "vex.h"
+#include "neblib/control_algorithms.hpp"
+#include "neblib/devices/tracker_wheel.hpp"
+#include "neblib/kinematics.hpp"
+#include "neblib/path_planner.hpp"
+#include "neblib/position_tracking.hpp"
+#include "neblib/random.hpp"
+#include "neblib/transform.hpp"
+#include "neblib/util.hpp"
+#include "neblib/xdrive.hpp"
+#include "neblib/sim/benchmark.hpp"
+#include "neblib/sim/world.hpp"
+
+using neblib::sim::doNotOptimize;
+
+namespace
+{
+    // ---------- Inputs ----------
+    // Precomputed so the cases measure the code under test rather than input generation
+    const std::size_t inputCount = 1024;
+    double inputs[inputCount];
+
+    void fillInputs()
+    {
+        neblib::seedRandom(42);
+        for (std::size_t i = 0; i < inputCount; i++)
+            inputs[i] = neblib::uniformRandom(-720.0, 720.0);
+    }
+
+    double input(std::uint64_t i)
+    {
+        return inputs[i & (inputCount - 1)];
+    }
+
+    // ---------- Devices ----------
+    vex::motor leftFrontMotor(vex::PORT1, vex::ratio6_1, false);
+    vex::motor rightFrontMotor(vex::PORT2, vex::ratio6_1, true);
+    vex::motor leftBackMotor(vex::PORT3, vex::ratio6_1, false);
+    vex::motor rightBackMotor(vex::PORT4, vex::ratio6_1, true);
+    vex::motor_group leftFront(leftFrontMotor);
+    vex::motor_group rightFront(rightFrontMotor);
+    vex::motor_group leftBack(leftBackMotor);
+    vex::motor_group rightBack(rightBackMotor);
+    vex::inertial imu(vex::PORT10);
+    vex::rotation parallelRotation(vex::PORT6);
+    vex::rotation perpendicularRotation(vex::PORT8);
+    neblib::RotationTrackerWheel parallel(parallelRotation, 2.0);
+    neblib::RotationTrackerWheel perpendicular(perpendicularRotation, 2.0);
+    neblib::Odometry odom(parallel, -4.0, perpendicular, 1.5, imu);
+    neblib::XDrive xDrive(leftFront, rightFront, leftBack, rightBack, imu, &odom);
+
+    // ---------- Cases ----------
+    void baseline(std::uint64_t iterations, void *)
+    {
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(input(i));
+    }
+
+    void wrap(std::uint64_t iterations, void *)
+    {
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(neblib::wrap(input(i), -180.0, 180.0));
+    }
+
+    void clamp(std::uint64_t iterations, void *)
+    {
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(neblib::clamp(input(i), -12.0, 12.0));
+    }
+
+    void gaussRandom(std::uint64_t iterations, void *)
+    {
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(neblib::gaussRandom(0.0, 1.0));
+    }
+
+    void uniformRandom(std::uint64_t iterations, void *)
+    {
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(neblib::uniformRandom(-1.0, 1.0));
+    }
+
+    // What gaussRandom() did before neblib::Random, for comparison
+    void mt19937Gauss(std::uint64_t iterations, void *)
+    {
+        static std::mt19937 generator(42);
+        for (std::uint64_t i = 0; i < iterations; i++)
+        {
+            std::normal_distribution<double> distribution(0.0, 1.0);
+            doNotOptimize(distribution(generator));
+        }
+    }
+
+    void randomGauss(std::uint64_t iterations, void *context)
+    {
+        neblib::Random &random = *static_cast<neblib::Random *>(context);
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(random.gauss());
+    }
+
+    void randomUniform(std::uint64_t iterations, void *context)
+    {
+        neblib::Random &random = *static_cast<neblib::Random *>(context);
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(random.uniform());
+    }
+
+    // One iteration fills the x, y and heading arrays of 1024 particles
+    void randomFillGauss(std::uint64_t iterations, void *context)
+    {
+        static double x[inputCount];
+        static double y[inputCount];
+        static double heading[inputCount];
+        neblib::Random &random = *static_cast<neblib::Random *>(context);
+        for (std::uint64_t i = 0; i < iterations; i++)
+        {
+            random.fillGauss(x, inputCount, 0.0, 0.5);
+            random.fillGauss(y, inputCount, 0.0, 0.5);
+            random.fillGauss(heading, inputCount, 0.0, 2.0);
+            doNotOptimize(x[i & (inputCount - 1)] + y[0] + heading[0]);
+        }
+    }
+
+    // Both rotate 1024 points into the field frame per iteration, the way
+    // odometry did before neblib::Transform and with the batch kernel
+    void polarTransform(std::uint64_t iterations, void *)
+    {
+        static double x[inputCount];
+        static double y[inputCount];
+        for (std::uint64_t i = 0; i < iterations; i++)
+        {
+            const double rotation = neblib::toRad(input(i));
+            for (std::size_t j = 0; j < inputCount; j++)
+            {
+                const double radius = hypot(inputs[j], inputs[inputCount - 1 - j]);
+                const double angle = atan2(inputs[inputCount - 1 - j], inputs[j]) - rotation;
+                x[j] = 12.0 + radius * cos(angle);
+                y[j] = 24.0 + radius * sin(angle);
+            }
+            doNotOptimize(x[i & (inputCount - 1)] + y[0]);
+        }
+    }
+
+    void transformPoints(std::uint64_t iterations, void *)
+    {
+        static double right[inputCount];
+        static double x[inputCount];
+        static double y[inputCount];
+        for (std::size_t j = 0; j < inputCount; j++)
+            right[j] = inputs[inputCount - 1 - j];
+        for (std::uint64_t i = 0; i < iterations; i++)
+        {
+            neblib::transformPoints(neblib::Transform(12.0, 24.0, input(i)), right, inputs, x, y, inputCount);
+            doNotOptimize(x[i & (inputCount - 1)] + y[0]);
+        }
+    }
+
+    void transformCompose(std::uint64_t iterations, void *)
+    {
+        neblib::Transform pose(12.0, 24.0, 45.0);
+        const neblib::Transform step = neblib::Transform::exp(neblib::Twist(0.01, 0.5, 0.3));
+        for (std::uint64_t i = 0; i < iterations; i++)
+        {
+            pose = pose * step;
+            doNotOptimize(pose.getX());
+        }
+    }
+
+    void contains(std::uint64_t iterations, void *)
+    {
+        static const char *const names[4] = {"driveToPose", "turnTo", "Odometry::update", "PID::getOutput"};
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(neblib::contains(names[i & 3], "Output"));
+    }
+
+    void pidGetOutput(std::uint64_t iterations, void *context)
+    {
+        neblib::PID &pid = *static_cast<neblib::PID *>(context);
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(pid.getOutput(input(i) / 60.0, -12.0, 12.0));
+    }
+
+    void odometryUpdate(std::uint64_t iterations, void *)
+    {
+        // Move the sensors every update so the arc branch is taken
+        neblib::sim::Ports &ports = neblib::sim::World::get().getPorts();
+        for (std::uint64_t i = 0; i < iterations; i++)
+        {
+            ports.rotations[vex::PORT6].position += 3.0;
+            ports.rotations[vex::PORT8].position += 0.5;
+            ports.inertials[vex::PORT10].rotation += 0.2;
+            odom.update();
+        }
+        doNotOptimize(odom.getPose());
+    }
+
+    void kinematicsMix(std::uint64_t iterations, void *)
+    {
+        const neblib::HolonomicKinematics<4> kinematics = neblib::xDriveKinematics();
+        double outputs[4];
+        for (std::uint64_t i = 0; i < iterations; i++)
+        {
+            kinematics.mix(input(i) / 60.0, input(i + 1) / 60.0, input(i + 2) / 60.0, 12.0, outputs);
+            doNotOptimize(outputs);
+        }
+    }
+
+    void driveLocal(std::uint64_t iterations, void *)
+    {
+        for (std::uint64_t i = 0; i < iterations; i++)
+            xDrive.driveLocal(input(i) / 60.0, input(i + 1) / 60.0, input(i + 2) / 60.0, vex::voltageUnits::volt);
+    }
+
+    /// @brief Field sized grid with a wall across the middle and a gap at each end
+    ///
+    /// The obstacles are placed in inches, so every resolution plans around the same field.
+    struct PlannerCase
+    {
+        std::vector<std::uint8_t> occupancy;
+        neblib::PathPlanner *planner;
+        neblib::Pose path[1024];
+        bool anyAngle;
+
+        PlannerCase(
+            double cellSize,
+            bool anyAngle)
+            : occupancy(),
+              planner(nullptr),
+              anyAngle(anyAngle)
+        {
+            const int size = static_cast<int>(144.0 / cellSize);
+            occupancy.assign(size * size, 0);
+            for (int x = static_cast<int>(24.0 / cellSize); x < static_cast<int>(120.0 / cellSize); x++)
+                occupancy[static_cast<int>(72.0 / cellSize) * size + x] = 1;
+            for (int y = static_cast<int>(24.0 / cellSize); y < static_cast<int>(60.0 / cellSize); y++)
+                occupancy[y * size + static_cast<int>(48.0 / cellSize)] = 1;
+            planner = new neblib::PathPlanner(occupancy.data(), size, size, cellSize, 7.0);
+        }
+    };
+
+    void planPath(std::uint64_t iterations, void *context)
+    {
+        PlannerCase &planner = *static_cast<PlannerCase *>(context);
+        for (std::uint64_t i = 0; i < iterations; i++)
+            doNotOptimize(planner.planner->plan(neblib::Pose(12.0, 12.0, 0.0), neblib::Pose(72.0, 130.0, 0.0), planner.path, 1024, planner.anyAngle));
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *filter = nullptr;
+    const char *jsonFile = nullptr;
+    const char *compareFile = nullptr;
+    double threshold = 10.0;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--filter") == 0)
+            filter = argv[i + 1];
+        else if (std::strcmp(argv[i], "--json") == 0)
+            jsonFile = argv[i + 1];
+        else if (std::strcmp(argv[i], "--compare") == 0)
+            compareFile = argv[i + 1];
+        else if (std::strcmp(argv[i], "--threshold") == 0)
+            threshold = std::atof(argv[i + 1]);
+        else
+        {
+            fprintf(stderr, "usage: %s [--filter text] [--json file] [--compare file] [--threshold percent]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    fillInputs();
+
+    neblib::PID pid(
+        neblib::PID::Gains(0.4, 0.005, 0.8, 0.45),
+        neblib::PID::Behaviors(12.0, true),
+        neblib::PID::ExitConditions(0.25, 30));
+    PlannerCase aStar4(4.0, false);
+    PlannerCase lazyTheta4(4.0, true);
+    PlannerCase aStar2(2.0, false);
+    PlannerCase lazyTheta2(2.0, true);
+    PlannerCase aStar1(1.0, false);
+    PlannerCase lazyTheta1(1.0, true);
+    neblib::Random random(42);
+
+    neblib::sim::Benchmark benchmark;
+    benchmark.add("baseline", baseline);
+    benchmark.add("wrap", wrap);
+    benchmark.add("clamp", clamp);
+    benchmark.add("gaussRandom", gaussRandom);
+    benchmark.add("uniformRandom", uniformRandom);
+    benchmark.add("mt19937 normal_distribution", mt19937Gauss);
+    benchmark.add("Random::gauss", randomGauss, &random);
+    benchmark.add("Random::uniform", randomUniform, &random);
+    benchmark.add("Random::fillGauss 3x1024", randomFillGauss, &random);
+    benchmark.add("polar transform x1024", polarTransform);
+    benchmark.add("transformPoints x1024", transformPoints);
+    benchmark.add("Transform compose", transformCompose);
+    benchmark.add("contains", contains);
+    benchmark.add("PID::getOutput", pidGetOutput, &pid);
+    benchmark.add("Odometry::update", odometryUpdate);
+    benchmark.add("HolonomicKinematics::mix", kinematicsMix);
+    benchmark.add("XDrive::driveLocal", driveLocal);
+    benchmark.add("PathPlanner::plan A* 36x36 4in", planPath, &aStar4);
+    benchmark.add("PathPlanner::plan Lazy Theta* 36x36 4in", planPath, &lazyTheta4);
+    benchmark.add("PathPlanner::plan A* 72x72 2in", planPath, &aStar2);
+    benchmark.add("PathPlanner::plan Lazy Theta* 72x72 2in", planPath, &lazyTheta2);
+    benchmark.add("PathPlanner::plan A* 144x144 1in", planPath, &aStar1);
+    benchmark.add("PathPlanner::plan Lazy Theta* 144x144 1in", planPath, &lazyTheta1);
+
+    const std::vector<neblib::sim::Benchmark::Result> results = benchmark.runAll(filter);
+    neblib::sim::Benchmark::print(results);
+
+    if (jsonFile && neblib::sim::Benchmark::writeJson(results, jsonFile) != 0)
+    {
+        fprintf(stderr, "could not write %s\n", jsonFile);
+        return 2;
+    }
+
+    if (compareFile)
+    {
+        const int regressions = neblib::sim::Benchmark::compare(results, compareFile, threshold);
+        if (regressions < 0)
+        {
+            fprintf(stderr, "could not read %s\n", compareFile);
+            return 2;
+        }
+        if (regressions > 0)
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,522 @@
+// Synthetic ground-truth accuracy benchmark of position tracking
+//
+//   make -C sim && sim/build/bin/odometry [--filter text] [--csv file]
+//
+// Drives a known trajectory, synthesizes the tracking wheel and inertial
+// readings it would produce with a given resolution, noise, scale error and
+// latency, and feeds them through each position tracking implementation at
+// a given loop rate. Reports how far the estimate drifts from the truth per
+// meter driven and per minute, changing one knob at a time from the
+// resolution of V5 sensors. Noise is seeded, so every run gives the same
+// numbers.
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "vex.h"
+#include "neblib/devices/tracker_wheel.hpp"
+#include "neblib/position_tracking.hpp"
+#include "neblib/random.hpp"
+#include "neblib/util.hpp"
+#include "neblib/sim/world.hpp"
+
+namespace
+{
+    const double inchesPerMeter = 39.3701;
+
+    // ---------- Sensors ----------
+
+    /// @brief Errors of a synthetic sensor
+    ///
+    /// resolution: smallest step the sensor reports (in or deg), 0 for exact
+    /// noise: standard deviation (in or deg) of each reading
+    /// scale: reported distance per true distance
+    /// drift: bias added per second (deg/s), inertial sensor only
+    /// latency: age (ms) of each reading
+    struct SensorModel
+    {
+        double resolution;
+        double noise;
+        double scale;
+        double drift;
+        int latency;
+
+        SensorModel(
+            double resolution = 0.0,
+            double noise = 0.0,
+            double scale = 1.0,
+            double drift = 0.0,
+            int latency = 0)
+            : resolution(resolution),
+              noise(noise),
+              scale(scale),
+              drift(drift),
+              latency(latency)
+        {
+        }
+    };
+
+    /// @brief Records a true value every millisecond and reads it back through a sensor model
+    class SyntheticSensor
+    {
+    private:
+        SensorModel model;
+        neblib::Random *random;
+        std::vector<double> history; //< True value at each ms
+
+    public:
+        SyntheticSensor(
+            const SensorModel &model,
+            neblib::Random &random)
+            : model(model),
+              random(&random)
+        {
+        }
+
+        void record(double value)
+        {
+            history.push_back(value);
+        }
+
+        double read()
+        {
+            if (history.empty())
+                return 0.0;
+            const int age = (static_cast<int>(history.size()) > model.latency) ? model.latency : static_cast<int>(history.size()) - 1;
+            const std::size_t index = history.size() - 1 - age;
+            double value = history[index] * model.scale + model.drift * index / 1000.0;
+            if (model.noise > 0.0)
+                value += random->gauss(0.0, model.noise);
+            if (model.resolution > 0.0)
+                value = std::floor(value / model.resolution + 0.5) * model.resolution;
+            return value;
+        }
+    };
+
+    /// @brief Tracking wheel reading a synthetic sensor, in inches
+    class SyntheticTrackerWheel : public neblib::TrackerWheel
+    {
+    private:
+        SyntheticSensor &sensor;
+        double wheelDiameter;
+        double offset;
+
+    public:
+        SyntheticTrackerWheel(
+            SyntheticSensor &sensor,
+            double wheelDiameter)
+            : sensor(sensor),
+              wheelDiameter(wheelDiameter),
+              offset(0.0)
+        {
+        }
+
+        double getPosition() override
+        {
+            return sensor.read() + offset;
+        }
+
+        void resetPosition() override
+        {
+            offset = -sensor.read();
+        }
+
+        void setPosition(
+            double newPosition,
+            vex::rotationUnits units) override
+        {
+            const double revolutions = (units == vex::rotationUnits::deg) ? newPosition / 360.0 : newPosition;
+            offset = revolutions * M_PI * wheelDiameter - sensor.read();
+        }
+    };
+
+    // ---------- Trajectories ----------
+
+    /// @brief Velocity in the robot's frame
+    ///
+    /// forward, right: in/s
+    /// turn: deg/s clockwise
+    struct Velocity
+    {
+        double forward;
+        double right;
+        double turn;
+    };
+
+    /// @brief Velocity at a time (s) for a top speed (in/s)
+    typedef Velocity (*Trajectory)(
+        double time,
+        double speed);
+
+    /// @brief Half second ramp from rest, like a slew limited motion
+    double ramp(double time)
+    {
+        return (time < 0.5) ? time / 0.5 : 1.0;
+    }
+
+    /// @brief Forward speed driving back and forth, so the robot stays on the field
+    double backAndForth(
+        double time,
+        double speed)
+    {
+        const double direction = (std::fmod(time, 8.0) < 4.0) ? 1.0 : -1.0;
+        return ramp(time) * speed * direction * std::sin(M_PI * std::fmod(time, 4.0) / 4.0);
+    }
+
+    Velocity straight(
+        double time,
+        double speed)
+    {
+        return {backAndForth(time, speed), 0.0, 0.0};
+    }
+
+    Velocity arc(
+        double time,
+        double speed)
+    {
+        // 24 in radius circle
+        return {ramp(time) * speed, 0.0, ramp(time) * speed / 24.0 * 180.0 / M_PI};
+    }
+
+    Velocity slalom(
+        double time,
+        double speed)
+    {
+        return {backAndForth(time, speed), 0.0, ramp(time) * 120.0 * std::sin(2.0 * M_PI * time / 2.0)};
+    }
+
+    Velocity spin(
+        double time,
+        double speed)
+    {
+        // Same wheel speed as driving straight on a 12 in track width
+        return {0.0, 0.0, ramp(time) * speed / 6.0 * 180.0 / M_PI * std::sin(2.0 * M_PI * time / 3.0)};
+    }
+
+    Velocity strafe(
+        double time,
+        double speed)
+    {
+        // Holonomic figure eight while turning slowly
+        return {ramp(time) * speed * std::cos(2.0 * M_PI * time / 4.0),
+                ramp(time) * speed * std::sin(2.0 * M_PI * time / 2.0),
+                ramp(time) * 45.0 * std::sin(2.0 * M_PI * time / 6.0)};
+    }
+
+    // ---------- Estimators ----------
+
+    /// @brief Builds a position tracking implementation from two tracking wheels and an inertial sensor
+    typedef neblib::PositionTracking *(*Factory)(
+        neblib::TrackerWheel &parallel,
+        double parallelDistance,
+        neblib::TrackerWheel &perpendicular,
+        double perpendicularDistance,
+        vex::inertial &imu);
+
+    neblib::PositionTracking *odometry(
+        neblib::TrackerWheel &parallel,
+        double parallelDistance,
+        neblib::TrackerWheel &perpendicular,
+        double perpendicularDistance,
+        vex::inertial &imu)
+    {
+        return new neblib::Odometry(parallel, parallelDistance, perpendicular, perpendicularDistance, imu);
+    }
+
+    struct Estimator
+    {
+        const char *name;
+        Factory create;
+    };
+
+    /// @brief Every implementation measured, add new ones here
+    const Estimator estimators[] = {
+        {"Odometry", odometry}};
+
+    // ---------- Scenarios ----------
+
+    /// @brief One measured configuration
+    ///
+    /// parallelDistance, perpendicularDistance: true tracker offsets (in), as given to neblib::Odometry
+    /// offsetError: error (in) of the offsets given to the estimator
+    /// period: time (ms) between updates
+    struct Scenario
+    {
+        std::string name;
+        Trajectory trajectory;
+        double speed;
+        int period;
+        double parallelDistance;
+        double perpendicularDistance;
+        double offsetError;
+        SensorModel tracker;
+        SensorModel imu;
+        double duration; //< s
+    };
+
+    struct Result
+    {
+        double distance; //< m driven by the robot's center
+        double finalError; //< in
+        double maxError; //< in
+        double headingError; //< deg at the end
+    };
+
+    Result simulate(
+        const Estimator &estimator,
+        const Scenario &scenario)
+    {
+        neblib::Random random(12345);
+        SyntheticSensor parallelSensor(scenario.tracker, random);
+        SyntheticSensor perpendicularSensor(scenario.tracker, random);
+        SyntheticSensor imuSensor(scenario.imu, random);
+        SyntheticTrackerWheel parallel(parallelSensor, 2.0);
+        SyntheticTrackerWheel perpendicular(perpendicularSensor, 2.0);
+
+        neblib::sim::InertialPort &imuPort = neblib::sim::World::get().getPorts().inertials[vex::PORT10];
+        imuPort = neblib::sim::InertialPort();
+        vex::inertial imu(vex::PORT10, vex::turnType::right);
+
+        neblib::PositionTracking *tracking = estimator.create(
+            parallel,
+            scenario.parallelDistance + scenario.offsetError,
+            perpendicular,
+            scenario.perpendicularDistance + scenario.offsetError,
+            imu);
+
+        // The parallel tracker sits right of center, the perpendicular one behind it
+        const double parallelX = scenario.parallelDistance;
+        const double perpendicularY = -scenario.perpendicularDistance;
+
+        double x = 0.0;
+        double y = 0.0;
+        double theta = 0.0;
+        double parallelRolled = 0.0;
+        double perpendicularRolled = 0.0;
+        Result result = {0.0, 0.0, 0.0, 0.0};
+
+        parallelSensor.record(0.0);
+        perpendicularSensor.record(0.0);
+        imuSensor.record(0.0);
+        tracking->setPose(0.0, 0.0, 0.0);
+
+        const int steps = static_cast<int>(scenario.duration * 1000.0);
+        const int substeps = 10;
+        const double dt = 0.001 / substeps;
+        for (int ms = 1; ms <= steps; ms++)
+        {
+            // ---------- Ground Truth ----------
+            for (int i = 0; i < substeps; i++)
+            {
+                const double time = (ms - 1) * 0.001 + (i + 0.5) * dt;
+                const Velocity velocity = scenario.trajectory(time, scenario.speed);
+                const double omega = neblib::toRad(velocity.turn);
+                const double heading = theta + omega * dt / 2.0;
+                x += (velocity.forward * std::sin(heading) + velocity.right * std::cos(heading)) * dt;
+                y += (velocity.forward * std::cos(heading) - velocity.right * std::sin(heading)) * dt;
+                theta += omega * dt;
+                parallelRolled += (velocity.forward - omega * parallelX) * dt;
+                perpendicularRolled += (velocity.right + omega * perpendicularY) * dt;
+                result.distance += std::hypot(velocity.forward, velocity.right) * dt / inchesPerMeter;
+            }
+            parallelSensor.record(parallelRolled);
+            perpendicularSensor.record(perpendicularRolled);
+            imuSensor.record(neblib::toDeg(theta));
+
+            // ---------- Estimate ----------
+            if (ms % scenario.period != 0)
+                continue;
+            imuPort.rotation = imuSensor.read();
+            tracking->update();
+
+            const neblib::Pose pose = tracking->getPose();
+            const double error = std::hypot(pose.x - x, pose.y - y);
+            if (error > result.maxError)
+                result.maxError = error;
+        }
+
+        const neblib::Pose pose = tracking->getPose();
+        result.finalError = std::hypot(pose.x - x, pose.y - y);
+        result.headingError = std::abs(neblib::wrap(pose.heading - neblib::toDeg(theta), -180.0, 180.0));
+        delete tracking;
+        return result;
+    }
+
+    /// @brief Resolution of V5 sensors: 4096 count rotation sensors on 2 in wheels, an inertial sensor with 0.01 deg steps
+    Scenario typical(
+        const std::string &name,
+        Trajectory trajectory)
+    {
+        Scenario scenario;
+        scenario.name = name;
+        scenario.trajectory = trajectory;
+        scenario.speed = 48.0;
+        scenario.period = 10;
+        scenario.parallelDistance = 2.0;
+        scenario.perpendicularDistance = 2.0;
+        scenario.offsetError = 0.0;
+        scenario.tracker = SensorModel(M_PI * 2.0 / 4096.0);
+        scenario.imu = SensorModel(0.01);
+        scenario.duration = 60.0;
+        return scenario;
+    }
+
+    std::vector<Scenario> scenarios()
+    {
+        std::vector<Scenario> list;
+        const Trajectory trajectories[] = {straight, arc, slalom, spin, strafe};
+        const char *const names[] = {"straight", "arc", "slalom", "spin", "strafe"};
+
+        // ---------- Trajectory and Speed ----------
+        for (int i = 0; i < 5; i++)
+        {
+            const double speeds[] = {12.0, 48.0, 84.0};
+            for (int j = 0; j < 3; j++)
+            {
+                Scenario scenario = typical(std::string(names[i]) + " " + std::to_string(static_cast<int>(speeds[j])) + " in/s", trajectories[i]);
+                scenario.speed = speeds[j];
+                list.push_back(scenario);
+            }
+        }
+
+        // ---------- Loop Period ----------
+        const int periods[] = {1, 5, 20, 50};
+        for (int i = 0; i < 4; i++)
+        {
+            Scenario scenario = typical("slalom loop " + std::to_string(periods[i]) + " ms", slalom);
+            scenario.period = periods[i];
+            list.push_back(scenario);
+        }
+
+        // ---------- Tracker Offsets ----------
+        const double offsets[] = {0.0, 6.0};
+        for (int i = 0; i < 2; i++)
+        {
+            Scenario scenario = typical("slalom offsets " + std::to_string(static_cast<int>(offsets[i])) + " in", slalom);
+            scenario.parallelDistance = offsets[i];
+            scenario.perpendicularDistance = offsets[i];
+            list.push_back(scenario);
+        }
+        Scenario mismeasured = typical("slalom offsets off 0.25 in", slalom);
+        mismeasured.offsetError = 0.25;
+        list.push_back(mismeasured);
+
+        // ---------- Quantization ----------
+        Scenario exact = typical("slalom exact sensors", slalom);
+        exact.tracker = SensorModel();
+        exact.imu = SensorModel();
+        list.push_back(exact);
+        Scenario encoder = typical("slalom 360 count encoders", slalom);
+        encoder.tracker.resolution = M_PI * 2.0 / 360.0;
+        list.push_back(encoder);
+        Scenario coarseImu = typical("slalom 0.1 deg imu steps", slalom);
+        coarseImu.imu.resolution = 0.1;
+        list.push_back(coarseImu);
+
+        // ---------- Noise, Scale and Latency ----------
+        Scenario noisy = typical("slalom tracker noise 0.01 in", slalom);
+        noisy.tracker.noise = 0.01;
+        list.push_back(noisy);
+        Scenario noisyImu = typical("slalom imu noise 0.02 deg", slalom);
+        noisyImu.imu.noise = 0.02;
+        list.push_back(noisyImu);
+        Scenario scaled = typical("slalom tracker scale +1%", slalom);
+        scaled.tracker.scale = 1.01;
+        list.push_back(scaled);
+        Scenario drifting = typical("slalom imu drift 0.01 deg/s", slalom);
+        drifting.imu.drift = 0.01;
+        list.push_back(drifting);
+        const int latencies[] = {5, 10};
+        for (int i = 0; i < 2; i++)
+        {
+            Scenario late = typical("slalom imu latency " + std::to_string(latencies[i]) + " ms", slalom);
+            late.imu.latency = latencies[i];
+            list.push_back(late);
+        }
+        return list;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *filter = nullptr;
+    const char *csvFile = nullptr;
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--filter") == 0)
+            filter = argv[i + 1];
+        else if (i + 1 < argc && std::strcmp(argv[i], "--csv") == 0)
+            csvFile = argv[i + 1];
+        else
+        {
+            fprintf(stderr, "usage: %s [--filter text] [--csv file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    FILE *csv = nullptr;
+    if (csvFile)
+    {
+        csv = fopen(csvFile, "w");
+        if (!csv)
+        {
+            fprintf(stderr, "could not write %s\n", csvFile);
+            return 2;
+        }
+        fprintf(csv, "estimator,scenario,distance_m,minutes,final_error_in,max_error_in,drift_mm_per_m,drift_mm_per_min,heading_drift_deg_per_min\n");
+    }
+
+    const std::vector<Scenario> list = scenarios();
+    for (std::size_t e = 0; e < sizeof(estimators) / sizeof(estimators[0]); e++)
+    {
+        const Estimator &estimator = estimators[e];
+        printf("%s\n%-32s %8s %9s %9s %9s %9s %9s\n", estimator.name, "scenario", "meters", "final in", "max in", "mm/m", "mm/min", "deg/min");
+        for (std::size_t i = 0; i < list.size(); i++)
+        {
+            const Scenario &scenario = list[i];
+            if (filter && filter[0] != '\0' && !std::strstr(scenario.name.c_str(), filter))
+                continue;
+
+            const Result result = simulate(estimator, scenario);
+            const double minutes = scenario.duration / 60.0;
+            const double errorMM = result.finalError * 25.4;
+            // Turning in place drives no distance, so it has no drift per meter, only the absolute drift in the other columns
+            const bool moved = result.distance > 0.1;
+            char perMeter[16] = "-";
+            if (moved)
+                snprintf(perMeter, sizeof(perMeter), "%.2f", errorMM / result.distance);
+            printf("%-32s %8.1f %9.3f %9.3f %9s %9.2f %9.3f\n",
+                   scenario.name.c_str(),
+                   result.distance,
+                   result.finalError,
+                   result.maxError,
+                   perMeter,
+                   errorMM / minutes,
+                   result.headingError / minutes);
+            if (csv)
+            {
+                if (moved)
+                    snprintf(perMeter, sizeof(perMeter), "%.4f", errorMM / result.distance);
+                else
+                    perMeter[0] = '\0';
+                fprintf(csv, "%s,%s,%.3f,%.3f,%.4f,%.4f,%s,%.4f,%.4f\n",
+                        estimator.name,
+                        scenario.name.c_str(),
+                        result.distance,
+                        minutes,
+                        result.finalError,
+                        result.maxError,
+                        perMeter,
+                        errorMM / minutes,
+                        result.headingError / minutes);
+            }
+        }
+        printf("\n");
+    }
+
+    if (csv)
+        fclose(csv);
+    return 0;
+}
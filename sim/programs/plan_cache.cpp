@@ -0,0 +1,316 @@
+// Builds the paths of two autonomous routines into a neblib::PlanCache the
+// way pre_auton would, saves the cache, loads it back as a warm boot would,
+// then drives one routine on the simulated Standard Drive from the cache.
+// Caches with another routine, another field, another goal or path, or
+// another version must rebuild instead of loading the file.
+//
+//   make -C sim && sim/build/bin/plan_cache [--file name]
+//
+// Build and load times are host time; the cache file (plan_cache.nbpc by
+// default) is written through the simulated SD card and removed at the end.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "vex.h"
+#include "neblib/standard_drive.hpp"
+#include "neblib/devices/tracker_wheel.hpp"
+#include "neblib/plan_cache.hpp"
+#include "neblib/sim/world.hpp"
+
+using namespace neblib::literals;
+
+vex::brain Brain;
+
+vex::motor leftFront = vex::motor(vex::PORT1, vex::ratio6_1, true);
+vex::motor leftMiddle = vex::motor(vex::PORT2, vex::ratio6_1, true);
+vex::motor leftBack = vex::motor(vex::PORT3, vex::ratio6_1, true);
+vex::motor rightFront = vex::motor(vex::PORT4, vex::ratio6_1, false);
+vex::motor rightMiddle = vex::motor(vex::PORT5, vex::ratio6_1, false);
+vex::motor rightBack = vex::motor(vex::PORT6, vex::ratio6_1, false);
+
+vex::inertial imu(vex::PORT10, vex::turnType::right);
+vex::rotation parallelRotation(vex::PORT7, false);
+vex::rotation perpendicularRotation(vex::PORT8, false);
+
+neblib::RotationTrackerWheel parallel(
+    parallelRotation,
+    2.0);
+neblib::RotationTrackerWheel perpendicular(
+    perpendicularRotation,
+    2.0);
+
+neblib::Odometry odom(
+    parallel,
+    0.0,
+    perpendicular,
+    2.0,
+    imu);
+neblib::StandardDrive tank(
+    vex::motor_group(leftFront, leftMiddle, leftBack),
+    vex::motor_group(rightFront, rightMiddle, rightBack),
+    &odom,
+    parallel,
+    imu);
+
+neblib::PID linearPID(
+    neblib::PID::Gains(
+        1.0,
+        0.0,
+        4.0),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        0.5,
+        50));
+
+neblib::PID angularPID(
+    neblib::PID::Gains(
+        0.2,
+        0.0,
+        1.0),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        1.0,
+        50));
+
+/// @brief 144 inch field in 2 inch cells with a wall across the middle and a gap at each end
+struct Field
+{
+    std::vector<std::uint8_t> occupancy;
+    neblib::PathPlanner *planner;
+
+    Field()
+        : occupancy(72 * 72, 0),
+          planner(nullptr)
+    {
+        for (int x = 12; x < 60; x++)
+            occupancy[36 * 72 + x] = 1;
+        for (int y = 12; y < 30; y++)
+            occupancy[y * 72 + 24] = 1;
+        planner = new neblib::PathPlanner(occupancy.data(), 72, 72, 2.0, 7.0);
+    }
+};
+
+void buildSkills(
+    neblib::PlanCache &cache,
+    const char *routine,
+    void *context)
+{
+    neblib::PathPlanner &planner = *static_cast<Field *>(context)->planner;
+    cache.addPlan(routine, planner, neblib::Pose(12.0, 12.0, 0.0), neblib::Pose(72.0, 130.0, 0.0));
+    cache.addPlan(routine, planner, neblib::Pose(72.0, 130.0, 0.0), neblib::Pose(130.0, 20.0, 180.0));
+    cache.addPlan(routine, planner, neblib::Pose(130.0, 20.0, 180.0), neblib::Pose(12.0, 12.0, 270.0));
+}
+
+void buildMatch(
+    neblib::PlanCache &cache,
+    const char *routine,
+    void *context)
+{
+    neblib::PathPlanner &planner = *static_cast<Field *>(context)->planner;
+    const neblib::Pose scoring[] = {
+        neblib::Pose(12.0, 36.0, 0.0),
+        neblib::Pose(30.0, 50.0, 0.0),
+    };
+    cache.addPath(routine, scoring, 2);
+    cache.addPlan(routine, planner, neblib::Pose(30.0, 50.0, 0.0), neblib::Pose(100.0, 120.0, 45.0));
+}
+
+/// @brief Skills with its second goal moved, which must not load the saved skills paths
+void buildSkillsMoved(
+    neblib::PlanCache &cache,
+    const char *routine,
+    void *context)
+{
+    neblib::PathPlanner &planner = *static_cast<Field *>(context)->planner;
+    cache.addPlan(routine, planner, neblib::Pose(12.0, 12.0, 0.0), neblib::Pose(72.0, 130.0, 0.0));
+    cache.addPlan(routine, planner, neblib::Pose(72.0, 130.0, 0.0), neblib::Pose(130.0, 24.0, 180.0));
+    cache.addPlan(routine, planner, neblib::Pose(130.0, 24.0, 180.0), neblib::Pose(12.0, 12.0, 270.0));
+}
+
+/// @brief Match with its fixed scoring path changed
+void buildMatchMoved(
+    neblib::PlanCache &cache,
+    const char *routine,
+    void *context)
+{
+    neblib::PathPlanner &planner = *static_cast<Field *>(context)->planner;
+    const neblib::Pose scoring[] = {
+        neblib::Pose(12.0, 36.0, 0.0),
+        neblib::Pose(30.0, 52.0, 0.0),
+    };
+    cache.addPath(routine, scoring, 2);
+    cache.addPlan(routine, planner, neblib::Pose(30.0, 52.0, 0.0), neblib::Pose(100.0, 120.0, 45.0));
+}
+
+/// @brief Determines if two caches hold the same paths, bit for bit
+bool samePaths(
+    const neblib::PlanCache &a,
+    const neblib::PlanCache &b,
+    const char *routine)
+{
+    if (a.getPlanCount(routine) != b.getPlanCount(routine))
+        return false;
+    for (std::size_t i = 0; i < a.getPlanCount(routine); i++)
+    {
+        const neblib::PlanCache::Plan planA = a.get(routine, i);
+        const neblib::PlanCache::Plan planB = b.get(routine, i);
+        if (planA.count != planB.count || std::memcmp(planA.poses, planB.poses, planA.count * sizeof(neblib::Pose)) != 0)
+            return false;
+    }
+    return true;
+}
+
+double elapsedMS(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    const char *fileName = "plan_cache.nbpc";
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--file") == 0)
+            fileName = argv[i + 1];
+        else
+        {
+            fprintf(stderr, "usage: %s [--file name]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Field field;
+
+    // ---------- Cold Boot ----------
+    std::remove(fileName);
+    neblib::PlanCache cold;
+    cold.addPlanner(*field.planner);
+    cold.addRoutine("skills", buildSkills, &field);
+    cold.addRoutine("match", buildMatch, &field);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const int coldResult = cold.prepare(Brain.SDcard, fileName);
+    const double coldMS = elapsedMS(start);
+    if (coldResult != 0)
+    {
+        fprintf(stderr, "cold prepare returned %d, expected a build\n", coldResult);
+        return 2;
+    }
+    printf("cold boot   built %zu + %zu paths, %zu poses in %8.3f ms\n",
+           cold.getPlanCount("skills"),
+           cold.getPlanCount("match"),
+           cold.getPoseCount(),
+           coldMS);
+
+    // ---------- Warm Boot ----------
+    neblib::PlanCache warm;
+    warm.addPlanner(*field.planner);
+    warm.addRoutine("skills", buildSkills, &field);
+    warm.addRoutine("match", buildMatch, &field);
+
+    start = std::chrono::steady_clock::now();
+    const int warmResult = warm.prepare(Brain.SDcard, fileName);
+    const double warmMS = elapsedMS(start);
+    if (warmResult != 1 || !samePaths(cold, warm, "skills") || !samePaths(cold, warm, "match"))
+    {
+        fprintf(stderr, "warm prepare returned %d or loaded different paths\n", warmResult);
+        return 2;
+    }
+    printf("warm boot   loaded the same paths        in %8.3f ms\n", warmMS);
+
+    // ---------- Stale Files ----------
+    const int versionResult = warm.load(Brain.SDcard, fileName, warm.getSignature(1));
+
+    neblib::PlanCache renamed;
+    renamed.addPlanner(*field.planner);
+    renamed.addRoutine("skills", buildSkills, &field);
+    renamed.addRoutine("elims", buildMatch, &field);
+    const int renamedResult = renamed.load(Brain.SDcard, fileName, renamed.getSignature());
+
+    // A larger robot radius inflates the same field differently
+    neblib::PathPlanner wider(field.occupancy.data(), 72, 72, 2.0, 8.0);
+    neblib::PlanCache moved;
+    moved.addPlanner(wider);
+    moved.addRoutine("skills", buildSkills, &field);
+    moved.addRoutine("match", buildMatch, &field);
+    const int movedResult = moved.load(Brain.SDcard, fileName, moved.getSignature());
+
+    neblib::PlanCache newGoal;
+    newGoal.addPlanner(*field.planner);
+    newGoal.addRoutine("skills", buildSkillsMoved, &field);
+    newGoal.addRoutine("match", buildMatch, &field);
+    const int goalResult = newGoal.load(Brain.SDcard, fileName, newGoal.getSignature());
+
+    neblib::PlanCache newPath;
+    newPath.addPlanner(*field.planner);
+    newPath.addRoutine("skills", buildSkills, &field);
+    newPath.addRoutine("match", buildMatchMoved, &field);
+    const int pathResult = newPath.load(Brain.SDcard, fileName, newPath.getSignature());
+    std::remove(fileName);
+
+    printf("stale file  load with a new version %d, a renamed routine %d, a new robot radius %d, a new goal %d, a new path %d\n\n",
+           versionResult,
+           renamedResult,
+           movedResult,
+           goalResult,
+           pathResult);
+    if (versionResult != -3 || renamedResult != -3 || movedResult != -3 || goalResult != -3 || pathResult != -3)
+    {
+        fprintf(stderr, "a stale cache file was loaded\n");
+        return 2;
+    }
+
+    // ---------- Autonomous ----------
+    neblib::sim::World &world = neblib::sim::World::get();
+    neblib::sim::ChassisModel chassis = neblib::sim::ChassisModel::differential(
+        {vex::PORT1, vex::PORT2, vex::PORT3},
+        {vex::PORT4, vex::PORT5, vex::PORT6},
+        12.0,
+        3.25,
+        0.75);
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, 0.0, 0.0, 2.0, vex::PORT7));
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, -2.0, 90.0, 2.0, vex::PORT8));
+    chassis.setImu(vex::PORT10);
+    chassis.setPose(12.0, 12.0, 0.0);
+    world.setChassis(&chassis);
+
+    tank.setLinearPID(&linearPID);
+    tank.setAngularPID(&angularPID);
+    odom.calibrate();
+    odom.setPose(12.0, 12.0, 0.0);
+    neblib::Task<int> odomTask = neblib::spawnTask(std::bind(&neblib::Odometry::begin, &odom), vex::task::taskPriorityHigh);
+
+    start = std::chrono::steady_clock::now();
+    const neblib::PlanCache::Plan plan = warm.get("skills", 0);
+    const double lookupMS = elapsedMS(start);
+
+    const std::uint32_t enabled = vex::timer::system();
+    const double result = tank.followPath(plan.poses, plan.count, neblib::ChainConditions(4.0, 3.0), 8000_ms);
+    const neblib::Pose goal = plan.poses[plan.count - 1];
+    const neblib::sim::ChassisModel::State actual = chassis.getState();
+    printf("skills path 0: %zu poses looked up in %.4f ms, %d ms to drive, end %.2f %.2f %.2f, off by %.2f in\n",
+           plan.count,
+           lookupMS,
+           (result < 0.0) ? static_cast<int>(result) : static_cast<int>(vex::timer::system() - enabled),
+           actual.x,
+           actual.y,
+           actual.heading,
+           std::hypot(actual.x - goal.x, actual.y - goal.y));
+
+    tank.stop(vex::brakeType::coast);
+    odom.stop();
+
+    printf("\nsimulated %.2f s at %.0fx real time, battery %.2f V\n",
+           world.time() / 1e6,
+           world.realTimeFactor(),
+           world.getBatteryVoltage());
+    return 0;
+}
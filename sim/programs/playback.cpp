@@ -0,0 +1,195 @@
+// Records a scripted driver run on the simulated Standard Drive, saves and
+// reloads it, then plays it back with and without drift correction while
+// the wheels slip differently than when it was recorded.
+//
+//   make -C sim && sim/build/bin/playback [--file name] [--seed seed]
+//
+// The recording is written to the file (playback.nbpr by default) through
+// the simulated SD card and removed at the end.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include "vex.h"
+#include "neblib/standard_drive.hpp"
+#include "neblib/devices/tracker_wheel.hpp"
+#include "neblib/path_recording.hpp"
+#include "neblib/sim/world.hpp"
+
+vex::brain Brain;
+
+vex::motor leftFront = vex::motor(vex::PORT1, vex::ratio6_1, true);
+vex::motor leftMiddle = vex::motor(vex::PORT2, vex::ratio6_1, true);
+vex::motor leftBack = vex::motor(vex::PORT3, vex::ratio6_1, true);
+vex::motor rightFront = vex::motor(vex::PORT4, vex::ratio6_1, false);
+vex::motor rightMiddle = vex::motor(vex::PORT5, vex::ratio6_1, false);
+vex::motor rightBack = vex::motor(vex::PORT6, vex::ratio6_1, false);
+
+vex::inertial imu(vex::PORT10, vex::turnType::right);
+vex::rotation parallelRotation(vex::PORT7, false);
+vex::rotation perpendicularRotation(vex::PORT8, false);
+
+neblib::RotationTrackerWheel parallel(
+    parallelRotation,
+    2.0);
+neblib::RotationTrackerWheel perpendicular(
+    perpendicularRotation,
+    2.0);
+
+neblib::Odometry odom(
+    parallel,
+    0.0,
+    perpendicular,
+    2.0,
+    imu);
+neblib::StandardDrive tank(
+    vex::motor_group(leftFront, leftMiddle, leftBack),
+    vex::motor_group(rightFront, rightMiddle, rightBack),
+    &odom,
+    parallel,
+    imu);
+
+neblib::PathRecording recording(1000);
+neblib::PathRecorder recorder(odom, recording);
+
+/// @brief Arcade sticks of a driver: straight, a long right arc, a left turn in place, then back up
+void driverSticks(
+    int time,
+    double &drive,
+    double &turn)
+{
+    drive = 0.0;
+    turn = 0.0;
+    if (time < 1200)
+        drive = 8.0;
+    else if (time < 3000)
+    {
+        drive = 7.0;
+        turn = 2.5;
+    }
+    else if (time < 3700)
+        turn = -5.0;
+    else if (time < 5000)
+        drive = -6.0;
+}
+
+void report(
+    const char *name,
+    double result,
+    neblib::sim::ChassisModel &chassis,
+    const neblib::Pose &goal)
+{
+    const neblib::sim::ChassisModel::State actual = chassis.getState();
+    printf("%-26s %6.2f s   end %7.2f %7.2f %7.2f   off by %6.2f in %6.2f deg\n",
+           name,
+           result,
+           actual.x,
+           actual.y,
+           actual.heading,
+           std::hypot(actual.x - goal.x, actual.y - goal.y),
+           std::abs(neblib::wrap(actual.heading - goal.heading, -180.0, 180.0)));
+}
+
+void restart(neblib::sim::ChassisModel &chassis)
+{
+    tank.stop(vex::brakeType::coast);
+    vex::task::sleep(500);
+    chassis.setPose(0.0, 0.0, 0.0);
+    odom.setPose(0.0, 0.0, 0.0);
+    vex::task::sleep(50);
+}
+
+int main(int argc, char **argv)
+{
+    const char *fileName = "playback.nbpr";
+    std::uint32_t seed = 3;
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--file") == 0)
+            fileName = argv[i + 1];
+        else if (i + 1 < argc && std::strcmp(argv[i], "--seed") == 0)
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        else
+        {
+            fprintf(stderr, "usage: %s [--file name] [--seed seed]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    neblib::sim::World &world = neblib::sim::World::get();
+    neblib::sim::ChassisModel chassis = neblib::sim::ChassisModel::differential(
+        {vex::PORT1, vex::PORT2, vex::PORT3},
+        {vex::PORT4, vex::PORT5, vex::PORT6},
+        12.0,
+        3.25,
+        0.75);
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, 0.0, 0.0, 2.0, vex::PORT7));
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, -2.0, 90.0, 2.0, vex::PORT8));
+    chassis.setImu(vex::PORT10);
+    chassis.setPose(0.0, 0.0, 0.0);
+    world.setChassis(&chassis);
+
+    odom.calibrate();
+    odom.setPose(0.0, 0.0, 0.0);
+    neblib::Task<int> odomTask = neblib::spawnTask(std::bind(&neblib::Odometry::begin, &odom), vex::task::taskPriorityHigh);
+
+    // ---------- Record ----------
+    neblib::Task<int> recorderTask = neblib::spawnTask(std::bind(&neblib::PathRecorder::begin, &recorder), vex::task::taskPriorityHigh);
+    const std::uint32_t start = vex::timer::system();
+    for (int time = 0; time < 5500; time = static_cast<int>(vex::timer::system() - start))
+    {
+        double drive;
+        double turn;
+        driverSticks(time, drive, turn);
+        tank.arcadeDrive(drive, turn, vex::voltageUnits::volt);
+        recorder.setCommand(drive, 0.0, turn);
+        vex::task::sleep(20);
+    }
+    recorder.stop();
+    vex::task::sleep(20);
+
+    const neblib::Pose goal = recording.get(recording.size() - 1).pose;
+    report("driver", (vex::timer::system() - start) / 1000.0, chassis, goal);
+    printf("recorded %zu samples over %d ms, %u dropped\n\n",
+           recording.size(),
+           recording.getDuration(),
+           recorder.getDropped());
+
+    // ---------- Save and Reload ----------
+    if (recording.save(Brain.SDcard, fileName) != 0)
+    {
+        fprintf(stderr, "could not write %s\n", fileName);
+        return 2;
+    }
+    neblib::PathRecording loaded(1000);
+    const int loadResult = loaded.load(Brain.SDcard, fileName);
+    std::remove(fileName);
+    if (loadResult != 0)
+    {
+        fprintf(stderr, "could not read %s: %d\n", fileName, loadResult);
+        return 2;
+    }
+
+    // ---------- Play Back ----------
+    // Wheels grip differently than when the run was recorded
+    chassis.setNoise(neblib::sim::ChassisModel::Noise(0.15, 0.0, 0.0, 0.0, 0.0, 0.0), seed);
+
+    restart(chassis);
+    tank.setPlaybackGains(0.0, 0.0, 0.0);
+    report("open loop playback", tank.followRecording(loaded), chassis, goal);
+
+    restart(chassis);
+    tank.setPlaybackGains(1.0, 0.5, 0.2);
+    report("corrected playback", tank.followRecording(loaded), chassis, goal);
+
+    tank.stop(vex::brakeType::coast);
+    odom.stop();
+
+    printf("\nsimulated %.2f s at %.0fx real time, battery %.2f V\n",
+           world.time() / 1e6,
+           world.realTimeFactor(),
+           world.getBatteryVoltage());
+    return 0;
+}
@@ -0,0 +1,219 @@
+// Monte Carlo robustness sweep: repeats an autonomous routine on the simulated
+// Standard Drive under random wheel slip, sensor error and start pose error.
+//
+//   make -C sim && sim/build/bin/sweep [--runs count] [--threads count] [--seed seed] [--csv file] [--min-success percent]
+//
+// Each run draws its errors from its own seed, so a sweep gives the same
+// results on any number of threads. --csv writes every run, to find the seed
+// of a failure and replay it with --runs 1. --min-success exits with 1 if
+// fewer runs than that succeed.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "vex.h"
+#include "neblib/standard_drive.hpp"
+#include "neblib/devices/tracker_wheel.hpp"
+#include "neblib/random.hpp"
+#include "neblib/util.hpp"
+#include "neblib/sim/sweep.hpp"
+#include "neblib/sim/world.hpp"
+
+using namespace neblib::literals;
+
+namespace
+{
+    /// @brief Errors of one run and what counts as success
+    ///
+    /// startPosition: standard deviation (in) of where the robot is placed
+    /// startHeading: standard deviation (deg) of how the robot is turned when placed
+    /// positionTolerance: largest distance (in) from the last target of a successful run
+    /// headingTolerance: largest difference (deg) from the last heading of a successful run
+    struct Options
+    {
+        neblib::sim::ChassisModel::Noise noise;
+        double startPosition;
+        double startHeading;
+        double positionTolerance;
+        double headingTolerance;
+    };
+
+    /// @brief Devices and controllers of one run, built inside its world
+    struct Robot
+    {
+        vex::motor leftFront;
+        vex::motor leftMiddle;
+        vex::motor leftBack;
+        vex::motor rightFront;
+        vex::motor rightMiddle;
+        vex::motor rightBack;
+        vex::inertial imu;
+        vex::rotation parallelRotation;
+        vex::rotation perpendicularRotation;
+        neblib::RotationTrackerWheel parallel;
+        neblib::RotationTrackerWheel perpendicular;
+        neblib::Odometry odom;
+        neblib::StandardDrive tank;
+        neblib::PID linearPID;
+        neblib::PID angularPID;
+        neblib::PID turnPID;
+
+        Robot()
+            : leftFront(vex::PORT1, vex::ratio6_1, true),
+              leftMiddle(vex::PORT2, vex::ratio6_1, true),
+              leftBack(vex::PORT3, vex::ratio6_1, true),
+              rightFront(vex::PORT4, vex::ratio6_1, false),
+              rightMiddle(vex::PORT5, vex::ratio6_1, false),
+              rightBack(vex::PORT6, vex::ratio6_1, false),
+              imu(vex::PORT10, vex::turnType::right),
+              parallelRotation(vex::PORT7, false),
+              perpendicularRotation(vex::PORT8, false),
+              parallel(parallelRotation, 2.0),
+              perpendicular(perpendicularRotation, 2.0),
+              odom(parallel, 0.0, perpendicular, 2.0, imu),
+              tank(vex::motor_group(leftFront, leftMiddle, leftBack),
+                   vex::motor_group(rightFront, rightMiddle, rightBack),
+                   &odom,
+                   parallel,
+                   imu),
+              linearPID(
+                  neblib::PID::Gains(1.0, 0.0, 4.0),
+                  neblib::PID::Behaviors(12.0, true),
+                  neblib::PID::ExitConditions(0.5, 50)),
+              angularPID(
+                  neblib::PID::Gains(0.2, 0.0, 1.0),
+                  neblib::PID::Behaviors(12.0, true),
+                  neblib::PID::ExitConditions(1.0, 50)),
+              turnPID(
+                  neblib::PID::Gains(0.25, 0.0, 1.5),
+                  neblib::PID::Behaviors(12.0, true),
+                  neblib::PID::ExitConditions(1.0, 50))
+        {
+            tank.setLinearPID(&linearPID);
+            tank.setAngularPID(&angularPID);
+            tank.setTurnPID(&turnPID);
+            tank.setTrackWidth(12.0);
+        }
+    };
+
+    int runOdometry(void *odom)
+    {
+        return static_cast<neblib::Odometry *>(odom)->begin();
+    }
+
+    /// @brief Chained poses, then a turn, from the poses routine of sim/programs/auton.cpp
+    void routine(
+        std::uint32_t seed,
+        neblib::sim::Sweep::Run &run,
+        void *context)
+    {
+        const Options &options = *static_cast<const Options *>(context);
+        neblib::sim::World &world = neblib::sim::World::get();
+
+        // Placed off the start pose the robot believes it is at
+        neblib::Random random(seed);
+        const double startX = random.gauss() * options.startPosition;
+        const double startY = random.gauss() * options.startPosition;
+        const double startHeading = random.gauss() * options.startHeading;
+
+        neblib::sim::ChassisModel chassis = neblib::sim::ChassisModel::differential(
+            {vex::PORT1, vex::PORT2, vex::PORT3},
+            {vex::PORT4, vex::PORT5, vex::PORT6},
+            12.0,
+            3.25,
+            0.75);
+        chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, 0.0, 0.0, 2.0, vex::PORT7));
+        chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, -2.0, 90.0, 2.0, vex::PORT8));
+        chassis.setImu(vex::PORT10);
+        chassis.setPose(startX, startY, startHeading);
+        chassis.setNoise(options.noise, seed + 1);
+        world.setChassis(&chassis);
+
+        Robot *robot = new Robot();
+        robot->odom.setPose(0.0, 0.0, 0.0);
+        vex::task odomTask(runOdometry, &robot->odom, vex::task::taskPriorityHigh);
+        vex::task::sleep(20);
+
+        const double start = world.time() / 1e3;
+        const neblib::ChainConditions chain(4.0, 3.0);
+        robot->tank.driveToPose(12.0, 24.0, 45.0, chain, 3000_ms);
+        robot->tank.driveToPose(36.0, 36.0, 90.0, chain, 3000_ms);
+        robot->tank.driveToPose(48.0, 12.0, 180.0, 3000_ms);
+        const double last = robot->tank.turnTo(270.0, 2000_ms);
+        run.time = world.time() / 1e3 - start;
+
+        const neblib::sim::ChassisModel::State state = chassis.getState();
+        run.positionError = std::hypot(state.x - 48.0, state.y - 12.0);
+        run.headingError = std::abs(neblib::wrap(state.heading - 270.0, -180.0, 180.0));
+        run.success = last >= 0.0 && last < 2.0 &&
+                      run.positionError <= options.positionTolerance &&
+                      run.headingError <= options.headingTolerance;
+
+        // Let the odometry task return so the world can be freed
+        robot->tank.stop(vex::brakeType::coast);
+        robot->odom.stop();
+        vex::task::sleep(20);
+        world.setChassis(nullptr);
+        delete robot;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::size_t runs = 1000;
+    int threads = 0;
+    std::uint32_t seed = 1;
+    const char *csvFile = nullptr;
+    double minSuccess = 0.0;
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--runs") == 0)
+            runs = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--threads") == 0)
+            threads = std::atoi(argv[i + 1]);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--seed") == 0)
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (i + 1 < argc && std::strcmp(argv[i], "--csv") == 0)
+            csvFile = argv[i + 1];
+        else if (i + 1 < argc && std::strcmp(argv[i], "--min-success") == 0)
+            minSuccess = std::atof(argv[i + 1]);
+        else
+        {
+            fprintf(stderr, "usage: %s [--runs count] [--threads count] [--seed seed] [--csv file] [--min-success percent]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Options options;
+    options.noise = neblib::sim::ChassisModel::Noise(
+        0.05,
+        0.005,
+        0.003,
+        0.01,
+        0.02,
+        0.05);
+    options.startPosition = 0.5;
+    options.startHeading = 1.0;
+    options.positionTolerance = 2.0;
+    options.headingTolerance = 3.0;
+
+    neblib::sim::Sweep sweep(threads);
+    const std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+    const std::vector<neblib::sim::Sweep::Run> results = sweep.run(runs, seed, routine, &options);
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    const neblib::sim::Sweep::Summary summary = neblib::sim::Sweep::summarize(results);
+    neblib::sim::Sweep::print(summary);
+    printf("\n%.2f s on %d threads, %.0f runs/s\n", wall, sweep.threads(), (wall > 0.0) ? runs / wall : 0.0);
+    if (sweep.getLeakedWorlds() > 0)
+        printf("%zu worlds had tasks that never returned\n", sweep.getLeakedWorlds());
+
+    if (csvFile && neblib::sim::Sweep::writeCsv(results, csvFile) != 0)
+    {
+        fprintf(stderr, "could not write %s\n", csvFile);
+        return 2;
+    }
+    return (100.0 * summary.successRate < minSuccess) ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+// Drives a six motor differential drivetrain through a short autonomous in the simulator
+// and compares odometry to the simulated pose. Exits with 1 if a motion fails or only
+// ends on its timeout.
+//
+//   make -C sim && sim/build/bin/tank
+
+#include <cstdio>
+#include <functional>
+#include "vex.h"
+#include "neblib/standard_drive.hpp"
+#include "neblib/devices/tracker_wheel.hpp"
+#include "neblib/sim/world.hpp"
+
+using namespace neblib::literals;
+
+vex::motor leftFront = vex::motor(vex::PORT1, vex::ratio6_1, true);
+vex::motor leftMiddle = vex::motor(vex::PORT2, vex::ratio6_1, true);
+vex::motor leftBack = vex::motor(vex::PORT3, vex::ratio6_1, true);
+vex::motor rightFront = vex::motor(vex::PORT4, vex::ratio6_1, false);
+vex::motor rightMiddle = vex::motor(vex::PORT5, vex::ratio6_1, false);
+vex::motor rightBack = vex::motor(vex::PORT6, vex::ratio6_1, false);
+
+vex::inertial imu(vex::PORT10, vex::turnType::right);
+vex::rotation parallelRotation(vex::PORT7, false);
+vex::rotation perpendicularRotation(vex::PORT8, false);
+
+neblib::RotationTrackerWheel parallel(
+    parallelRotation,
+    2.0);
+neblib::RotationTrackerWheel perpendicular(
+    perpendicularRotation,
+    2.0);
+
+neblib::Odometry odom(
+    parallel,
+    0.0,
+    perpendicular,
+    2.0,
+    imu);
+neblib::StandardDrive tank(
+    vex::motor_group(leftFront, leftMiddle, leftBack),
+    vex::motor_group(rightFront, rightMiddle, rightBack),
+    &odom,
+    parallel,
+    imu);
+
+neblib::PID linearPID(
+    neblib::PID::Gains(
+        1.0,
+        0.0,
+        4.0),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        0.5,
+        50));
+
+neblib::PID angularPID(
+    neblib::PID::Gains(
+        0.2,
+        0.0,
+        1.0),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        1.0,
+        50));
+
+neblib::PID turnPID(
+    neblib::PID::Gains(
+        0.25,
+        0.0,
+        1.5),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        1.0,
+        50));
+
+/// @brief Prints where a motion ended
+///
+/// @param result value the motion returned, its time (s) or a negative error
+/// @param timeout timeout the motion was given
+/// @return false if the motion failed or ran until its timeout
+bool report(
+    const char *motion,
+    double result,
+    neblib::Time timeout,
+    neblib::sim::ChassisModel &chassis)
+{
+    const bool ok = result >= 0.0 && result < timeout.seconds();
+    const neblib::sim::ChassisModel::State actual = chassis.getState();
+    const neblib::Pose estimate = odom.getPose();
+    printf("%-24s %6.2f s   actual %7.2f %7.2f %7.2f   odom %7.2f %7.2f %7.2f%s\n",
+           motion,
+           result,
+           actual.x,
+           actual.y,
+           actual.heading,
+           estimate.x,
+           estimate.y,
+           estimate.heading,
+           (ok) ? "" : (result < 0.0) ? "   FAILED" : "   TIMED OUT");
+    return ok;
+}
+
+int main()
+{
+    neblib::sim::World &world = neblib::sim::World::get();
+
+    // 12 in track width, 3.25 in wheels geared 600 to 450 rpm
+    neblib::sim::ChassisModel chassis = neblib::sim::ChassisModel::differential(
+        {vex::PORT1, vex::PORT2, vex::PORT3},
+        {vex::PORT4, vex::PORT5, vex::PORT6},
+        12.0,
+        3.25,
+        0.75);
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, 0.0, 0.0, 2.0, vex::PORT7));
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, -2.0, 90.0, 2.0, vex::PORT8));
+    chassis.setImu(vex::PORT10);
+    chassis.setPose(0.0, 0.0, 0.0);
+    world.setChassis(&chassis);
+
+    odom.calibrate();
+    odom.setPose(
+        0.0,
+        0.0,
+        0.0);
+    neblib::Task<int> odomTask = neblib::spawnTask(std::bind(&neblib::Odometry::begin, &odom), vex::task::taskPriorityHigh);
+    tank.setLinearPID(&linearPID);
+    tank.setAngularPID(&angularPID);
+    tank.setTurnPID(&turnPID);
+    tank.setTrackWidth(12.0);
+
+    report("start", 0.0, neblib::Time(1.0), chassis);
+    bool ok = report("driveFor(24)", tank.driveFor(24.0, 2500_ms), 2500_ms, chassis);
+    ok = report("turnTo(90)", tank.turnTo(90.0, 2000_ms), 2000_ms, chassis) && ok;
+    ok = report("driveToPose(24, 24, 0)", tank.driveToPose(24.0, 24.0, 0.0, 3000_ms), 3000_ms, chassis) && ok;
+    ok = report("turnTo(180)", tank.turnTo(180.0, 2000_ms), 2000_ms, chassis) && ok;
+    ok = report("driveTo(0, 0)", tank.driveTo(0.0, 0.0, 3000_ms), 3000_ms, chassis) && ok;
+    tank.stop(vex::brakeType::coast);
+    odom.stop();
+
+    printf("\nsimulated %.2f s at %.0fx real time, battery %.2f V\n",
+           world.time() / 1e6,
+           world.realTimeFactor(),
+           world.getBatteryVoltage());
+    return (ok) ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+// Round trip of the binary telemetry log through the simulated SD card
+//
+//   make -C sim && sim/build/bin/telemetry_log [--seconds count] [--file name]
+//
+// A control task makes a record every 10 ms for two minutes of simulated
+// time, wandering the pose, errors, outputs and motor group voltages the
+// way a match would, and pushes it through a TelemetryQueue, a
+// TelemetryLogger and an SdTelemetryWriter flushing in its own task, the
+// same path a robot uses. The log is then read back from the card, decoded
+// and compared record by record with what was pushed. Every record must be
+// there, in order, and equal to the quantization of the format: hundredths
+// for pose and errors, thousandths for outputs and voltages. Exits with 1
+// otherwise. The log (telemetry_log.bin by default) is removed at the end.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "vex.h"
+#include "neblib/random.hpp"
+#include "neblib/task.hpp"
+#include "neblib/telemetry.hpp"
+#include "neblib/telemetry_writer.hpp"
+#include "neblib/sim/world.hpp"
+
+vex::brain Brain;
+
+namespace
+{
+    /// @brief Everything the control task pushed and the logger handed on
+    struct Log
+    {
+        neblib::TelemetryQueue queue;
+        std::vector<neblib::TelemetryRecord> pushed;
+        int periodMS;
+        int records;
+        int queueDrops;
+    };
+
+    /// @brief Moves a value by a random step, keeping it within a range
+    float wander(
+        neblib::Random &random,
+        float value,
+        double step,
+        double limit)
+    {
+        double next = value + random.gauss(0.0, step);
+        if (next > limit)
+            next = limit;
+        if (next < -limit)
+            next = -limit;
+        return static_cast<float>(next);
+    }
+
+    /// @brief Makes one record every period, like a motion loop paced by an executor
+    int control(void *parameters)
+    {
+        Log &log = *static_cast<Log *>(parameters);
+        neblib::Random random(34);
+        neblib::TelemetryRecord record;
+        std::uint32_t previous = vex::timer::system();
+
+        for (int i = 0; i < log.records; i++)
+        {
+            const std::uint32_t now = vex::timer::system();
+            record.time = now;
+            record.source = static_cast<std::uint16_t>((i / 500) % 4);
+            record.loopTime = static_cast<std::uint16_t>((now - previous) * 1000 + random.uniform(0.0, 300.0));
+            previous = now;
+
+            record.x = wander(random, record.x, 0.4, 72.0);
+            record.y = wander(random, record.y, 0.4, 72.0);
+            record.heading = static_cast<float>(std::fmod(record.heading + random.gauss(0.0, 2.0) + 360.0, 360.0));
+            record.linearError = wander(random, record.linearError, 1.0, 48.0);
+            record.angularError = wander(random, record.angularError, 2.0, 180.0);
+            record.linearOutput = wander(random, record.linearOutput, 0.5, 12.0);
+            record.angularOutput = wander(random, record.angularOutput, 0.5, 12.0);
+            record.voltages[0] = record.linearOutput + record.angularOutput;
+            record.voltages[1] = record.linearOutput - record.angularOutput;
+
+            if (log.queue.push(record))
+                log.pushed.push_back(record);
+            else
+                log.queueDrops++;
+            vex::task::sleep(log.periodMS);
+        }
+        return 0;
+    }
+
+    /// @brief Difference allowed between a record and its decoded copy, half a step of the format and float rounding
+    bool near(
+        float decoded,
+        float original,
+        double step)
+    {
+        return std::fabs(static_cast<double>(decoded) - original) <= step / 2.0 + std::fabs(original) * 1e-6;
+    }
+
+    bool same(
+        const neblib::TelemetryRecord &decoded,
+        const neblib::TelemetryRecord &original)
+    {
+        bool equal = decoded.time == original.time &&
+                     decoded.source == original.source &&
+                     decoded.loopTime == original.loopTime &&
+                     near(decoded.x, original.x, 0.01) &&
+                     near(decoded.y, original.y, 0.01) &&
+                     near(decoded.heading, original.heading, 0.01) &&
+                     near(decoded.linearError, original.linearError, 0.01) &&
+                     near(decoded.angularError, original.angularError, 0.01) &&
+                     near(decoded.linearOutput, original.linearOutput, 0.001) &&
+                     near(decoded.angularOutput, original.angularOutput, 0.001);
+        for (std::size_t i = 0; i < neblib::TelemetryRecord::voltageCount; i++)
+            equal = equal && near(decoded.voltages[i], original.voltages[i], 0.001);
+        return equal;
+    }
+
+    /// @brief Decodes a whole log, stopping at the first block that is cut short or corrupt
+    ///
+    /// @return false if the log is not a telemetry log or is damaged
+    bool decodeLog(
+        const std::vector<std::uint8_t> &data,
+        std::vector<neblib::TelemetryRecord> &records)
+    {
+        const int version = neblib::telemetry_format::readHeader(data.data(), data.size());
+        if (version != neblib::telemetry_format::version)
+            return false;
+
+        neblib::TelemetryDecoder decoder(version);
+        std::size_t position = neblib::telemetry_format::headerSize;
+        while (position + neblib::telemetry_format::blockHeaderSize <= data.size())
+        {
+            std::uint16_t payloadSize = 0;
+            std::uint16_t count = 0;
+            neblib::telemetry_format::readBlockHeader(data.data() + position, payloadSize, count);
+            position += neblib::telemetry_format::blockHeaderSize;
+            if (position + payloadSize > data.size())
+                return false;
+
+            decoder.reset();
+            std::size_t offset = 0;
+            for (std::uint16_t i = 0; i < count; i++)
+            {
+                neblib::TelemetryRecord record;
+                const std::size_t size = decoder.decode(data.data() + position + offset, payloadSize - offset, record);
+                if (size == 0)
+                    return false;
+                offset += size;
+                records.push_back(record);
+            }
+            if (offset != payloadSize)
+                return false;
+            position += payloadSize;
+        }
+        return position == data.size();
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *fileName = "telemetry_log.bin";
+    int seconds = 120;
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--seconds") == 0)
+            seconds = std::atoi(argv[i + 1]);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--file") == 0)
+            fileName = argv[i + 1];
+        else
+        {
+            fprintf(stderr, "usage: %s [--seconds count] [--file name]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    neblib::sim::World &world = neblib::sim::World::get();
+
+    Log *log = new Log();
+    log->periodMS = 10;
+    log->records = seconds * 1000 / log->periodMS;
+    log->queueDrops = 0;
+    log->pushed.reserve(log->records);
+
+    // ---------- Write ----------
+    neblib::SdTelemetryWriter writer(Brain.SDcard, fileName);
+    if (writer.open() != 0)
+    {
+        fprintf(stderr, "could not open %s\n", fileName);
+        return 1;
+    }
+    neblib::TelemetryLogger logger(log->queue, neblib::SdTelemetryWriter::sink, &writer);
+    neblib::Task<int> writerTask = neblib::spawnTask(std::bind(&neblib::SdTelemetryWriter::begin, &writer), vex::task::taskPriorityLow);
+    neblib::Task<int> loggerTask = neblib::spawnTask(std::bind(&neblib::TelemetryLogger::begin, &logger), vex::task::taskPriorityLow);
+
+    vex::task controlTask(control, log, vex::task::taskPriorityHigh);
+    vex::task::sleep(static_cast<std::uint32_t>(log->records * log->periodMS + 100));
+
+    // Stop in the order a match ends: the logger drains what is left, then the writer flushes it
+    int result = 0;
+    logger.stop();
+    loggerTask.join(result);
+    writer.stop();
+    writerTask.join(result);
+    writer.flush();
+
+    // ---------- Read Back ----------
+    const std::int32_t size = Brain.SDcard.size(fileName);
+    std::vector<std::uint8_t> data((size > 0) ? size : 0);
+    const bool loaded = size > 0 && Brain.SDcard.loadfile(fileName, data.data(), size) == size;
+    std::remove(fileName);
+
+    std::vector<neblib::TelemetryRecord> decoded;
+    decoded.reserve(log->pushed.size());
+    const bool intact = loaded && decodeLog(data, decoded);
+
+    std::size_t mismatches = 0;
+    std::size_t firstMismatch = 0;
+    for (std::size_t i = 0; i < decoded.size() && i < log->pushed.size(); i++)
+    {
+        if (!same(decoded[i], log->pushed[i]))
+        {
+            if (mismatches == 0)
+                firstMismatch = i;
+            mismatches++;
+        }
+    }
+
+    const bool ok = intact &&
+                    log->queueDrops == 0 &&
+                    writer.getDropped() == 0 &&
+                    writer.getWriteErrors() == 0 &&
+                    decoded.size() == static_cast<std::size_t>(log->records) &&
+                    writer.getWritten() == static_cast<std::uint32_t>(log->records) &&
+                    mismatches == 0;
+
+    printf("%d s at %d Hz: %d records made, %zu pushed, %u written, %u dropped by the writer\n",
+           seconds,
+           1000 / log->periodMS,
+           log->records,
+           log->pushed.size(),
+           writer.getWritten(),
+           writer.getDropped());
+    printf("log %d bytes, %.1f bytes per record, longest block write %u us\n",
+           size,
+           decoded.empty() ? 0.0 : static_cast<double>(size) / decoded.size(),
+           writer.getMaxFlushTime());
+    printf("read back %zu records%s, %zu differ from what was pushed",
+           decoded.size(),
+           intact ? "" : " from a damaged log",
+           mismatches);
+    if (mismatches > 0)
+        printf(", first at %zu", firstMismatch);
+    printf("\n%s\n", ok ? "ok" : "FAILED");
+
+    printf("\nsimulated %.2f s at %.0fx real time\n", world.time() / 1e6, world.realTimeFactor());
+    return ok ? 0 : 1;
+}
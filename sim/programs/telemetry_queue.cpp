@@ -0,0 +1,192 @@
+// Stress test of neblib::SpscQueue with a real producer thread and consumer thread
+//
+//   make -C sim && sim/build/bin/telemetry_queue [--records count]
+//
+// Unlike the rest of the simulator this runs on host threads, so both ends
+// of the queue really run at the same time. The lossless pass retries every
+// full push and checks that the consumer sees every record exactly once and
+// in order. The overflow pass never retries and drains slowly, so records
+// are dropped; the consumer must still see them in increasing order, and
+// every record pushed must be either drained or counted as dropped. Every
+// record carries fields derived from its sequence number, so a torn copy is
+// caught too. Exits with 1 on any failure.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include "neblib/telemetry.hpp"
+
+namespace
+{
+    /// @brief Result of one pass
+    ///
+    /// attempts: Number of push() calls made
+    /// drained: Number of records the consumer popped
+    /// errors: Number of records out of order or with fields not matching their sequence number
+    struct Result
+    {
+        std::uint32_t attempts;
+        std::uint32_t drained;
+        std::uint32_t errors;
+        double elapsedMS;
+    };
+
+    neblib::TelemetryRecord makeRecord(std::uint32_t sequence)
+    {
+        neblib::TelemetryRecord record;
+        record.time = sequence;
+        record.source = static_cast<std::uint16_t>(sequence % 5);
+        record.loopTime = static_cast<std::uint16_t>(sequence);
+        record.x = static_cast<float>(sequence & 0xFFFF);
+        record.y = static_cast<float>(sequence >> 16);
+        record.angularOutput = static_cast<float>(sequence % 1000);
+        return record;
+    }
+
+    bool matches(const neblib::TelemetryRecord &record)
+    {
+        const neblib::TelemetryRecord expected = makeRecord(record.time);
+        return record.source == expected.source &&
+               record.loopTime == expected.loopTime &&
+               record.x == expected.x &&
+               record.y == expected.y &&
+               record.angularOutput == expected.angularOutput;
+    }
+
+    /// @brief Pushes records numbered 0 to count - 1 from one thread while another drains them
+    ///
+    /// @param queue empty queue
+    /// @param count number of records to push
+    /// @param lossless true to retry full pushes until they succeed, false to drop them
+    /// @param consumerDelayUS time (us) the consumer sleeps whenever the queue is empty or every 64 records
+    Result run(
+        neblib::TelemetryQueue &queue,
+        std::uint32_t count,
+        bool lossless,
+        int consumerDelayUS)
+    {
+        Result result = Result();
+        std::atomic<bool> producing(true);
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::thread consumer([&]()
+                             {
+            bool first = true;
+            std::uint32_t previous = 0;
+            neblib::TelemetryRecord record;
+            while (true)
+            {
+                const bool done = !producing.load();
+                bool popped = false;
+                while (queue.pop(record))
+                {
+                    popped = true;
+                    // Lossless must be consecutive, overflow only increasing
+                    const bool ordered = first || (lossless ? record.time == previous + 1 : record.time > previous);
+                    if (!ordered || !matches(record))
+                        result.errors++;
+                    first = false;
+                    previous = record.time;
+                    result.drained++;
+                    if (consumerDelayUS > 0 && result.drained % 64 == 0)
+                        std::this_thread::sleep_for(std::chrono::microseconds(consumerDelayUS));
+                }
+                // The producer stopped before this drain began, so nothing is left
+                if (done)
+                    break;
+                if (popped)
+                    continue;
+                if (consumerDelayUS > 0)
+                    std::this_thread::sleep_for(std::chrono::microseconds(consumerDelayUS));
+                else
+                    std::this_thread::yield();
+            } });
+
+        for (std::uint32_t i = 0; i < count; i++)
+        {
+            result.attempts++;
+            while (!queue.push(makeRecord(i)) && lossless)
+            {
+                // Let the consumer run when both threads share a core
+                std::this_thread::yield();
+                result.attempts++;
+            }
+        }
+        producing.store(false);
+        consumer.join();
+
+        result.elapsedMS = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    /// @brief Prints a pass and checks that every push was either drained or dropped
+    ///
+    /// @return true if the pass succeeded
+    bool report(
+        const char *name,
+        const neblib::TelemetryQueue &queue,
+        const Result &result,
+        std::uint32_t count,
+        bool lossless)
+    {
+        const std::uint32_t pushed = queue.getPushed();
+        const std::uint32_t dropped = queue.getDropped();
+        bool ok = result.errors == 0 &&
+                  pushed == result.drained &&
+                  pushed + dropped == result.attempts;
+        if (lossless)
+            ok = ok && pushed == count;
+        else
+            ok = ok && result.attempts == count;
+
+        printf("%-9s %10u pushed %10u drained %10u dropped %6u errors %9.1f ms  %s\n",
+               name,
+               pushed,
+               result.drained,
+               dropped,
+               result.errors,
+               result.elapsedMS,
+               ok ? "ok" : "FAILED");
+        return ok;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::uint32_t count = 2000000;
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--records") == 0)
+            count = static_cast<std::uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        else
+        {
+            fprintf(stderr, "usage: %s [--records count]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("neblib::TelemetryQueue, capacity %zu, %u records per pass\n\n",
+           neblib::TelemetryQueue::capacity(),
+           count);
+
+    // Each pass needs a fresh queue, the counters are never reset
+    neblib::TelemetryQueue *lossless = new neblib::TelemetryQueue();
+    const Result losslessResult = run(*lossless, count, true, 0);
+    bool ok = report("lossless", *lossless, losslessResult, count, true);
+    delete lossless;
+
+    neblib::TelemetryQueue *overflow = new neblib::TelemetryQueue();
+    const Result overflowResult = run(*overflow, count, false, 20);
+    ok = report("overflow", *overflow, overflowResult, count, false) && ok;
+    if (overflow->getDropped() == 0)
+    {
+        printf("overflow pass never filled the queue\n");
+        ok = false;
+    }
+    delete overflow;
+
+    return ok ? 0 : 1;
+}
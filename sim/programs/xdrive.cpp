@@ -0,0 +1,137 @@
+// Drives the X-drive from src/main.cpp through a short autonomous in the simulator
+// and compares odometry to the simulated pose.
+//
+//   make -C sim && sim/build/bin/xdrive
+
+#include <cstdio>
+#include <functional>
+#include "vex.h"
+#include "neblib/xdrive.hpp"
+#include "neblib/devices/tracker_wheel.hpp"
+#include "neblib/sim/world.hpp"
+
+vex::motor frontLeftTop = vex::motor(vex::PORT1, vex::ratio6_1, false);
+vex::motor frontLeftBottom = vex::motor(vex::PORT2, vex::ratio6_1, true);
+vex::motor frontRightTop = vex::motor(vex::PORT4, vex::ratio6_1, true);
+vex::motor frontRightBottom = vex::motor(vex::PORT3, vex::ratio6_1, false);
+vex::motor backLeftTop = vex::motor(vex::PORT18, vex::ratio6_1, false);
+vex::motor backLeftBottom = vex::motor(vex::PORT17, vex::ratio6_1, true);
+vex::motor backRightTop = vex::motor(vex::PORT13, vex::ratio6_1, true);
+vex::motor backRightBottom = vex::motor(vex::PORT12, vex::ratio6_1, false);
+
+vex::motor_group leftFront(frontLeftTop, frontLeftBottom);
+vex::motor_group rightFront(frontRightTop, frontRightBottom);
+vex::motor_group leftBack(backLeftTop, backLeftBottom);
+vex::motor_group rightBack(backRightTop, backRightBottom);
+
+vex::inertial imu(vex::PORT10, vex::turnType::right);
+vex::rotation parallelRotation(vex::PORT6, true);
+vex::rotation perpendicularRotation(vex::PORT8, true);
+
+neblib::RotationTrackerWheel parallel(
+    parallelRotation,
+    2.05);
+neblib::RotationTrackerWheel perpendicular(
+    perpendicularRotation,
+    2.0119);
+
+neblib::Odometry odom(
+    parallel,
+    -4.0,
+    perpendicular,
+    0.0,
+    imu);
+neblib::XDrive xDrive(
+    leftFront,
+    rightFront,
+    leftBack,
+    rightBack,
+    imu,
+    &odom);
+
+neblib::PID linearPID(
+    neblib::PID::Gains(
+        0.4,
+        0.005,
+        0.8,
+        0.45),
+    neblib::PID::Behaviors(
+        12.0,
+        true),
+    neblib::PID::ExitConditions(
+        0.25,
+        30));
+
+neblib::PID angularPID(
+    neblib::PID::Gains(
+        0.15,
+        0.005,
+        0.2),
+    neblib::PID::Behaviors(
+        15.0,
+        true),
+    neblib::PID::ExitConditions(
+        0.5,
+        50));
+
+void report(
+    const char *motion,
+    int result,
+    neblib::sim::ChassisModel &chassis)
+{
+    const neblib::sim::ChassisModel::State actual = chassis.getState();
+    const neblib::Pose estimate = odom.getPose();
+    printf("%-24s %6d ms   actual %7.2f %7.2f %7.2f   odom %7.2f %7.2f %7.2f\n",
+           motion,
+           result,
+           actual.x,
+           actual.y,
+           actual.heading,
+           estimate.x,
+           estimate.y,
+           estimate.heading);
+}
+
+int main()
+{
+    neblib::sim::World &world = neblib::sim::World::get();
+
+    // 12 in square wheelbase, 3.25 in omni wheels geared 600 to 450 rpm
+    neblib::sim::ChassisModel chassis = neblib::sim::ChassisModel::xDrive(
+        {vex::PORT1, vex::PORT2},
+        {vex::PORT4, vex::PORT3},
+        {vex::PORT18, vex::PORT17},
+        {vex::PORT13, vex::PORT12},
+        12.0,
+        12.0,
+        3.25,
+        0.75);
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(-4.0, 0.0, 0.0, 2.05, vex::PORT6));
+    chassis.addTracker(neblib::sim::ChassisModel::Tracker(0.0, 0.0, 90.0, 2.0119, vex::PORT8));
+    chassis.setImu(vex::PORT10);
+    chassis.setPose(0.0, 0.0, 90.0);
+    world.setChassis(&chassis);
+
+    odom.calibrate();
+    odom.setPose(
+        0.0,
+        0.0,
+        90.0);
+    neblib::Task<int> odomTask = neblib::spawnTask(std::bind(&neblib::Odometry::begin, &odom), vex::task::taskPriorityHigh);
+    xDrive.setLinearController(&linearPID);
+    xDrive.setAngularController(&angularPID);
+
+    report("start", 0, chassis);
+    report("driveToPose(23.5, 0, 90)", xDrive.driveToPose(23.5, 0.0, 90.0, 2500), chassis);
+    report("turnTo(180)", xDrive.turnTo(180.0, 2000), chassis);
+    report("driveToPose(23.5, -24, 180)", xDrive.driveToPose(23.5, -24.0, 180.0, 2500), chassis);
+    report("driveToPose(0, 0, 90)", xDrive.driveToPose(0.0, 0.0, 90.0, 3000), chassis);
+    xDrive.stop(vex::brakeType::coast);
+    odom.stop();
+
+    printf("\nsimulated %.2f s at %.0fx real time, battery %.2f V\n",
+           world.time() / 1e6,
+           world.realTimeFactor(),
+           world.getBatteryVoltage());
+    return 0;
+}
@@ -0,0 +1,281 @@
+#include "neblib/sim/benchmark.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define NEBLIB_HAS_CYCLES 1
+#endif
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    std::uint64_t readCycles()
+    {
+#if defined(NEBLIB_HAS_CYCLES)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    /// @brief Percentile of sorted values, interpolating between neighbours
+    double percentile(
+        const std::vector<double> &sorted,
+        double fraction)
+    {
+        if (sorted.empty())
+            return 0.0;
+        const double position = fraction * (sorted.size() - 1);
+        const std::size_t index = static_cast<std::size_t>(position);
+        if (index + 1 >= sorted.size())
+            return sorted.back();
+        return sorted[index] + (sorted[index + 1] - sorted[index]) * (position - index);
+    }
+} // namespace
+
+neblib::sim::Benchmark::Result::Result()
+    : name(""),
+      median(0.0),
+      mean(0.0),
+      min(0.0),
+      max(0.0),
+      stddev(0.0),
+      cycles(-1.0),
+      iterations(0),
+      samples(0),
+      outliers(0)
+{
+}
+
+neblib::sim::Benchmark::Benchmark(
+    int sampleCount,
+    double warmupTime,
+    double sampleTime)
+    : sampleCount((sampleCount > 4) ? sampleCount : 4),
+      warmupTime(warmupTime),
+      sampleTime(sampleTime)
+{
+}
+
+void neblib::sim::Benchmark::add(
+    const char *name,
+    Function function,
+    void *context)
+{
+    Case benchmark;
+    benchmark.name = name;
+    benchmark.function = function;
+    benchmark.context = context;
+    cases.push_back(benchmark);
+}
+
+neblib::sim::Benchmark::Result neblib::sim::Benchmark::run(const Case &benchmark) const
+{
+    // ---------- Warm-up ----------
+    const Clock::time_point warmupStart = Clock::now();
+    std::uint64_t batch = 1;
+    while (std::chrono::duration<double>(Clock::now() - warmupStart).count() < warmupTime)
+    {
+        benchmark.function(batch, benchmark.context);
+        if (batch < (1u << 20))
+            batch *= 2;
+    }
+
+    // ---------- Calibration ----------
+    std::uint64_t iterations = 1;
+    while (iterations < (1ull << 40))
+    {
+        const Clock::time_point start = Clock::now();
+        benchmark.function(iterations, benchmark.context);
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (elapsed >= sampleTime)
+            break;
+
+        double growth = (elapsed > 0.0) ? 1.2 * sampleTime / elapsed : 10.0;
+        growth = std::min(std::max(growth, 2.0), 10.0);
+        iterations = static_cast<std::uint64_t>(std::ceil(iterations * growth));
+    }
+
+    // ---------- Samples ----------
+    std::vector<double> times(sampleCount);
+    std::vector<double> cycles(sampleCount);
+    for (int i = 0; i < sampleCount; i++)
+    {
+        const std::uint64_t cycleStart = readCycles();
+        const Clock::time_point start = Clock::now();
+        benchmark.function(iterations, benchmark.context);
+        const Clock::time_point end = Clock::now();
+        const std::uint64_t cycleEnd = readCycles();
+
+        times[i] = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        cycles[i] = static_cast<double>(cycleEnd - cycleStart) / iterations;
+    }
+
+    // ---------- Outlier Rejection ----------
+    std::vector<double> sorted(times);
+    std::sort(sorted.begin(), sorted.end());
+    const double lowerQuartile = percentile(sorted, 0.25);
+    const double upperQuartile = percentile(sorted, 0.75);
+    const double range = upperQuartile - lowerQuartile;
+    const double lowerFence = lowerQuartile - 1.5 * range;
+    const double upperFence = upperQuartile + 1.5 * range;
+
+    std::vector<double> keptTimes;
+    std::vector<double> keptCycles;
+    for (int i = 0; i < sampleCount; i++)
+    {
+        if (times[i] < lowerFence || times[i] > upperFence)
+            continue;
+        keptTimes.push_back(times[i]);
+        keptCycles.push_back(cycles[i]);
+    }
+
+    // ---------- Statistics ----------
+    Result result;
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    result.samples = static_cast<int>(keptTimes.size());
+    result.outliers = sampleCount - result.samples;
+
+    double sum = 0.0;
+    for (std::size_t i = 0; i < keptTimes.size(); i++)
+        sum += keptTimes[i];
+    result.mean = sum / keptTimes.size();
+
+    double squares = 0.0;
+    for (std::size_t i = 0; i < keptTimes.size(); i++)
+        squares += (keptTimes[i] - result.mean) * (keptTimes[i] - result.mean);
+    result.stddev = (keptTimes.size() > 1) ? std::sqrt(squares / (keptTimes.size() - 1)) : 0.0;
+
+    std::sort(keptTimes.begin(), keptTimes.end());
+    std::sort(keptCycles.begin(), keptCycles.end());
+    result.median = percentile(keptTimes, 0.5);
+    result.min = keptTimes.front();
+    result.max = keptTimes.back();
+#if defined(NEBLIB_HAS_CYCLES)
+    result.cycles = percentile(keptCycles, 0.5);
+#endif
+    return result;
+}
+
+std::vector<neblib::sim::Benchmark::Result> neblib::sim::Benchmark::runAll(const char *filter) const
+{
+    std::vector<Result> results;
+    for (std::size_t i = 0; i < cases.size(); i++)
+    {
+        if (filter && filter[0] != '\0' && !std::strstr(cases[i].name, filter))
+            continue;
+        results.push_back(run(cases[i]));
+    }
+    return results;
+}
+
+void neblib::sim::Benchmark::print(const std::vector<Result> &results)
+{
+    printf("%-32s %10s %10s %10s %10s %10s %12s %8s\n", "case", "median ns", "mean ns", "stddev", "min ns", "cycles", "iterations", "dropped");
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const Result &result = results[i];
+        printf("%-32s %10.2f %10.2f %10.2f %10.2f %10.1f %12llu %8d\n",
+               result.name,
+               result.median,
+               result.mean,
+               result.stddev,
+               result.min,
+               result.cycles,
+               static_cast<unsigned long long>(result.iterations),
+               result.outliers);
+    }
+}
+
+int neblib::sim::Benchmark::writeJson(
+    const std::vector<Result> &results,
+    const char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (!file)
+        return -1;
+
+    fprintf(file, "[\n");
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const Result &result = results[i];
+        fprintf(file,
+                "  {\"name\": \"%s\", \"median_ns\": %.4f, \"mean_ns\": %.4f, \"stddev_ns\": %.4f, \"min_ns\": %.4f, \"max_ns\": %.4f, "
+                "\"cycles\": %.2f, \"iterations\": %llu, \"samples\": %d, \"outliers\": %d}%s\n",
+                result.name,
+                result.median,
+                result.mean,
+                result.stddev,
+                result.min,
+                result.max,
+                result.cycles,
+                static_cast<unsigned long long>(result.iterations),
+                result.samples,
+                result.outliers,
+                (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(file, "]\n");
+    fclose(file);
+    return 0;
+}
+
+int neblib::sim::Benchmark::compare(
+    const std::vector<Result> &results,
+    const char *fileName,
+    double threshold)
+{
+    FILE *file = fopen(fileName, "r");
+    if (!file)
+        return -1;
+
+    // Each case is on its own line, so a line scan is all the parsing needed
+    std::vector<std::pair<std::string, double>> baseline;
+    char line[512];
+    while (fgets(line, sizeof(line), file))
+    {
+        const char *name = std::strstr(line, "\"name\": \"");
+        const char *median = std::strstr(line, "\"median_ns\": ");
+        if (!name || !median)
+            continue;
+        name += std::strlen("\"name\": \"");
+        const char *nameEnd = std::strchr(name, '"');
+        if (!nameEnd)
+            continue;
+        baseline.push_back(std::make_pair(std::string(name, nameEnd), std::strtod(median + std::strlen("\"median_ns\": "), nullptr)));
+    }
+    fclose(file);
+
+    int regressions = 0;
+    printf("\n%-32s %12s %12s %9s\n", "case", "baseline ns", "current ns", "change");
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const Result &result = results[i];
+        for (std::size_t j = 0; j < baseline.size(); j++)
+        {
+            if (baseline[j].first != result.name || baseline[j].second <= 0.0)
+                continue;
+
+            const double change = 100.0 * (result.median - baseline[j].second) / baseline[j].second;
+            const bool regressed = change > threshold;
+            if (regressed)
+                regressions++;
+            printf("%-32s %12.2f %12.2f %+8.1f%%%s\n",
+                   result.name,
+                   baseline[j].second,
+                   result.median,
+                   change,
+                   regressed ? "  REGRESSION" : "");
+            break;
+        }
+    }
+    return regressions;
+}
@@ -0,0 +1,318 @@
+#include "neblib/sim/chassis_model.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const double metersPerInch = 0.0254;
+    const double gravity = 9.81;
+} // namespace
+
+neblib::sim::ChassisModel::Body::Body(
+    double mass,
+    double inertia,
+    double rollingResistance,
+    double linearDamping,
+    double angularDamping)
+    : mass(mass),
+      inertia(inertia),
+      rollingResistance(rollingResistance),
+      linearDamping(linearDamping),
+      angularDamping(angularDamping)
+{
+}
+
+neblib::sim::ChassisModel::Wheel::Wheel(
+    double x,
+    double y,
+    double angle,
+    double diameter,
+    double gearRatio,
+    std::initializer_list<int> ports)
+    : x(x),
+      y(y),
+      angle(angle),
+      diameter(diameter),
+      gearRatio(gearRatio),
+      ports(ports)
+{
+}
+
+neblib::sim::ChassisModel::Tracker::Tracker(
+    double x,
+    double y,
+    double angle,
+    double diameter,
+    int port)
+    : x(x),
+      y(y),
+      angle(angle),
+      diameter(diameter),
+      port(port)
+{
+}
+
+neblib::sim::ChassisModel::State::State()
+    : x(0.0),
+      y(0.0),
+      heading(0.0),
+      xVelocity(0.0),
+      yVelocity(0.0),
+      angularVelocity(0.0)
+{
+}
+
+neblib::sim::ChassisModel::Noise::Noise(
+    double traction,
+    double trackerScale,
+    double imuScale,
+    double imuDrift,
+    double trackerSlip,
+    double imuNoise)
+    : traction(traction),
+      trackerScale(trackerScale),
+      imuScale(imuScale),
+      imuDrift(imuDrift),
+      trackerSlip(trackerSlip),
+      imuNoise(imuNoise)
+{
+}
+
+neblib::sim::ChassisModel::ChassisModel(
+    Body body,
+    bool lateralGrip)
+    : body(body),
+      lateralGrip(lateralGrip),
+      imuPort(-1),
+      x(0.0),
+      y(0.0),
+      theta(0.0),
+      xVelocity(0.0),
+      yVelocity(0.0),
+      omega(0.0),
+      noise(),
+      random(0),
+      imuScale(1.0),
+      imuBias(0.0)
+{
+}
+
+neblib::sim::ChassisModel neblib::sim::ChassisModel::differential(
+    std::initializer_list<int> leftPorts,
+    std::initializer_list<int> rightPorts,
+    double trackWidth,
+    double wheelDiameter,
+    double gearRatio,
+    Body body)
+{
+    ChassisModel chassis(body, true);
+    chassis.addWheel(Wheel(-trackWidth / 2.0, 0.0, 0.0, wheelDiameter, gearRatio, leftPorts));
+    chassis.addWheel(Wheel(trackWidth / 2.0, 0.0, 0.0, wheelDiameter, gearRatio, rightPorts));
+    return chassis;
+}
+
+neblib::sim::ChassisModel neblib::sim::ChassisModel::xDrive(
+    std::initializer_list<int> leftFrontPorts,
+    std::initializer_list<int> rightFrontPorts,
+    std::initializer_list<int> leftBackPorts,
+    std::initializer_list<int> rightBackPorts,
+    double width,
+    double length,
+    double wheelDiameter,
+    double gearRatio,
+    Body body)
+{
+    ChassisModel chassis(body, false);
+    chassis.addWheel(Wheel(-width / 2.0, length / 2.0, 45.0, wheelDiameter, gearRatio, leftFrontPorts));
+    chassis.addWheel(Wheel(width / 2.0, length / 2.0, -45.0, wheelDiameter, gearRatio, rightFrontPorts));
+    chassis.addWheel(Wheel(-width / 2.0, -length / 2.0, -45.0, wheelDiameter, gearRatio, leftBackPorts));
+    chassis.addWheel(Wheel(width / 2.0, -length / 2.0, 45.0, wheelDiameter, gearRatio, rightBackPorts));
+    return chassis;
+}
+
+void neblib::sim::ChassisModel::addWheel(const Wheel &wheel)
+{
+    wheels.push_back(wheel);
+}
+
+void neblib::sim::ChassisModel::addTracker(const Tracker &tracker)
+{
+    trackers.push_back(tracker);
+}
+
+void neblib::sim::ChassisModel::setImu(int port)
+{
+    imuPort = port;
+}
+
+void neblib::sim::ChassisModel::setPose(
+    double x,
+    double y,
+    double heading)
+{
+    this->x = x * metersPerInch;
+    this->y = y * metersPerInch;
+    theta = heading * M_PI / 180.0;
+    xVelocity = 0.0;
+    yVelocity = 0.0;
+    omega = 0.0;
+}
+
+neblib::sim::ChassisModel::State neblib::sim::ChassisModel::getState() const
+{
+    State state;
+    state.x = x / metersPerInch;
+    state.y = y / metersPerInch;
+    state.heading = theta * 180.0 / M_PI;
+    state.xVelocity = xVelocity / metersPerInch;
+    state.yVelocity = yVelocity / metersPerInch;
+    state.angularVelocity = omega * 180.0 / M_PI;
+    return state;
+}
+
+void neblib::sim::ChassisModel::setNoise(
+    const Noise &noise,
+    std::uint32_t seed)
+{
+    this->noise = noise;
+    random.seed(seed);
+
+    wheelTraction.resize(wheels.size());
+    for (std::size_t i = 0; i < wheels.size(); i++)
+        wheelTraction[i] = 1.0 - std::min(std::abs(random.gauss() * noise.traction), 0.9);
+    trackerScale.resize(trackers.size());
+    for (std::size_t i = 0; i < trackers.size(); i++)
+        trackerScale[i] = 1.0 + random.gauss() * noise.trackerScale;
+    imuScale = 1.0 + random.gauss() * noise.imuScale;
+    imuBias = random.gauss() * noise.imuDrift;
+}
+
+void neblib::sim::ChassisModel::attach(neblib::sim::Ports &ports) const
+{
+    for (std::size_t i = 0; i < wheels.size(); i++)
+        for (std::size_t j = 0; j < wheels[i].ports.size(); j++)
+            ports.motors[wheels[i].ports[j]].attached = true;
+}
+
+double neblib::sim::ChassisModel::pointSpeed(
+    double forward,
+    double right,
+    double px,
+    double py,
+    double angle) const
+{
+    // A clockwise turn moves a point at (px, py) with velocity omega * (py, -px)
+    const double dx = std::sin(angle);
+    const double dy = std::cos(angle);
+    return dx * (right + omega * py) + dy * (forward - omega * px);
+}
+
+void neblib::sim::ChassisModel::step(
+    double dt,
+    double supplyVoltage,
+    neblib::sim::Ports &ports)
+{
+    // ---------- Body Velocity ----------
+    double sine = std::sin(theta);
+    double cosine = std::cos(theta);
+    double right = xVelocity * cosine - yVelocity * sine;
+    double forward = xVelocity * sine + yVelocity * cosine;
+
+    // ---------- Wheel Forces ----------
+    double forceRight = 0.0;
+    double forceForward = 0.0;
+    double torque = 0.0;
+    for (std::size_t i = 0; i < wheels.size(); i++)
+    {
+        const Wheel &wheel = wheels[i];
+        const double px = wheel.x * metersPerInch;
+        const double py = wheel.y * metersPerInch;
+        const double angle = wheel.angle * M_PI / 180.0;
+        const double radius = wheel.diameter * metersPerInch / 2.0;
+        const double shaftSpeed = pointSpeed(forward, right, px, py, angle) / radius / wheel.gearRatio;
+
+        double wheelTorque = 0.0;
+        for (std::size_t j = 0; j < wheel.ports.size(); j++)
+        {
+            neblib::sim::MotorPort &motor = ports.motors[wheel.ports[j]];
+            motor.speed = shaftSpeed;
+            motor.update(supplyVoltage);
+            wheelTorque += motor.torque;
+        }
+
+        double force = wheelTorque / wheel.gearRatio / radius;
+        if (i < wheelTraction.size())
+            force *= wheelTraction[i];
+        const double dx = std::sin(angle);
+        const double dy = std::cos(angle);
+        forceRight += force * dx;
+        forceForward += force * dy;
+        torque += force * (dx * py - dy * px);
+    }
+
+    // ---------- Friction ----------
+    // Smoothed around zero speed so a robot at rest does not chatter
+    const double weight = body.mass * gravity;
+    const double speed = std::hypot(right, forward);
+    if (speed > 1e-9)
+    {
+        const double rolling = body.rollingResistance * weight * std::tanh(speed / 0.02) / speed;
+        forceRight -= rolling * right;
+        forceForward -= rolling * forward;
+    }
+    forceRight -= body.linearDamping * right;
+    forceForward -= body.linearDamping * forward;
+    const double gyrationRadius = std::sqrt(body.inertia / body.mass);
+    torque -= body.rollingResistance * weight * gyrationRadius * std::tanh(omega / 0.05);
+    torque -= body.angularDamping * omega;
+
+    // ---------- Integrate ----------
+    right += forceRight / body.mass * dt;
+    forward += forceForward / body.mass * dt;
+    if (lateralGrip)
+        right = 0.0;
+    omega += torque / body.inertia * dt;
+
+    xVelocity = right * cosine + forward * sine;
+    yVelocity = -right * sine + forward * cosine;
+    x += xVelocity * dt;
+    y += yVelocity * dt;
+    theta += omega * dt;
+
+    // ---------- Motor Shafts ----------
+    for (std::size_t i = 0; i < wheels.size(); i++)
+    {
+        const Wheel &wheel = wheels[i];
+        const double radius = wheel.diameter * metersPerInch / 2.0;
+        const double shaftSpeed = pointSpeed(forward, right, wheel.x * metersPerInch, wheel.y * metersPerInch, wheel.angle * M_PI / 180.0) / radius / wheel.gearRatio;
+        for (std::size_t j = 0; j < wheel.ports.size(); j++)
+        {
+            neblib::sim::MotorPort &motor = ports.motors[wheel.ports[j]];
+            motor.speed = shaftSpeed;
+            motor.position += shaftSpeed * dt * 180.0 / M_PI;
+        }
+    }
+
+    // ---------- Sensors ----------
+    for (std::size_t i = 0; i < trackers.size(); i++)
+    {
+        const Tracker &tracker = trackers[i];
+        double rollingSpeed = pointSpeed(forward, right, tracker.x * metersPerInch, tracker.y * metersPerInch, tracker.angle * M_PI / 180.0);
+        if (i < trackerScale.size())
+            rollingSpeed *= trackerScale[i];
+        if (noise.trackerSlip > 0.0)
+            rollingSpeed *= 1.0 + random.gauss() * noise.trackerSlip;
+        neblib::sim::RotationPort &rotation = ports.rotations[tracker.port];
+        rotation.speed = rollingSpeed / (M_PI * tracker.diameter * metersPerInch) * 360.0;
+        rotation.position += rotation.speed * dt;
+    }
+
+    if (imuPort >= 0)
+    {
+        neblib::sim::InertialPort &imu = ports.inertials[imuPort];
+        imu.rate = omega * 180.0 / M_PI * imuScale + imuBias;
+        if (noise.imuNoise > 0.0)
+            imu.rate += random.gauss() * noise.imuNoise;
+        imu.rotation += imu.rate * dt;
+    }
+}
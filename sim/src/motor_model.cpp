@@ -0,0 +1,74 @@
+#include "neblib/sim/motor_model.hpp"
+#include <cmath>
+
+neblib::sim::MotorModel::Parameters::Parameters(
+    double stallTorque,
+    double freeSpeed,
+    double stallCurrent,
+    double currentLimit,
+    double nominalVoltage,
+    double frictionTorque)
+    : stallTorque(stallTorque),
+      freeSpeed(freeSpeed),
+      stallCurrent(stallCurrent),
+      currentLimit(currentLimit),
+      nominalVoltage(nominalVoltage),
+      frictionTorque(frictionTorque)
+{
+}
+
+neblib::sim::MotorModel::Parameters neblib::sim::MotorModel::Parameters::v5(double freeSpeed)
+{
+    // 2.1 N*m at 100 rpm, scaled by the cartridge
+    const double stallTorque = 2.1 * 100.0 / freeSpeed;
+    return Parameters(
+        stallTorque,
+        freeSpeed,
+        2.5,
+        2.5,
+        12.0,
+        0.02 * stallTorque);
+}
+
+neblib::sim::MotorModel::MotorModel(Parameters parameters)
+    : parameters(parameters),
+      resistance(parameters.nominalVoltage / parameters.stallCurrent),
+      torqueConstant(parameters.stallTorque / parameters.stallCurrent),
+      backEmfConstant(parameters.nominalVoltage / (parameters.freeSpeed * 2.0 * M_PI / 60.0))
+{
+}
+
+const neblib::sim::MotorModel::Parameters &neblib::sim::MotorModel::getParameters() const
+{
+    return parameters;
+}
+
+double neblib::sim::MotorModel::freeSpeed() const
+{
+    return parameters.freeSpeed * 2.0 * M_PI / 60.0;
+}
+
+double neblib::sim::MotorModel::current(
+    double voltage,
+    double speed) const
+{
+    const double current = (voltage - backEmfConstant * speed) / resistance;
+    if (current > parameters.currentLimit)
+        return parameters.currentLimit;
+    if (current < -parameters.currentLimit)
+        return -parameters.currentLimit;
+    return current;
+}
+
+double neblib::sim::MotorModel::shortedCurrent(double speed) const
+{
+    return current(0.0, speed);
+}
+
+double neblib::sim::MotorModel::torque(
+    double current,
+    double speed) const
+{
+    // Smoothed around zero speed so a stopped motor does not chatter
+    return torqueConstant * current - parameters.frictionTorque * std::tanh(speed / 0.5);
+}
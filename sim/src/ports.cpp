@@ -0,0 +1,97 @@
+#include "neblib/sim/ports.hpp"
+#include <cmath>
+
+constexpr int neblib::sim::Ports::count;
+constexpr int neblib::sim::Ports::threeWireCount;
+
+neblib::sim::MotorPort::MotorPort()
+    : connected(false),
+      attached(false),
+      model(),
+      mode(Coast),
+      command(0.0),
+      holdPosition(0.0),
+      position(0.0),
+      positionOffset(0.0),
+      speed(0.0),
+      voltage(0.0),
+      current(0.0),
+      torque(0.0),
+      loadInertia(5e-4)
+{
+}
+
+void neblib::sim::MotorPort::update(double supplyVoltage)
+{
+    // ---------- Control Mode ----------
+    const double nominal = model.getParameters().nominalVoltage;
+    double target = 0.0;
+    switch (mode)
+    {
+    case Coast:
+        voltage = 0.0;
+        current = 0.0;
+        torque = model.torque(0.0, speed);
+        return;
+    case Brake:
+        voltage = 0.0;
+        current = model.shortedCurrent(speed);
+        torque = model.torque(current, speed);
+        return;
+    case Hold:
+        // Position loop run by the motor firmware
+        target = 10.0 * (holdPosition - position) * M_PI / 180.0 - 0.2 * speed;
+        break;
+    case Voltage:
+        target = command;
+        break;
+    case Velocity:
+    {
+        // Feedforward plus a proportional velocity loop, like the motor firmware
+        const double targetSpeed = command * 2.0 * M_PI / 60.0;
+        target = nominal * targetSpeed / model.freeSpeed() + 4.0 * nominal / model.freeSpeed() * (targetSpeed - speed);
+        break;
+    }
+    }
+
+    // ---------- Supply Limit ----------
+    const double limit = (supplyVoltage < nominal) ? supplyVoltage : nominal;
+    if (target > limit)
+        target = limit;
+    if (target < -limit)
+        target = -limit;
+
+    voltage = target;
+    current = model.current(voltage, speed);
+    torque = model.torque(current, speed);
+}
+
+void neblib::sim::MotorPort::integrate(double dt)
+{
+    speed += torque / loadInertia * dt;
+    position += speed * dt * 180.0 / M_PI;
+}
+
+neblib::sim::RotationPort::RotationPort()
+    : connected(false),
+      position(0.0),
+      offset(0.0),
+      speed(0.0)
+{
+}
+
+neblib::sim::InertialPort::InertialPort()
+    : connected(false),
+      rotation(0.0),
+      rate(0.0),
+      headingOffset(0.0),
+      rotationOffset(0.0),
+      calibrationEnd(0)
+{
+}
+
+neblib::sim::Ports::Ports()
+{
+    for (int i = 0; i < threeWireCount; i++)
+        threeWire[i] = false;
+}
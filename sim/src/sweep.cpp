@@ -0,0 +1,197 @@
+#include "neblib/sim/sweep.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include "neblib/sim/world.hpp"
+
+namespace
+{
+    /// @brief Percentile of sorted values, interpolating between neighbours
+    double percentile(
+        const std::vector<double> &sorted,
+        double fraction)
+    {
+        if (sorted.empty())
+            return 0.0;
+        const double position = fraction * (sorted.size() - 1);
+        const std::size_t index = static_cast<std::size_t>(position);
+        if (index + 1 >= sorted.size())
+            return sorted.back();
+        return sorted[index] + (sorted[index + 1] - sorted[index]) * (position - index);
+    }
+
+    neblib::sim::Sweep::Distribution distribution(std::vector<double> values)
+    {
+        neblib::sim::Sweep::Distribution result;
+        if (values.empty())
+            return result;
+
+        double sum = 0.0;
+        for (std::size_t i = 0; i < values.size(); i++)
+            sum += values[i];
+        result.mean = sum / values.size();
+
+        double squares = 0.0;
+        for (std::size_t i = 0; i < values.size(); i++)
+            squares += (values[i] - result.mean) * (values[i] - result.mean);
+        result.stddev = (values.size() > 1) ? std::sqrt(squares / (values.size() - 1)) : 0.0;
+
+        std::sort(values.begin(), values.end());
+        result.min = values.front();
+        result.median = percentile(values, 0.5);
+        result.p90 = percentile(values, 0.9);
+        result.p99 = percentile(values, 0.99);
+        result.max = values.back();
+        return result;
+    }
+
+    void printDistribution(
+        const char *name,
+        const neblib::sim::Sweep::Distribution &distribution)
+    {
+        printf("%-16s %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+               name,
+               distribution.mean,
+               distribution.stddev,
+               distribution.min,
+               distribution.median,
+               distribution.p90,
+               distribution.p99,
+               distribution.max);
+    }
+} // namespace
+
+neblib::sim::Sweep::Run::Run()
+    : seed(0),
+      success(false),
+      time(0.0),
+      positionError(0.0),
+      headingError(0.0)
+{
+}
+
+neblib::sim::Sweep::Distribution::Distribution()
+    : mean(0.0),
+      stddev(0.0),
+      min(0.0),
+      median(0.0),
+      p90(0.0),
+      p99(0.0),
+      max(0.0)
+{
+}
+
+neblib::sim::Sweep::Summary::Summary()
+    : runs(0),
+      successes(0),
+      successRate(0.0)
+{
+}
+
+neblib::sim::Sweep::Sweep(int threadCount)
+    : pool(threadCount),
+      leakedWorlds(0)
+{
+}
+
+int neblib::sim::Sweep::threads() const
+{
+    return pool.size();
+}
+
+std::size_t neblib::sim::Sweep::getLeakedWorlds() const
+{
+    return leakedWorlds.load();
+}
+
+std::uint32_t neblib::sim::Sweep::runSeed(
+    std::uint32_t seed,
+    std::size_t index)
+{
+    // SplitMix64 finalizer, so neighbouring runs get unrelated seeds
+    std::uint64_t z = (static_cast<std::uint64_t>(seed) << 32) + index + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<std::uint32_t>((z ^ (z >> 31)) >> 16);
+}
+
+void neblib::sim::Sweep::runOne(
+    std::size_t index,
+    void *context)
+{
+    Job &job = *static_cast<Job *>(context);
+    Run &run = (*job.runs)[index];
+    run.seed = runSeed(job.seed, index);
+
+    neblib::sim::World *world = neblib::sim::World::create();
+    neblib::sim::World::makeCurrent(world);
+    job.function(run.seed, run, job.context);
+    neblib::sim::World::makeCurrent(nullptr);
+
+    if (!neblib::sim::World::destroy(world))
+        job.sweep->leakedWorlds++;
+}
+
+std::vector<neblib::sim::Sweep::Run> neblib::sim::Sweep::run(
+    std::size_t count,
+    std::uint32_t seed,
+    Function function,
+    void *context)
+{
+    std::vector<Run> runs(count);
+    Job job;
+    job.sweep = this;
+    job.function = function;
+    job.context = context;
+    job.seed = seed;
+    job.runs = &runs;
+    pool.run(count, runOne, &job);
+    return runs;
+}
+
+neblib::sim::Sweep::Summary neblib::sim::Sweep::summarize(const std::vector<Run> &runs)
+{
+    Summary summary;
+    summary.runs = runs.size();
+
+    std::vector<double> times;
+    std::vector<double> positionErrors;
+    std::vector<double> headingErrors;
+    for (std::size_t i = 0; i < runs.size(); i++)
+    {
+        if (runs[i].success)
+            summary.successes++;
+        times.push_back(runs[i].time);
+        positionErrors.push_back(runs[i].positionError);
+        headingErrors.push_back(runs[i].headingError);
+    }
+    summary.successRate = runs.empty() ? 0.0 : static_cast<double>(summary.successes) / runs.size();
+    summary.time = distribution(times);
+    summary.positionError = distribution(positionErrors);
+    summary.headingError = distribution(headingErrors);
+    return summary;
+}
+
+void neblib::sim::Sweep::print(const Summary &summary)
+{
+    printf("%zu runs, %zu succeeded (%.1f%%)\n\n", summary.runs, summary.successes, 100.0 * summary.successRate);
+    printf("%-16s %9s %9s %9s %9s %9s %9s %9s\n", "", "mean", "stddev", "min", "median", "p90", "p99", "max");
+    printDistribution("time ms", summary.time);
+    printDistribution("error in", summary.positionError);
+    printDistribution("error deg", summary.headingError);
+}
+
+int neblib::sim::Sweep::writeCsv(
+    const std::vector<Run> &runs,
+    const char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (!file)
+        return -1;
+
+    fprintf(file, "seed,success,time_ms,position_error,heading_error\n");
+    for (std::size_t i = 0; i < runs.size(); i++)
+        fprintf(file, "%u,%d,%.0f,%.4f,%.4f\n", runs[i].seed, runs[i].success ? 1 : 0, runs[i].time, runs[i].positionError, runs[i].headingError);
+    fclose(file);
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "neblib/sim/thread_pool.hpp"
+
+neblib::sim::ThreadPool::ThreadPool(int threadCount)
+    : function(nullptr),
+      context(nullptr),
+      generation(0),
+      remaining(0),
+      stopping(false)
+{
+    if (threadCount <= 0)
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    if (threadCount <= 0)
+        threadCount = 1;
+
+    for (int i = 0; i < threadCount; i++)
+        workers.push_back(new Worker());
+    for (std::size_t i = 0; i < workers.size(); i++)
+        workers[i]->thread = std::thread(work, this, i);
+}
+
+neblib::sim::ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i]->thread.join();
+        delete workers[i];
+    }
+}
+
+int neblib::sim::ThreadPool::size() const
+{
+    return static_cast<int>(workers.size());
+}
+
+bool neblib::sim::ThreadPool::take(
+    std::size_t self,
+    std::size_t &job)
+{
+    {
+        Worker &own = *workers[self];
+        std::unique_lock<std::mutex> guard(own.lock);
+        if (!own.jobs.empty())
+        {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            return true;
+        }
+    }
+
+    // Steal from the opposite end the owner takes from, so the two rarely meet
+    for (std::size_t offset = 1; offset < workers.size(); offset++)
+    {
+        Worker &victim = *workers[(self + offset) % workers.size()];
+        std::unique_lock<std::mutex> guard(victim.lock);
+        if (!victim.jobs.empty())
+        {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void neblib::sim::ThreadPool::work(
+    ThreadPool *pool,
+    std::size_t self)
+{
+    std::uint64_t seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(pool->lock);
+            pool->wake.wait(guard, [&]()
+                            { return pool->stopping || pool->generation != seen; });
+            if (pool->stopping)
+                return;
+            seen = pool->generation;
+        }
+
+        std::size_t job;
+        while (pool->take(self, job))
+        {
+            pool->function(job, pool->context);
+
+            std::unique_lock<std::mutex> guard(pool->lock);
+            if (--pool->remaining == 0)
+                pool->done.notify_all();
+        }
+    }
+}
+
+void neblib::sim::ThreadPool::run(
+    std::size_t count,
+    Function function,
+    void *context)
+{
+    if (count == 0)
+        return;
+
+    std::unique_lock<std::mutex> guard(lock);
+    this->function = function;
+    this->context = context;
+    remaining = count;
+
+    // Jobs are queued after the function is set, so a worker still looking
+    // for work from the last run() never takes a job without its function
+    const std::size_t threads = workers.size();
+    for (std::size_t i = 0; i < threads; i++)
+    {
+        Worker &worker = *workers[i];
+        std::unique_lock<std::mutex> workerGuard(worker.lock);
+        // Reversed so the owner, taking from the back, runs its block in order
+        for (std::size_t job = (i + 1) * count / threads; job > i * count / threads; job--)
+            worker.jobs.push_back(job - 1);
+    }
+
+    generation++;
+    wake.notify_all();
+    done.wait(guard, [&]()
+              { return remaining == 0; });
+}
@@ -0,0 +1,910 @@
+#include "vex.h"
+#include <cmath>
+#include "neblib/sim/world.hpp"
+
+namespace
+{
+    neblib::sim::World &world()
+    {
+        return neblib::sim::World::get();
+    }
+
+    neblib::sim::MotorPort &motorPort(std::int32_t port)
+    {
+        return world().getPorts().motors[port];
+    }
+
+    double freeSpeed(vex::gearSetting gears)
+    {
+        switch (gears)
+        {
+        case vex::gearSetting::ratio36_1:
+            return 100.0;
+        case vex::gearSetting::ratio6_1:
+            return 600.0;
+        default:
+            return 200.0;
+        }
+    }
+
+    double toDegrees(
+        double value,
+        vex::rotationUnits units)
+    {
+        return (units == vex::rotationUnits::rev) ? value * 360.0 : value;
+    }
+
+    double fromDegrees(
+        double degrees,
+        vex::rotationUnits units)
+    {
+        return (units == vex::rotationUnits::rev) ? degrees / 360.0 : degrees;
+    }
+
+    /// @brief Converts a velocity to rpm
+    double toRpm(
+        double velocity,
+        vex::velocityUnits units,
+        double freeSpeed)
+    {
+        switch (units)
+        {
+        case vex::velocityUnits::pct:
+            return velocity / 100.0 * freeSpeed;
+        case vex::velocityUnits::dps:
+            return velocity / 6.0;
+        default:
+            return velocity;
+        }
+    }
+
+    /// @brief Converts a velocity from rad/s
+    double fromRadiansPerSecond(
+        double speed,
+        vex::velocityUnits units,
+        double freeSpeed)
+    {
+        const double rpm = speed * 60.0 / (2.0 * M_PI);
+        switch (units)
+        {
+        case vex::velocityUnits::pct:
+            return rpm / freeSpeed * 100.0;
+        case vex::velocityUnits::dps:
+            return rpm * 6.0;
+        default:
+            return rpm;
+        }
+    }
+
+    double direction(vex::directionType direction)
+    {
+        return (direction == vex::directionType::rev) ? -1.0 : 1.0;
+    }
+} // namespace
+
+// ---------- Color ----------
+
+vex::color::color()
+    : value(0)
+{
+}
+
+vex::color::color(int value)
+    : value(static_cast<std::uint32_t>(value))
+{
+}
+
+vex::color::color(
+    int red,
+    int green,
+    int blue)
+    : value(static_cast<std::uint32_t>(((red & 0xFF) << 16) | ((green & 0xFF) << 8) | (blue & 0xFF)))
+{
+}
+
+std::uint32_t vex::color::rgb() const
+{
+    return value;
+}
+
+bool vex::color::operator==(const color &other) const
+{
+    return value == other.value;
+}
+
+bool vex::color::operator!=(const color &other) const
+{
+    return value != other.value;
+}
+
+const vex::color vex::color::black(0x000000);
+const vex::color vex::color::white(0xFFFFFF);
+const vex::color vex::color::red(0xFF0000);
+const vex::color vex::color::green(0x00FF00);
+const vex::color vex::color::blue(0x0000FF);
+const vex::color vex::color::yellow(0xFFFF00);
+const vex::color vex::color::orange(0xFFA500);
+const vex::color vex::color::purple(0xFF00FF);
+const vex::color vex::color::cyan(0x00FFFF);
+const vex::color vex::color::transparent(0x7FFFFFFF);
+
+// ---------- Timing ----------
+
+vex::timer::timer()
+    : start(world().time())
+{
+}
+
+double vex::timer::time(timeUnits units) const
+{
+    const double ms = (world().time() - start) / 1000.0;
+    return (units == timeUnits::sec) ? ms / 1000.0 : ms;
+}
+
+double vex::timer::value() const
+{
+    return time(timeUnits::sec);
+}
+
+void vex::timer::clear()
+{
+    start = world().time();
+}
+
+void vex::timer::reset()
+{
+    clear();
+}
+
+std::uint32_t vex::timer::system()
+{
+    return static_cast<std::uint32_t>(world().time() / 1000);
+}
+
+std::uint64_t vex::timer::systemHighResolution()
+{
+    return world().time();
+}
+
+vex::task::task()
+    : id(-1)
+{
+}
+
+vex::task::task(
+    int (*callback)(void *),
+    void *arg,
+    std::int32_t priority)
+    : id(world().createTask(callback, arg, priority))
+{
+}
+
+vex::task::task(
+    int (*callback)(void *),
+    void *arg)
+    : id(world().createTask(callback, arg, taskPriorityNormal))
+{
+}
+
+namespace
+{
+    int runWithoutArgument(void *callback)
+    {
+        return reinterpret_cast<int (*)()>(callback)();
+    }
+} // namespace
+
+vex::task::task(
+    int (*callback)(),
+    std::int32_t priority)
+    : id(world().createTask(runWithoutArgument, reinterpret_cast<void *>(callback), priority))
+{
+}
+
+void vex::task::stop()
+{
+    if (id >= 0)
+        world().stopTask(id);
+}
+
+void vex::task::sleep(std::uint32_t time)
+{
+    world().sleepUntil(world().time() + static_cast<std::uint64_t>(time) * 1000);
+}
+
+void vex::task::yield()
+{
+    sleep(1);
+}
+
+vex::mutex::mutex()
+    : locked(false)
+{
+}
+
+void vex::mutex::lock()
+{
+    // Only one task runs at a time, so waiting is all that is needed
+    while (locked)
+        vex::task::yield();
+    locked = true;
+}
+
+bool vex::mutex::try_lock()
+{
+    if (locked)
+        return false;
+    locked = true;
+    return true;
+}
+
+void vex::mutex::unlock()
+{
+    locked = false;
+}
+
+std::int32_t vex::this_thread::get_id()
+{
+    return world().currentTask();
+}
+
+void vex::this_thread::sleep_for(std::uint32_t time)
+{
+    vex::task::sleep(time);
+}
+
+void vex::this_thread::yield()
+{
+    vex::task::yield();
+}
+
+void vex::wait(
+    double time,
+    timeUnits units)
+{
+    const double ms = (units == timeUnits::sec) ? time * 1000.0 : time;
+    vex::task::sleep(static_cast<std::uint32_t>(ms));
+}
+
+// ---------- Motor ----------
+
+vex::motor::motor(std::int32_t port)
+    : motor(port, gearSetting::ratio18_1, false)
+{
+}
+
+vex::motor::motor(
+    std::int32_t port,
+    bool reversed)
+    : motor(port, gearSetting::ratio18_1, reversed)
+{
+}
+
+vex::motor::motor(
+    std::int32_t port,
+    gearSetting gears,
+    bool reversed)
+    : port(port),
+      gears(gears),
+      reversed(reversed)
+{
+    neblib::sim::MotorPort &state = motorPort(port);
+    if (!state.connected)
+        state.model = neblib::sim::MotorModel(neblib::sim::MotorModel::Parameters::v5(freeSpeed(gears)));
+    state.connected = true;
+}
+
+std::int32_t vex::motor::index() const
+{
+    return port;
+}
+
+bool vex::motor::installed() const
+{
+    return motorPort(port).connected;
+}
+
+void vex::motor::setReversed(bool reversed)
+{
+    this->reversed = reversed;
+}
+
+void vex::motor::spin(directionType direction)
+{
+    neblib::sim::MotorPort &state = motorPort(port);
+    if (state.mode != neblib::sim::MotorPort::Velocity)
+        state.command = 0.0;
+    state.command = std::abs(state.command) * ::direction(direction);
+    state.mode = neblib::sim::MotorPort::Velocity;
+}
+
+void vex::motor::spin(
+    directionType direction,
+    double velocity,
+    velocityUnits units)
+{
+    neblib::sim::MotorPort &state = motorPort(port);
+    state.mode = neblib::sim::MotorPort::Velocity;
+    state.command = toRpm(velocity, units, freeSpeed(gears)) * ::direction(direction);
+}
+
+void vex::motor::spin(
+    directionType direction,
+    double velocity,
+    percentUnits)
+{
+    spin(direction, velocity, velocityUnits::pct);
+}
+
+void vex::motor::spin(
+    directionType direction,
+    double voltage,
+    voltageUnits units)
+{
+    neblib::sim::MotorPort &state = motorPort(port);
+    state.mode = neblib::sim::MotorPort::Voltage;
+    state.command = ((units == voltageUnits::mV) ? voltage / 1000.0 : voltage) * ::direction(direction);
+}
+
+void vex::motor::stop()
+{
+    stop(brakeType::coast);
+}
+
+void vex::motor::stop(brakeType mode)
+{
+    neblib::sim::MotorPort &state = motorPort(port);
+    state.command = 0.0;
+    switch (mode)
+    {
+    case brakeType::brake:
+        state.mode = neblib::sim::MotorPort::Brake;
+        break;
+    case brakeType::hold:
+        state.mode = neblib::sim::MotorPort::Hold;
+        state.holdPosition = state.position;
+        break;
+    default:
+        state.mode = neblib::sim::MotorPort::Coast;
+        break;
+    }
+}
+
+void vex::motor::setBrake(brakeType)
+{
+}
+
+void vex::motor::setVelocity(
+    double velocity,
+    velocityUnits units)
+{
+    neblib::sim::MotorPort &state = motorPort(port);
+    if (state.mode == neblib::sim::MotorPort::Velocity)
+        state.command = toRpm(velocity, units, freeSpeed(gears));
+}
+
+void vex::motor::setVelocity(
+    double velocity,
+    percentUnits)
+{
+    setVelocity(velocity, velocityUnits::pct);
+}
+
+double vex::motor::position(rotationUnits units) const
+{
+    const neblib::sim::MotorPort &state = motorPort(port);
+    return fromDegrees(state.position + state.positionOffset, units);
+}
+
+void vex::motor::setPosition(
+    double value,
+    rotationUnits units)
+{
+    neblib::sim::MotorPort &state = motorPort(port);
+    state.positionOffset = toDegrees(value, units) - state.position;
+}
+
+void vex::motor::resetPosition()
+{
+    setPosition(0.0, rotationUnits::deg);
+}
+
+double vex::motor::velocity(velocityUnits units) const
+{
+    return fromRadiansPerSecond(motorPort(port).speed, units, freeSpeed(gears));
+}
+
+double vex::motor::velocity(percentUnits) const
+{
+    return velocity(velocityUnits::pct);
+}
+
+double vex::motor::voltage(voltageUnits units) const
+{
+    const double voltage = motorPort(port).voltage;
+    return (units == voltageUnits::mV) ? voltage * 1000.0 : voltage;
+}
+
+double vex::motor::current(currentUnits) const
+{
+    return std::abs(motorPort(port).current);
+}
+
+double vex::motor::torque(torqueUnits units) const
+{
+    const double torque = motorPort(port).torque;
+    return (units == torqueUnits::InLb) ? torque * 8.8507 : torque;
+}
+
+// ---------- Motor Group ----------
+
+std::int32_t vex::motor_group::count() const
+{
+    return static_cast<std::int32_t>(motors.size());
+}
+
+void vex::motor_group::spin(directionType direction)
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].spin(direction);
+}
+
+void vex::motor_group::spin(
+    directionType direction,
+    double velocity,
+    velocityUnits units)
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].spin(direction, velocity, units);
+}
+
+void vex::motor_group::spin(
+    directionType direction,
+    double velocity,
+    percentUnits units)
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].spin(direction, velocity, units);
+}
+
+void vex::motor_group::spin(
+    directionType direction,
+    double voltage,
+    voltageUnits units)
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].spin(direction, voltage, units);
+}
+
+void vex::motor_group::stop()
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].stop();
+}
+
+void vex::motor_group::stop(brakeType mode)
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].stop(mode);
+}
+
+void vex::motor_group::setStopping(brakeType mode)
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].setBrake(mode);
+}
+
+void vex::motor_group::setVelocity(
+    double velocity,
+    velocityUnits units)
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].setVelocity(velocity, units);
+}
+
+void vex::motor_group::setVelocity(
+    double velocity,
+    percentUnits units)
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].setVelocity(velocity, units);
+}
+
+double vex::motor_group::position(rotationUnits units) const
+{
+    return motors.empty() ? 0.0 : motors[0].position(units);
+}
+
+void vex::motor_group::setPosition(
+    double value,
+    rotationUnits units)
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].setPosition(value, units);
+}
+
+void vex::motor_group::resetPosition()
+{
+    for (std::size_t i = 0; i < motors.size(); i++)
+        motors[i].resetPosition();
+}
+
+double vex::motor_group::velocity(velocityUnits units) const
+{
+    return motors.empty() ? 0.0 : motors[0].velocity(units);
+}
+
+double vex::motor_group::velocity(percentUnits units) const
+{
+    return motors.empty() ? 0.0 : motors[0].velocity(units);
+}
+
+double vex::motor_group::voltage(voltageUnits units) const
+{
+    return motors.empty() ? 0.0 : motors[0].voltage(units);
+}
+
+double vex::motor_group::current(currentUnits units) const
+{
+    double total = 0.0;
+    for (std::size_t i = 0; i < motors.size(); i++)
+        total += motors[i].current(units);
+    return total;
+}
+
+// ---------- Inertial ----------
+
+vex::inertial::inertial(
+    std::int32_t port,
+    turnType direction)
+    : port(port),
+      direction((direction == turnType::left) ? -1.0 : 1.0)
+{
+    world().getPorts().inertials[port].connected = true;
+}
+
+bool vex::inertial::installed() const
+{
+    return world().getPorts().inertials[port].connected;
+}
+
+void vex::inertial::calibrate()
+{
+    startCalibration();
+}
+
+void vex::inertial::startCalibration()
+{
+    // Calibration takes about 2 s on the brain
+    world().getPorts().inertials[port].calibrationEnd = world().time() + 2000000;
+}
+
+bool vex::inertial::isCalibrating() const
+{
+    return world().time() < world().getPorts().inertials[port].calibrationEnd;
+}
+
+double vex::inertial::heading(rotationUnits units) const
+{
+    const neblib::sim::InertialPort &state = world().getPorts().inertials[port];
+    double heading = std::fmod(direction * state.rotation + state.headingOffset, 360.0);
+    if (heading < 0.0)
+        heading += 360.0;
+    return fromDegrees(heading, units);
+}
+
+double vex::inertial::rotation(rotationUnits units) const
+{
+    const neblib::sim::InertialPort &state = world().getPorts().inertials[port];
+    return fromDegrees(direction * state.rotation + state.rotationOffset, units);
+}
+
+void vex::inertial::setHeading(
+    double value,
+    rotationUnits units)
+{
+    neblib::sim::InertialPort &state = world().getPorts().inertials[port];
+    state.headingOffset = toDegrees(value, units) - direction * state.rotation;
+}
+
+void vex::inertial::setRotation(
+    double value,
+    rotationUnits units)
+{
+    neblib::sim::InertialPort &state = world().getPorts().inertials[port];
+    state.rotationOffset = toDegrees(value, units) - direction * state.rotation;
+}
+
+void vex::inertial::resetHeading()
+{
+    setHeading(0.0, rotationUnits::deg);
+}
+
+void vex::inertial::resetRotation()
+{
+    setRotation(0.0, rotationUnits::deg);
+}
+
+double vex::inertial::gyroRate(
+    int axis,
+    velocityUnits units) const
+{
+    // Only yaw is simulated, on the z axis
+    if (axis != 2)
+        return 0.0;
+    const double rate = direction * world().getPorts().inertials[port].rate;
+    return (units == velocityUnits::rpm) ? rate / 6.0 : rate;
+}
+
+// ---------- Rotation ----------
+
+vex::rotation::rotation(
+    std::int32_t port,
+    bool)
+    : port(port)
+{
+    world().getPorts().rotations[port].connected = true;
+}
+
+bool vex::rotation::installed() const
+{
+    return world().getPorts().rotations[port].connected;
+}
+
+double vex::rotation::position(rotationUnits units) const
+{
+    const neblib::sim::RotationPort &state = world().getPorts().rotations[port];
+    return fromDegrees(state.position + state.offset, units);
+}
+
+double vex::rotation::angle(rotationUnits units) const
+{
+    double angle = std::fmod(position(rotationUnits::deg), 360.0);
+    if (angle < 0.0)
+        angle += 360.0;
+    return fromDegrees(angle, units);
+}
+
+double vex::rotation::velocity(velocityUnits units) const
+{
+    const double speed = world().getPorts().rotations[port].speed;
+    return (units == velocityUnits::rpm) ? speed / 6.0 : speed;
+}
+
+void vex::rotation::setPosition(
+    double value,
+    rotationUnits units)
+{
+    neblib::sim::RotationPort &state = world().getPorts().rotations[port];
+    state.offset = toDegrees(value, units) - state.position;
+}
+
+void vex::rotation::resetPosition()
+{
+    setPosition(0.0, rotationUnits::deg);
+}
+
+// ---------- Three Wire Ports ----------
+
+vex::triport::port::port(std::int32_t index)
+    : index(index)
+{
+}
+
+std::int32_t vex::triport::port::getIndex() const
+{
+    return index;
+}
+
+vex::triport::triport()
+    : A(0),
+      B(1),
+      C(2),
+      D(3),
+      E(4),
+      F(5),
+      G(6),
+      H(7)
+{
+}
+
+vex::digital_out::digital_out(triport::port &port)
+    : port(port.getIndex())
+{
+}
+
+void vex::digital_out::set(bool value)
+{
+    world().getPorts().threeWire[port] = value;
+}
+
+std::int32_t vex::digital_out::value() const
+{
+    return world().getPorts().threeWire[port] ? 1 : 0;
+}
+
+vex::led::led(triport::port &port)
+    : port(port.getIndex())
+{
+}
+
+void vex::led::on()
+{
+    world().getPorts().threeWire[port] = true;
+}
+
+void vex::led::off()
+{
+    world().getPorts().threeWire[port] = false;
+}
+
+std::int32_t vex::led::value() const
+{
+    return world().getPorts().threeWire[port] ? 1 : 0;
+}
+
+// ---------- Brain ----------
+
+void vex::brain::lcd::setCursor(int, int) {}
+void vex::brain::lcd::clearScreen() {}
+void vex::brain::lcd::clearScreen(const color &) {}
+void vex::brain::lcd::clearLine() {}
+void vex::brain::lcd::clearLine(int) {}
+void vex::brain::lcd::newLine() {}
+void vex::brain::lcd::setPenColor(const color &) {}
+void vex::brain::lcd::setFillColor(const color &) {}
+void vex::brain::lcd::drawRectangle(int, int, int, int) {}
+void vex::brain::lcd::drawRectangle(int, int, int, int, const color &) {}
+void vex::brain::lcd::drawLine(int, int, int, int) {}
+void vex::brain::lcd::drawCircle(int, int, int) {}
+void vex::brain::lcd::render() {}
+
+std::int32_t vex::brain::lcd::getStringWidth(const char *text)
+{
+    // Default font is 10 px per character
+    return static_cast<std::int32_t>(strlen(text) * 10);
+}
+
+std::int32_t vex::brain::lcd::getStringHeight(const char *)
+{
+    return 20;
+}
+
+bool vex::brain::lcd::pressing()
+{
+    return world().isTouching();
+}
+
+std::int32_t vex::brain::lcd::xPosition()
+{
+    return world().getTouchX();
+}
+
+std::int32_t vex::brain::lcd::yPosition()
+{
+    return world().getTouchY();
+}
+
+bool vex::brain::sdcard::isInserted()
+{
+    return true;
+}
+
+std::int32_t vex::brain::sdcard::savefile(
+    const char *name,
+    std::uint8_t *buffer,
+    std::int32_t length)
+{
+    FILE *file = fopen(name, "wb");
+    if (!file)
+        return 0;
+    const std::int32_t written = static_cast<std::int32_t>(fwrite(buffer, 1, length, file));
+    fclose(file);
+    return written;
+}
+
+std::int32_t vex::brain::sdcard::appendfile(
+    const char *name,
+    std::uint8_t *buffer,
+    std::int32_t length)
+{
+    FILE *file = fopen(name, "ab");
+    if (!file)
+        return 0;
+    const std::int32_t written = static_cast<std::int32_t>(fwrite(buffer, 1, length, file));
+    fclose(file);
+    return written;
+}
+
+std::int32_t vex::brain::sdcard::loadfile(
+    const char *name,
+    std::uint8_t *buffer,
+    std::int32_t length)
+{
+    FILE *file = fopen(name, "rb");
+    if (!file)
+        return 0;
+    const std::int32_t read = static_cast<std::int32_t>(fread(buffer, 1, length, file));
+    fclose(file);
+    return read;
+}
+
+bool vex::brain::sdcard::exists(const char *name)
+{
+    FILE *file = fopen(name, "rb");
+    if (!file)
+        return false;
+    fclose(file);
+    return true;
+}
+
+std::int32_t vex::brain::sdcard::size(const char *name)
+{
+    FILE *file = fopen(name, "rb");
+    if (!file)
+        return 0;
+    fseek(file, 0, SEEK_END);
+    const std::int32_t size = static_cast<std::int32_t>(ftell(file));
+    fclose(file);
+    return size;
+}
+
+// ---------- Controller ----------
+
+vex::controller::axis::axis(
+    int controllerIndex,
+    int axisIndex)
+    : controllerIndex(controllerIndex),
+      axisIndex(axisIndex)
+{
+}
+
+std::int32_t vex::controller::axis::value() const
+{
+    return static_cast<std::int32_t>(std::lround(world().getController(controllerIndex).axes[axisIndex] * 1.27));
+}
+
+std::int32_t vex::controller::axis::position(percentUnits) const
+{
+    return static_cast<std::int32_t>(std::lround(world().getController(controllerIndex).axes[axisIndex]));
+}
+
+vex::controller::button::button(
+    int controllerIndex,
+    int buttonIndex)
+    : controllerIndex(controllerIndex),
+      buttonIndex(buttonIndex)
+{
+}
+
+bool vex::controller::button::pressing() const
+{
+    return world().getController(controllerIndex).buttons[buttonIndex];
+}
+
+void vex::controller::lcd::setCursor(int, int) {}
+void vex::controller::lcd::clearScreen() {}
+void vex::controller::lcd::clearLine(int) {}
+void vex::controller::lcd::newLine() {}
+
+vex::controller::controller(controllerType type)
+    : Axis1((type == controllerType::partner) ? 1 : 0, 0),
+      Axis2((type == controllerType::partner) ? 1 : 0, 1),
+      Axis3((type == controllerType::partner) ? 1 : 0, 2),
+      Axis4((type == controllerType::partner) ? 1 : 0, 3),
+      ButtonL1((type == controllerType::partner) ? 1 : 0, 0),
+      ButtonL2((type == controllerType::partner) ? 1 : 0, 1),
+      ButtonR1((type == controllerType::partner) ? 1 : 0, 2),
+      ButtonR2((type == controllerType::partner) ? 1 : 0, 3),
+      ButtonUp((type == controllerType::partner) ? 1 : 0, 4),
+      ButtonDown((type == controllerType::partner) ? 1 : 0, 5),
+      ButtonLeft((type == controllerType::partner) ? 1 : 0, 6),
+      ButtonRight((type == controllerType::partner) ? 1 : 0, 7),
+      ButtonX((type == controllerType::partner) ? 1 : 0, 8),
+      ButtonB((type == controllerType::partner) ? 1 : 0, 9),
+      ButtonY((type == controllerType::partner) ? 1 : 0, 10),
+      ButtonA((type == controllerType::partner) ? 1 : 0, 11)
+{
+}
+
+void vex::controller::rumble(const char *) {}
@@ -0,0 +1,323 @@
+#include "neblib/sim/world.hpp"
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    /// @brief Id of the task running on this thread, the main thread is task 0
+    thread_local int taskId = 0;
+
+    /// @brief World of this thread, nullptr for the default world
+    thread_local neblib::sim::World *currentWorld = nullptr;
+} // namespace
+
+neblib::sim::World::Battery::Battery(
+    double openCircuitVoltage,
+    double internalResistance)
+    : openCircuitVoltage(openCircuitVoltage),
+      internalResistance(internalResistance)
+{
+}
+
+neblib::sim::World::ControllerState::ControllerState()
+{
+    for (int i = 0; i < 4; i++)
+        axes[i] = 0.0;
+    for (int i = 0; i < 12; i++)
+        buttons[i] = false;
+}
+
+neblib::sim::World::Task::Task(
+    int id,
+    int priority,
+    std::uint64_t wakeTime,
+    std::uint64_t turn)
+    : id(id),
+      priority(priority),
+      wakeTime(wakeTime),
+      turn(turn),
+      finished(false),
+      returned(false)
+{
+}
+
+neblib::sim::World::World()
+    : current(0),
+      nextTurn(1),
+      now(0),
+      stepSize(1000),
+      wallStart(std::chrono::steady_clock::now()),
+      chassis(nullptr),
+      battery(),
+      batteryVoltage(battery.openCircuitVoltage),
+      touching(false),
+      touchX(0),
+      touchY(0),
+      stepObserver(nullptr),
+      stepContext(nullptr)
+{
+    tasks.push_back(new Task(0, 7, 0, 0));
+}
+
+neblib::sim::World &neblib::sim::World::get()
+{
+    if (currentWorld)
+        return *currentWorld;
+
+    // Never destroyed, task threads may still be waiting on it at exit
+    static World *world = new World();
+    return *world;
+}
+
+neblib::sim::World *neblib::sim::World::create()
+{
+    return new World();
+}
+
+void neblib::sim::World::makeCurrent(World *world)
+{
+    currentWorld = world;
+    taskId = 0;
+}
+
+bool neblib::sim::World::destroy(World *world)
+{
+    if (!world)
+        return false;
+
+    {
+        std::unique_lock<std::mutex> guard(world->lock);
+        for (std::size_t i = 1; i < world->tasks.size(); i++)
+            if (!world->tasks[i]->returned)
+                return false;
+    }
+
+    for (std::size_t i = 0; i < world->tasks.size(); i++)
+    {
+        if (world->tasks[i]->thread.joinable())
+            world->tasks[i]->thread.join();
+        delete world->tasks[i];
+    }
+    delete world;
+    return true;
+}
+
+// ---------- Scheduler ----------
+
+void neblib::sim::World::dispatch()
+{
+    Task *next = nullptr;
+    for (std::size_t i = 0; i < tasks.size(); i++)
+    {
+        Task *task = tasks[i];
+        if (task->finished)
+            continue;
+        if (!next ||
+            task->wakeTime < next->wakeTime ||
+            (task->wakeTime == next->wakeTime && task->priority > next->priority) ||
+            (task->wakeTime == next->wakeTime && task->priority == next->priority && task->turn < next->turn))
+            next = task;
+    }
+    if (!next)
+        return;
+
+    advance(next->wakeTime);
+    current = next->id;
+    next->resume.notify_one();
+}
+
+void neblib::sim::World::waitForTurn(
+    std::unique_lock<std::mutex> &guard,
+    Task &self)
+{
+    // A stopped task waits here forever
+    self.resume.wait(guard, [&]()
+                     { return current == self.id && !self.finished; });
+}
+
+void neblib::sim::World::runTask(
+    World *world,
+    int id,
+    int (*callback)(void *),
+    void *arg)
+{
+    taskId = id;
+    currentWorld = world;
+    {
+        std::unique_lock<std::mutex> guard(world->lock);
+        world->waitForTurn(guard, *world->tasks[id]);
+    }
+
+    callback(arg);
+
+    std::unique_lock<std::mutex> guard(world->lock);
+    world->tasks[id]->finished = true;
+    world->tasks[id]->returned = true;
+    world->dispatch();
+}
+
+int neblib::sim::World::createTask(
+    int (*callback)(void *),
+    void *arg,
+    int priority)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    const int id = static_cast<int>(tasks.size());
+    Task *task = new Task(id, priority, now, nextTurn++);
+    tasks.push_back(task);
+    task->thread = std::thread(runTask, this, id, callback, arg);
+    return id;
+}
+
+void neblib::sim::World::stopTask(int id)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    if (id < 0 || static_cast<std::size_t>(id) >= tasks.size())
+        return;
+
+    tasks[id]->finished = true;
+    if (id == taskId)
+    {
+        dispatch();
+        waitForTurn(guard, *tasks[id]);
+    }
+}
+
+void neblib::sim::World::sleepUntil(std::uint64_t time)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    Task &self = *tasks[taskId];
+    self.wakeTime = (time > now) ? time : now;
+    self.turn = nextTurn++;
+    dispatch();
+    waitForTurn(guard, self);
+}
+
+int neblib::sim::World::currentTask() const
+{
+    return taskId;
+}
+
+// ---------- Clock ----------
+
+void neblib::sim::World::advance(std::uint64_t time)
+{
+    while (now < time)
+    {
+        const std::uint64_t dt = (time - now < stepSize) ? time - now : stepSize;
+        step(dt / 1e6);
+        now += dt;
+    }
+}
+
+void neblib::sim::World::step(double dt)
+{
+    if (chassis)
+        chassis->step(dt, batteryVoltage, ports);
+
+    double load = 0.0;
+    for (int i = 0; i < neblib::sim::Ports::count; i++)
+    {
+        neblib::sim::MotorPort &motor = ports.motors[i];
+        if (!motor.connected)
+            continue;
+        if (!motor.attached || !chassis)
+        {
+            motor.update(batteryVoltage);
+            motor.integrate(dt);
+        }
+        load += std::abs(motor.current);
+    }
+
+    // The motors see the sag caused by their own draw one step later
+    batteryVoltage = battery.openCircuitVoltage - battery.internalResistance * load;
+
+    if (stepObserver)
+        stepObserver(*this, stepContext);
+}
+
+std::uint64_t neblib::sim::World::time() const
+{
+    return now;
+}
+
+double neblib::sim::World::realTimeFactor() const
+{
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return (wall > 0.0) ? (now / 1e6) / wall : 0.0;
+}
+
+void neblib::sim::World::setStepSize(std::uint64_t stepSize)
+{
+    this->stepSize = (stepSize > 0) ? stepSize : 1;
+}
+
+void neblib::sim::World::setStepObserver(
+    StepObserver observer,
+    void *context)
+{
+    stepObserver = observer;
+    stepContext = context;
+}
+
+// ---------- Hardware ----------
+
+neblib::sim::Ports &neblib::sim::World::getPorts()
+{
+    return ports;
+}
+
+void neblib::sim::World::setChassis(neblib::sim::ChassisModel *chassis)
+{
+    for (int i = 0; i < neblib::sim::Ports::count; i++)
+        ports.motors[i].attached = false;
+    this->chassis = chassis;
+    if (chassis)
+        chassis->attach(ports);
+}
+
+neblib::sim::ChassisModel *neblib::sim::World::getChassis()
+{
+    return chassis;
+}
+
+void neblib::sim::World::setBattery(Battery battery)
+{
+    this->battery = battery;
+    batteryVoltage = battery.openCircuitVoltage;
+}
+
+double neblib::sim::World::getBatteryVoltage() const
+{
+    return batteryVoltage;
+}
+
+neblib::sim::World::ControllerState &neblib::sim::World::getController(int index)
+{
+    return controllers[(index == 1) ? 1 : 0];
+}
+
+void neblib::sim::World::setTouch(
+    bool touching,
+    int x,
+    int y)
+{
+    this->touching = touching;
+    touchX = x;
+    touchY = y;
+}
+
+bool neblib::sim::World::isTouching() const
+{
+    return touching;
+}
+
+int neblib::sim::World::getTouchX() const
+{
+    return touchX;
+}
+
+int neblib::sim::World::getTouchY() const
+{
+    return touchY;
+}
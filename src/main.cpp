@@ -11,6 +11,11 @@
 #include "neblib/xdrive.hpp"
 #include "neblib/devices/tracker_wheel.hpp"
 #include "neblib/auton_selector.hpp"
+#include "neblib/executor.hpp"
+#include "neblib/motor_output.hpp"
+#include "neblib/sensor_snapshot.hpp"
+#include "neblib/driver_input.hpp"
+#include "neblib/plan_cache.hpp"
 #include <iostream>
 
 using namespace vex;
@@ -86,6 +91,55 @@ neblib::PID angularPID(
     neblib::PID::ExitConditions(
         0.5,
         50));
+
+neblib::Executor executor(10);
+neblib::SensorSnapshot sensors;
+neblib::MotorOutput motorOutput;
+neblib::DriverInput driverInput(controller1);
+
+// Autonomous paths planned in pre_auton for every routine of the selector,
+// on a 144 inch field in 2 inch cells centered on the origin
+// std::uint8_t fieldOccupancy[72 * 72] = {}; // mark the cells of field elements nonzero
+// neblib::PathPlanner planner(fieldOccupancy, 72, 72, 2.0, 9.0, -72.0, -72.0);
+// neblib::PlanCache plans;
+//
+// void buildLeftAWP(neblib::PlanCache &cache, const char *routine, void *)
+// {
+//     cache.addPlan(routine, planner, neblib::Pose(-48.0, -60.0, 90.0), neblib::Pose(-24.0, -24.0, 45.0));
+//     cache.addPlan(routine, planner, neblib::Pose(-24.0, -24.0, 45.0), neblib::Pose(0.0, -48.0, 180.0));
+// }
+//
+// void buildLeftElim(neblib::PlanCache &cache, const char *routine, void *)
+// {
+//     cache.addPlan(routine, planner, neblib::Pose(-48.0, -60.0, 90.0), neblib::Pose(-48.0, 24.0, 0.0));
+// }
+//
+// neblib::Page redPage = neblib::Page(neblib::Button(0, 0, 160, 50, vex::color(155, 155, 155), vex::color(50, 50, 50), vex::color(255, 255, 255), vex::color(0, 0, 0), "Red"), {neblib::Button(10, 120, 160, 50, vex::color(0, 0, 0), vex::color(150, 0, 0), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Red AWP"),
+//                                                                                                                                                                               neblib::Button(310, 120, 160, 50, vex::color(0, 0, 0), vex::color(150, 0, 0), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Red Elim")});
+//
+// neblib::Page bluePage = neblib::Page(neblib::Button(160, 0, 160, 50, vex::color(155, 155, 155), vex::color(50, 50, 50), vex::color(255, 255, 255), vex::color(0, 0, 0), "Blue"), {neblib::Button(10, 120, 160, 50, vex::color(0, 0, 0), vex::color(0, 0, 150), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Blue AWP"),
+//                                                                                                                                                                                   neblib::Button(310, 120, 160, 50, vex::color(0, 0, 0), vex::color(0, 0, 150), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Blue Elim")});
+//
+// neblib::Page skillsPage = neblib::Page(neblib::Button(320, 0, 160, 50, vex::color(155, 155, 155), vex::color(50, 50, 50), vex::color(255, 255, 255), vex::color(0, 0, 0), "Skills"), {neblib::Button(10, 120, 160, 50, vex::color(0, 0, 0), vex::color(150, 0, 0), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Skills")});
+// neblib::AutonSelector selector = neblib::AutonSelector(Brain,
+//                                                        {&redPage, &bluePage, &skillsPage},
+//                                                        neblib::Button(180, 120, 120, 50, vex::color(255, 255, 255), vex::color(0, 0, 0), vex::color(0, 0, 0), vex::color(255, 255, 255), "Calibrate"));
+
+void displayPose(void *)
+{
+    const neblib::Pose p = odom.getPose();
+    Brain.Screen.clearScreen();
+    Brain.Screen.setCursor(1, 1);
+    Brain.Screen.print("X: ");
+    Brain.Screen.print(p.x);
+    Brain.Screen.setCursor(2, 1);
+    Brain.Screen.print("Y: ");
+    Brain.Screen.print(p.y);
+    Brain.Screen.setCursor(3, 1);
+    Brain.Screen.print("T: ");
+    Brain.Screen.print(p.heading);
+    odom.getLoopStats().print(Brain.Screen, 5);
+}
 /*---------------------------------------------------------------------------*/
 /*                          Pre-Autonomous Functions                         */
 /*                                                                           */
@@ -100,17 +154,14 @@ void pre_auton(void)
 {
     xDrive.setLinearController(&linearPID);
     xDrive.setAngularController(&angularPID);
-    // neblib::Page redPage = neblib::Page(neblib::Button(0, 0, 160, 50, vex::color(155, 155, 155), vex::color(50, 50, 50), vex::color(255, 255, 255), vex::color(0, 0, 0), "Red"), {neblib::Button(10, 120, 160, 50, vex::color(0, 0, 0), vex::color(150, 0, 0), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Red AWP"),
-    //                                                                                                                                                                               neblib::Button(310, 120, 160, 50, vex::color(0, 0, 0), vex::color(150, 0, 0), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Red Elim")});
-
-    // neblib::Page bluePage = neblib::Page(neblib::Button(160, 0, 160, 50, vex::color(155, 155, 155), vex::color(50, 50, 50), vex::color(255, 255, 255), vex::color(0, 0, 0), "Blue"), {neblib::Button(10, 120, 160, 50, vex::color(0, 0, 0), vex::color(0, 0, 150), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Blue AWP"),
-    //                                                                                                                                                                                   neblib::Button(310, 120, 160, 50, vex::color(0, 0, 0), vex::color(0, 0, 150), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Blue Elim")});
-
-    // neblib::Page skillsPage = neblib::Page(neblib::Button(320, 0, 160, 50, vex::color(155, 155, 155), vex::color(50, 50, 50), vex::color(255, 255, 255), vex::color(0, 0, 0), "Skills"), {neblib::Button(10, 120, 160, 50, vex::color(0, 0, 0), vex::color(150, 0, 0), vex::color(255, 255, 255), vex::color(255, 255, 255), "Left Skills")});
-    // neblib::AutonSelector selector = neblib::AutonSelector(Brain,
-    //                                                        {&redPage, &bluePage, &skillsPage},
-    //                                                        neblib::Button(180, 120, 120, 50, vex::color(255, 255, 255), vex::color(0, 0, 0), vex::color(0, 0, 0), vex::color(255, 255, 255), "Calibrate"));
-
+    // plans.addPlanner(planner);
+    // plans.addRoutine("Left Red AWP", buildLeftAWP);
+    // plans.addRoutine("Left Blue AWP", buildLeftAWP);
+    // plans.addRoutine("Left Red Elim", buildLeftElim);
+    // plans.addRoutine("Left Blue Elim", buildLeftElim);
+    // // Builds the paths of every routine, or loads them when the routines and field match the last boot
+    // plans.prepare(Brain.SDcard, "plans.nbpc");
+    //
     // selector.runSelector();
     // Brain.Screen.clearScreen();
     // Brain.Screen.setCursor(1, 1);
@@ -128,6 +179,12 @@ void autonomous(void)
     // ..........................................................................
     // Insert autonomous user code here.
     // ..........................................................................
+
+    // for (std::size_t i = 0; i < plans.getPlanCount(selector.getAuton()); i++)
+    // {
+    //     const neblib::PlanCache::Plan plan = plans.get(selector.getAuton(), i);
+    //     xDrive.followPath(plan.poses, plan.count, neblib::ChainConditions(4.0, 3.0));
+    // }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -147,7 +204,22 @@ void usercontrol(void)
         0.0,
         0.0,
         90.0);
-    task a = neblib::launchTask(std::bind(&neblib::Odometry::begin, &odom));
+    sensors.setImu(imu);
+    sensors.addTrackerWheel(parallel);
+    sensors.addTrackerWheel(perpendicular);
+    odom.setSensorSnapshot(&sensors);
+    xDrive.setSensorSnapshot(&sensors);
+    xDrive.setMotorOutput(&motorOutput, neblib::MotorOutput::Limits(120.0));
+    driverInput.setCurve(neblib::DriverInput::Axis3, neblib::InputCurve(neblib::InputCurve::Cubic, 5.0, 0.6, 5.0));
+    driverInput.setCurve(neblib::DriverInput::Axis4, neblib::InputCurve(neblib::InputCurve::Cubic, 5.0, 0.6, 5.0));
+    driverInput.setCurve(neblib::DriverInput::Axis1, neblib::InputCurve(neblib::InputCurve::Exponential, 5.0, 2.0));
+    executor.addJob<neblib::SensorSnapshot, &neblib::SensorSnapshot::update>("sensors", neblib::Executor::Sensing, &sensors);
+    executor.addJob<neblib::DriverInput, &neblib::DriverInput::update>("driver input", neblib::Executor::Sensing, &driverInput);
+    executor.addJob<neblib::Odometry, &neblib::Odometry::update>("odometry", neblib::Executor::Estimation, &odom);
+    executor.addJob<neblib::MotorOutput, &neblib::MotorOutput::flush>("motors", neblib::Executor::Output, &motorOutput);
+    executor.addJob("display", neblib::Executor::Telemetry, displayPose, nullptr, 5);
+    neblib::Task<int> executorTask = neblib::spawnTask(std::bind(&neblib::Executor::begin, &executor), vex::task::taskPriorityHigh);
+    xDrive.setExecutor(&executor);
     int out = xDrive.driveToPose(23.5, 0.0, 90.0, 2500);
     controller1.Screen.print(out);
     xDrive.turnTo(90.0);
@@ -157,24 +229,14 @@ void usercontrol(void)
 
     while (true)
     {
-        // xDrive.driveGlobal(
-        //     controller1.Axis3.position(percent),
-        //     controller1.Axis4.position(percent),
-        //     controller1.Axis1.position(percent),
+        // xDrive.driveField(
+        //     driverInput.get(neblib::DriverInput::Axis4),
+        //     driverInput.get(neblib::DriverInput::Axis3),
+        //     driverInput.get(neblib::DriverInput::Axis1),
         //     vex::velocityUnits::pct);
+        // driverInput.markApplied();
 
-        const neblib::Pose p = odom.getPose();
-        Brain.Screen.clearScreen();
-        Brain.Screen.setCursor(1, 1);
-        Brain.Screen.print("X: ");
-        Brain.Screen.print(p.x);
-        Brain.Screen.setCursor(2, 1);
-        Brain.Screen.print("Y: ");
-        Brain.Screen.print(p.y);
-        Brain.Screen.setCursor(3, 1);
-        Brain.Screen.print("T: ");
-        Brain.Screen.print(p.heading);
-        task::sleep(10);
+        executor.waitForTick();
     }
 }
 
@@ -1,4 +1,5 @@
 #include "neblib/control_algorithms.hpp"
+#include "neblib/trace.hpp"
 
 neblib::PID::Gains::Gains(
     double kP,
@@ -30,6 +31,14 @@ neblib::PID::ExitConditions::ExitConditions(
 {
 }
 
+neblib::ChainConditions::ChainConditions(
+    double exitRadius,
+    double minSpeed)
+    : exitRadius(exitRadius),
+      minSpeed(minSpeed)
+{
+}
+
 neblib::PID::PID(
     Gains gains,
     Behaviors behaviors,
@@ -41,7 +50,8 @@ neblib::PID::PID(
       previousError(0.0),
       hasPreviousError(false),
       previousOutput(0.0),
-      timeSettled(0)
+      timeSettled(0),
+      carriedOver(false)
 {
 }
 
@@ -50,6 +60,8 @@ double neblib::PID::getOutput(
     double minOutput,
     double maxOutput)
 {
+    NEBLIB_TRACE_SCOPE("PID::getOutput");
+
     // Calculate Integral
     if (std::abs(error) <= behaviors.integralTolerance)
         integral += error;
@@ -57,7 +69,11 @@ double neblib::PID::getOutput(
         integral = 0.0;
 
     // Calculate Derivative
-    const double derivative = (hasPreviousError) ? error - previousError : error;
+    double derivative = error;
+    if (hasPreviousError)
+        derivative = error - previousError;
+    else if (carriedOver)
+        derivative = 0.0;
 
     // Calculate Output
     double output = neblib::clamp(gains.kP * error + gains.kI * integral + gains.kD * derivative, minOutput, maxOutput);
@@ -92,4 +108,12 @@ void neblib::PID::reset()
     hasPreviousError = false;
     previousOutput = 0.0;
     timeSettled = 0;
+    carriedOver = false;
+}
+
+void neblib::PID::reset(double initialOutput)
+{
+    reset();
+    previousOutput = initialOutput;
+    carriedOver = true;
 }
@@ -0,0 +1,121 @@
+#include "neblib/driver_input.hpp"
+#include <cmath>
+
+constexpr std::size_t neblib::InputCurve::tableSize;
+
+neblib::InputCurve::InputCurve(
+    Type type,
+    double deadband,
+    double curvature,
+    double minOutput)
+    : deadband(static_cast<float>(neblib::clamp(deadband / 100.0, 0.0, 0.99)))
+{
+    const double dead = this->deadband;
+    const double minimum = neblib::clamp(minOutput / 100.0, 0.0, 1.0);
+
+    for (std::size_t i = 0; i < tableSize; i++)
+    {
+        const double x = static_cast<double>(i) / (tableSize - 1);
+        if (x <= dead)
+        {
+            table[i] = 0.0f;
+            continue;
+        }
+
+        const double t = (x - dead) / (1.0 - dead);
+        double shaped = t;
+        if (type == Cubic)
+        {
+            const double weight = neblib::clamp(curvature, 0.0, 1.0);
+            shaped = (1.0 - weight) * t + weight * t * t * t;
+        }
+        else if (type == Exponential && std::abs(curvature) > 1e-6)
+        {
+            shaped = (std::exp(curvature * t) - 1.0) / (std::exp(curvature) - 1.0);
+        }
+
+        table[i] = static_cast<float>(minimum + (1.0 - minimum) * shaped);
+    }
+}
+
+double neblib::InputCurve::apply(double input) const
+{
+    const double magnitude = neblib::clamp(std::abs(input) / 100.0, 0.0, 1.0);
+    if (magnitude <= deadband)
+        return 0.0;
+
+    // Interpolate between the two nearest entries
+    const double position = magnitude * (tableSize - 1);
+    const std::size_t index = static_cast<std::size_t>(position);
+    double value = table[tableSize - 1];
+    if (index < tableSize - 1)
+        value = table[index] + (table[index + 1] - table[index]) * (position - index);
+
+    return (input < 0.0) ? -100.0 * value : 100.0 * value;
+}
+
+neblib::DriverInput::DriverInput(
+    vex::controller &controller,
+    int periodMS)
+    : controller(controller),
+      periodMS(periodMS),
+      sampleTime(0),
+      applied(true),
+      latency(250),
+      running(false)
+{
+    for (std::size_t i = 0; i < 4; i++)
+        values[i] = 0.0;
+}
+
+void neblib::DriverInput::setCurve(
+    Axis axis,
+    const neblib::InputCurve &curve)
+{
+    curves[axis] = curve;
+}
+
+void neblib::DriverInput::update()
+{
+    sampleTime = vex::timer::systemHighResolution();
+    values[Axis1] = curves[Axis1].apply(controller.Axis1.position(vex::percentUnits::pct));
+    values[Axis2] = curves[Axis2].apply(controller.Axis2.position(vex::percentUnits::pct));
+    values[Axis3] = curves[Axis3].apply(controller.Axis3.position(vex::percentUnits::pct));
+    values[Axis4] = curves[Axis4].apply(controller.Axis4.position(vex::percentUnits::pct));
+    applied = false;
+}
+
+int neblib::DriverInput::begin()
+{
+    running = true;
+    while (running)
+    {
+        update();
+        vex::task::sleep(periodMS);
+    }
+
+    return 0;
+}
+
+void neblib::DriverInput::stop()
+{
+    running = false;
+}
+
+double neblib::DriverInput::get(Axis axis) const
+{
+    return values[axis];
+}
+
+void neblib::DriverInput::markApplied()
+{
+    if (applied)
+        return;
+    latency.add(static_cast<std::uint32_t>(vex::timer::systemHighResolution() - sampleTime));
+    applied = true;
+}
+
+const neblib::LoopStats::Histogram &neblib::DriverInput::getLatency() const
+{
+    return latency;
+}
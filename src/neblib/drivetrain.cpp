@@ -0,0 +1,935 @@
+#include "neblib/drivetrain.hpp"
+#include "neblib/standard_drive.hpp"
+#include "neblib/xdrive.hpp"
+#include "neblib/trace.hpp"
+#include "neblib/transform.hpp"
+
+neblib::Chassis::Chassis(
+    vex::inertial &imu,
+    neblib::PositionTracking *positionTracking)
+    : imu(imu),
+      positionTracking(positionTracking),
+      sensorSnapshot(nullptr),
+      linearController(nullptr),
+      angularController(nullptr),
+      turnController(nullptr),
+      swingController(nullptr),
+      motorOutput(nullptr),
+      executor(nullptr),
+      controlStep(0),
+      telemetry(nullptr),
+      previousRecordTime(0),
+      telemetryGroups(),
+      telemetryGroupCount(0),
+      commandedVoltages(),
+      motionStats{neblib::LoopStats("drive"), neblib::LoopStats("turn"), neblib::LoopStats("swing"), neblib::LoopStats("arc")},
+      activeStats(nullptr),
+      playbackForwardGain(1.0),
+      playbackLateralGain(0.5),
+      playbackHeadingGain(0.2),
+      cancelRequested(false),
+      chained(false),
+      previousLinearOutput(0.0),
+      previousAngularOutput(0.0)
+{
+}
+
+void neblib::Chassis::resetController(
+    neblib::FeedbackController *controller,
+    double previousOutput)
+{
+    if (chained)
+        controller->reset(previousOutput);
+    else
+        controller->reset();
+}
+
+int neblib::Chassis::waitForTick()
+{
+    NEBLIB_TRACE_SCOPE("waitForTick");
+
+    if (activeStats)
+        activeStats->endIteration();
+
+    int period = 10;
+    if (executor)
+    {
+        period = executor->waitForControl(controlStep);
+    }
+    else
+    {
+        // Without an executor there is no output job, so the motion loop flushes its own commands
+        if (motorOutput)
+            motorOutput->flush();
+        vex::task::sleep(10);
+    }
+
+    if (activeStats)
+        activeStats->startIteration();
+    return period;
+}
+
+void neblib::Chassis::leaveControl()
+{
+    if (executor)
+        executor->leaveControl(controlStep);
+}
+
+void neblib::Chassis::addTelemetryGroup(vex::motor_group &motors)
+{
+    if (telemetryGroupCount < neblib::TelemetryRecord::voltageCount)
+        telemetryGroups[telemetryGroupCount++] = &motors;
+}
+
+void neblib::Chassis::setCommandedVoltage(
+    vex::motor_group &motors,
+    double voltage)
+{
+    for (std::size_t i = 0; i < telemetryGroupCount; i++)
+    {
+        if (telemetryGroups[i] == &motors)
+        {
+            commandedVoltages[i] = voltage;
+            return;
+        }
+    }
+}
+
+void neblib::Chassis::spinMotors(
+    vex::motor_group &motors,
+    double voltage,
+    vex::voltageUnits unit)
+{
+    setCommandedVoltage(motors, (unit == vex::voltageUnits::mV) ? voltage / 1000.0 : voltage);
+    const int group = (motorOutput) ? motorOutput->indexOf(motors) : -1;
+    if (group < 0)
+    {
+        motors.spin(vex::directionType::fwd, voltage, unit);
+        return;
+    }
+    motorOutput->set(group, (unit == vex::voltageUnits::mV) ? voltage / 1000.0 : voltage);
+}
+
+void neblib::Chassis::spinMotors(
+    vex::motor_group &motors,
+    double velocity,
+    vex::velocityUnits unit)
+{
+    setCommandedVoltage(motors, (unit == vex::velocityUnits::pct) ? velocity * 0.12 : 0.0);
+    const int group = (motorOutput && unit == vex::velocityUnits::pct) ? motorOutput->indexOf(motors) : -1;
+    if (group < 0)
+    {
+        motors.spin(vex::directionType::fwd, velocity, unit);
+        return;
+    }
+    motorOutput->set(group, velocity * 0.12);
+}
+
+void neblib::Chassis::stopMotors(
+    vex::motor_group &motors,
+    vex::brakeType brakeType)
+{
+    setCommandedVoltage(motors, 0.0);
+    const int group = (motorOutput) ? motorOutput->indexOf(motors) : -1;
+    if (group < 0)
+        motors.stop(brakeType);
+    else
+        motorOutput->stop(group, brakeType);
+}
+
+double neblib::Chassis::currentHeading()
+{
+    if (sensorSnapshot)
+        return sensorSnapshot->heading(imu);
+    return imu.heading();
+}
+
+double neblib::Chassis::currentRotation()
+{
+    if (sensorSnapshot)
+        return sensorSnapshot->rotation(imu);
+    return imu.rotation();
+}
+
+double neblib::Chassis::trackerPosition(neblib::TrackerWheel &trackerWheel)
+{
+    if (sensorSnapshot)
+        return sensorSnapshot->position(trackerWheel);
+    return trackerWheel.getPosition();
+}
+
+void neblib::Chassis::beginMotion(neblib::TelemetryRecord::Source source)
+{
+    cancelRequested.store(false);
+    activeStats = &getMotionStats(source);
+    activeStats->restart();
+    activeStats->startIteration();
+}
+
+bool neblib::Chassis::motionCancelled() const
+{
+    return cancelRequested.load();
+}
+
+void neblib::Chassis::cancelMotion()
+{
+    cancelRequested.store(true);
+}
+
+void neblib::Chassis::record(
+    neblib::TelemetryRecord::Source source,
+    double linearError,
+    double angularError,
+    double linearOutput,
+    double angularOutput)
+{
+    if (!telemetry)
+        return;
+
+    const std::uint64_t now = vex::timer::systemHighResolution();
+    const std::uint64_t loopTime = (previousRecordTime > 0) ? now - previousRecordTime : 0;
+    previousRecordTime = now;
+
+    neblib::TelemetryRecord record;
+    record.time = static_cast<std::uint32_t>(now / 1000);
+    record.source = static_cast<std::uint16_t>(source);
+    record.loopTime = static_cast<std::uint16_t>((loopTime < 65535) ? loopTime : 65535);
+    if (positionTracking)
+    {
+        const neblib::Pose pose = positionTracking->getPose();
+        record.x = static_cast<float>(pose.x);
+        record.y = static_cast<float>(pose.y);
+        record.heading = static_cast<float>(pose.heading);
+    }
+    else
+    {
+        record.heading = static_cast<float>(currentHeading());
+    }
+    record.linearError = static_cast<float>(linearError);
+    record.angularError = static_cast<float>(angularError);
+    record.linearOutput = static_cast<float>(linearOutput);
+    record.angularOutput = static_cast<float>(angularOutput);
+    for (std::size_t i = 0; i < telemetryGroupCount; i++)
+        record.voltages[i] = static_cast<float>(commandedVoltages[i]);
+    telemetry->push(record);
+}
+
+void neblib::Chassis::setLinearController(neblib::FeedbackController *linearController)
+{
+    this->linearController = linearController;
+}
+
+void neblib::Chassis::setAngularController(neblib::FeedbackController *angularController)
+{
+    this->angularController = angularController;
+}
+
+void neblib::Chassis::setTurnController(neblib::FeedbackController *turnController)
+{
+    this->turnController = turnController;
+}
+
+void neblib::Chassis::setSwingController(neblib::FeedbackController *swingController)
+{
+    this->swingController = swingController;
+}
+
+void neblib::Chassis::setExecutor(neblib::Executor *executor)
+{
+    this->executor = executor;
+}
+
+void neblib::Chassis::setTelemetry(neblib::TelemetryQueue *telemetry)
+{
+    this->telemetry = telemetry;
+}
+
+void neblib::Chassis::setSensorSnapshot(neblib::SensorSnapshot *sensorSnapshot)
+{
+    this->sensorSnapshot = sensorSnapshot;
+}
+
+void neblib::Chassis::setPlaybackGains(
+    double forwardGain,
+    double lateralGain,
+    double headingGain)
+{
+    playbackForwardGain = forwardGain;
+    playbackLateralGain = lateralGain;
+    playbackHeadingGain = headingGain;
+}
+
+neblib::LoopStats &neblib::Chassis::getMotionStats(neblib::TelemetryRecord::Source source)
+{
+    if (source > neblib::TelemetryRecord::Arc)
+        return motionStats[neblib::TelemetryRecord::Drive];
+    return motionStats[source];
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::driveToPose(
+    double x,
+    double y,
+    double heading,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    return driveToPose(
+        x,
+        y,
+        heading,
+        neblib::ChainConditions(0.0),
+        timeout,
+        minOutput,
+        maxOutput);
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::driveToPose(
+    double x,
+    double y,
+    double heading,
+    neblib::ChainConditions chain,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    const int result = beginPose(
+        neblib::Pose(x, y, heading),
+        chain,
+        neblib::toTimeout(timeout),
+        minOutput,
+        maxOutput);
+    return Kinematics::toElapsed((result < 0) ? result : runMotion());
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::driveTo(
+    double x,
+    double y,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    return driveTo(
+        x,
+        y,
+        neblib::ChainConditions(0.0),
+        timeout,
+        minOutput,
+        maxOutput);
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::driveTo(
+    double x,
+    double y,
+    neblib::ChainConditions chain,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    if (!this->positionTracking)
+        return -1;
+
+    return driveToPose(
+        x,
+        y,
+        this->pointHeading(this->positionTracking->getPose(), x, y),
+        chain,
+        timeout,
+        minOutput,
+        maxOutput);
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::followPath(
+    const neblib::Pose *path,
+    std::size_t count,
+    neblib::ChainConditions chain,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    const int limit = neblib::toTimeout(timeout);
+    int time = 0;
+    for (std::size_t i = 0; i < count && time < limit; i++)
+    {
+        // Every waypoint but the last exits early without stopping
+        const int result = beginPose(
+            path[i],
+            (i + 1 < count) ? chain : neblib::ChainConditions(0.0),
+            limit - time,
+            minOutput,
+            maxOutput);
+        if (result < 0)
+            return result;
+        time += runMotion();
+    }
+
+    if (this->chained)
+        this->stop(vex::brakeType::hold);
+    return Kinematics::toElapsed(time);
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::followPath(
+    const std::vector<neblib::Pose> &path,
+    neblib::ChainConditions chain,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    return followPath(
+        path.data(),
+        path.size(),
+        chain,
+        timeout,
+        minOutput,
+        maxOutput);
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::followRecording(
+    const neblib::PathRecording &recording,
+    Timeout timeout)
+{
+    if (!this->positionTracking)
+        return -1;
+    if (recording.size() == 0)
+        return -2;
+
+    this->beginMotion(neblib::TelemetryRecord::Drive);
+    const std::uint32_t start = vex::timer::system();
+    int time = 0;
+
+    while (time <= recording.getDuration() && time < neblib::toTimeout(timeout) && !this->motionCancelled())
+    {
+        NEBLIB_TRACE_SCOPE("followRecording");
+        const neblib::PathRecording::State target = recording.at(time);
+        const neblib::Pose current = this->positionTracking->getPose();
+
+        // ---------- Errors in the Robot's Frame ----------
+        double lateralError;
+        double forwardError;
+        neblib::Transform(current).toLocal(target.pose.x, target.pose.y, lateralError, forwardError);
+        const double headingError = neblib::wrap(target.pose.heading - current.heading, -180.0, 180.0);
+
+        // ---------- Recorded Command Plus Correction ----------
+        const double drive = neblib::clamp(target.drive + this->playbackForwardGain * forwardError, -12.0, 12.0);
+        const double strafe = neblib::clamp(target.strafe + this->playbackLateralGain * lateralError, -12.0, 12.0);
+        const double turn = neblib::clamp(target.turn + this->playbackHeadingGain * headingError, -12.0, 12.0);
+
+        this->driveCommand(drive, strafe, turn);
+        this->record(neblib::TelemetryRecord::Drive, forwardError, headingError, drive, turn);
+
+        this->waitForTick();
+        // Indexed by the clock rather than by counting ticks, so a late iteration doesn't fall behind the recording
+        time = static_cast<int>(vex::timer::system() - start);
+    }
+
+    this->leaveControl();
+    this->stop(vex::brakeType::hold);
+    return Kinematics::toElapsed(time);
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::turnFor(
+    double degrees,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    return Kinematics::toElapsed(turn(
+        this->currentRotation() + degrees,
+        true,
+        neblib::toTimeout(timeout),
+        minOutput,
+        maxOutput));
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::turnTo(
+    double heading,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    return Kinematics::toElapsed(turn(
+        heading,
+        false,
+        neblib::toTimeout(timeout),
+        minOutput,
+        maxOutput));
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::turn(
+    double target,
+    bool continuous,
+    int timeout,
+    double minOutput,
+    double maxOutput)
+{
+    const int result = beginTurn(
+        target,
+        continuous,
+        timeout,
+        minOutput,
+        maxOutput);
+    if (result < 0)
+        return result;
+    return runMotion();
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::runSwing(
+    vex::turnType side,
+    double target,
+    bool continuous,
+    double lower,
+    double upper,
+    int timeout,
+    double minOutput,
+    double maxOutput)
+{
+    if (!this->swingController)
+        return -1;
+
+    this->swingController->reset();
+
+    motion.kind = Motion::Swing;
+    motion.stepped = false;
+    motion.target = neblib::Pose(0.0, 0.0, target);
+    motion.continuous = continuous;
+    motion.side = side;
+    motion.lower = lower;
+    motion.upper = upper;
+    motion.timeout = timeout;
+    motion.minOutput = minOutput;
+    motion.maxOutput = maxOutput;
+    motion.time = 0;
+    this->beginMotion(neblib::TelemetryRecord::Swing);
+    return Kinematics::toElapsed(runMotion());
+}
+
+// ---------- Stepped Motions ----------
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::beginPose(
+    const neblib::Pose &target,
+    neblib::ChainConditions chain,
+    int timeout,
+    double minOutput,
+    double maxOutput)
+{
+    if (!this->positionTracking)
+        return -1;
+    if (!this->linearController)
+        return -2;
+
+    this->resetController(this->linearController, this->previousLinearOutput);
+    if (this->angularController)
+        this->resetController(this->angularController, this->previousAngularOutput);
+
+    motion.kind = Motion::Drive;
+    motion.stepped = false;
+    motion.target = target;
+    motion.chain = chain;
+    motion.timeout = timeout;
+    motion.minOutput = minOutput;
+    motion.maxOutput = maxOutput;
+    motion.time = 0;
+    this->beginMotion(neblib::TelemetryRecord::Drive);
+    return 0;
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::beginTurn(
+    double target,
+    bool continuous,
+    int timeout,
+    double minOutput,
+    double maxOutput)
+{
+    neblib::FeedbackController *controller = (this->turnController) ? this->turnController : this->angularController;
+    if (!controller)
+        return -1;
+
+    this->resetController(controller, this->previousAngularOutput);
+
+    motion.kind = Motion::Turn;
+    motion.stepped = false;
+    motion.target = neblib::Pose(0.0, 0.0, target);
+    motion.continuous = continuous;
+    motion.controller = controller;
+    motion.timeout = timeout;
+    motion.minOutput = minOutput;
+    motion.maxOutput = maxOutput;
+    motion.time = 0;
+    this->beginMotion(neblib::TelemetryRecord::Turn);
+    return 0;
+}
+
+template <class Kinematics>
+bool neblib::Drivetrain<Kinematics>::advanceMotion(int elapsed)
+{
+    motion.time += elapsed;
+
+    if (motion.kind == Motion::Drive)
+    {
+        const neblib::Pose &target = motion.target;
+        const neblib::Pose currentPose = this->positionTracking->getPose();
+        const double distance = hypot(target.x - currentPose.x, target.y - currentPose.y);
+        if (this->linearController->isSettled() ||
+            this->atPose(currentPose, target, distance) ||
+            motion.time >= motion.timeout ||
+            this->motionCancelled())
+        {
+            motion.kind = Motion::None;
+            this->stop(vex::brakeType::hold);
+            return false;
+        }
+
+        NEBLIB_TRACE_SCOPE("driveToPose");
+        if (distance < motion.chain.exitRadius)
+        {
+            // Exit without stopping, the next motion continues from the current output
+            motion.kind = Motion::None;
+            this->chained = true;
+            return false;
+        }
+
+        double drive = this->linearController->getOutput(
+            distance,
+            motion.minOutput,
+            motion.maxOutput);
+        if (std::abs(drive) < motion.chain.minSpeed)
+            drive = (drive < 0.0) ? -motion.chain.minSpeed : motion.chain.minSpeed;
+        const double angularError = this->angularError(currentPose, target, distance);
+        double turn = 0.0;
+        if (this->angularController)
+            turn = this->angularController->getOutput(
+                angularError,
+                motion.minOutput,
+                motion.maxOutput);
+
+        this->driveToward(currentPose, target, drive, turn);
+        this->record(neblib::TelemetryRecord::Drive, distance, angularError, drive, turn);
+        this->previousLinearOutput = drive;
+        this->previousAngularOutput = turn;
+        return true;
+    }
+
+    if (motion.kind == Motion::Turn)
+    {
+        if (motion.controller->isSettled() || motion.time >= motion.timeout || this->motionCancelled())
+        {
+            motion.kind = Motion::None;
+            this->stop(vex::brakeType::hold);
+            return false;
+        }
+
+        NEBLIB_TRACE_SCOPE("turn");
+        const double target = motion.target.heading;
+        const double error = (motion.continuous)
+                                 ? target - this->currentRotation()
+                                 : neblib::wrap(target - this->currentHeading(), -180.0, 180.0);
+        const double output = motion.controller->getOutput(
+            error,
+            motion.minOutput,
+            motion.maxOutput);
+
+        this->rotate(output);
+        this->record(neblib::TelemetryRecord::Turn, 0.0, error, 0.0, output);
+        return true;
+    }
+
+    if (motion.kind == Motion::Swing)
+    {
+        if (this->swingController->isSettled() || motion.time >= motion.timeout || this->motionCancelled())
+        {
+            motion.kind = Motion::None;
+            this->stop(vex::brakeType::hold);
+            return false;
+        }
+
+        NEBLIB_TRACE_SCOPE("swing");
+        // Positive error drives the swinging side forward, for either side
+        const double current = (motion.continuous) ? this->currentRotation() : this->currentHeading();
+        double error = (motion.side == vex::turnType::right) ? motion.target.heading - current : current - motion.target.heading;
+        if (!motion.continuous)
+            error = neblib::wrap(error, motion.lower, motion.upper);
+        const double output = this->swingController->getOutput(
+            error,
+            motion.minOutput,
+            motion.maxOutput);
+
+        swingSide<Kinematics::canSwing>(motion.side, output);
+        this->record(neblib::TelemetryRecord::Swing, 0.0, error, 0.0, output);
+        return true;
+    }
+
+    return false;
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::runMotion()
+{
+    int elapsed = 0;
+    while (advanceMotion(elapsed))
+        elapsed = this->waitForTick();
+    this->leaveControl();
+    return motion.time;
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::startDriveToPose(
+    double x,
+    double y,
+    double heading,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    return startDriveToPose(
+        x,
+        y,
+        heading,
+        neblib::ChainConditions(0.0),
+        timeout,
+        minOutput,
+        maxOutput);
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::startDriveToPose(
+    double x,
+    double y,
+    double heading,
+    neblib::ChainConditions chain,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    const int result = beginPose(
+        neblib::Pose(x, y, heading),
+        chain,
+        neblib::toTimeout(timeout),
+        minOutput,
+        maxOutput);
+    motion.stepped = result == 0;
+    motion.pending = motion.stepped;
+    return result;
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::startDriveTo(
+    double x,
+    double y,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    return startDriveTo(
+        x,
+        y,
+        neblib::ChainConditions(0.0),
+        timeout,
+        minOutput,
+        maxOutput);
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::startDriveTo(
+    double x,
+    double y,
+    neblib::ChainConditions chain,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    if (!this->positionTracking)
+        return -1;
+
+    return startDriveToPose(
+        x,
+        y,
+        this->pointHeading(this->positionTracking->getPose(), x, y),
+        chain,
+        timeout,
+        minOutput,
+        maxOutput);
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::startTurnFor(
+    double degrees,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    const int result = beginTurn(
+        this->currentRotation() + degrees,
+        true,
+        neblib::toTimeout(timeout),
+        minOutput,
+        maxOutput);
+    motion.stepped = result == 0;
+    motion.pending = motion.stepped;
+    return result;
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::startTurnTo(
+    double heading,
+    Timeout timeout,
+    double minOutput,
+    double maxOutput)
+{
+    const int result = beginTurn(
+        heading,
+        false,
+        neblib::toTimeout(timeout),
+        minOutput,
+        maxOutput);
+    motion.stepped = result == 0;
+    motion.pending = motion.stepped;
+    return result;
+}
+
+template <class Kinematics>
+bool neblib::Drivetrain<Kinematics>::stepMotion(int elapsed)
+{
+    if (!motion.stepped)
+        return false;
+    // A motion started during this tick has not run for any of it
+    if (motion.pending)
+    {
+        elapsed = 0;
+        motion.pending = false;
+    }
+    if (!advanceMotion(elapsed))
+        motion.stepped = false;
+    return motion.stepped;
+}
+
+template <class Kinematics>
+bool neblib::Drivetrain<Kinematics>::isMoving() const
+{
+    return motion.stepped;
+}
+
+template <class Kinematics>
+int neblib::Drivetrain<Kinematics>::getMotionTime() const
+{
+    return motion.time;
+}
+
+// ---------- Typed Overloads ----------
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::driveToPose(
+    Length x,
+    Length y,
+    Angle heading,
+    Time timeout,
+    Voltage minOutput,
+    Voltage maxOutput)
+{
+    return driveToPose(
+        x.inches(),
+        y.inches(),
+        heading.degrees(),
+        Timeout(neblib::toTimeout(timeout)),
+        minOutput.volts(),
+        maxOutput.volts());
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::driveToPose(
+    Length x,
+    Length y,
+    Angle heading,
+    neblib::ChainConditions chain,
+    Time timeout,
+    Voltage minOutput,
+    Voltage maxOutput)
+{
+    return driveToPose(
+        x.inches(),
+        y.inches(),
+        heading.degrees(),
+        chain,
+        Timeout(neblib::toTimeout(timeout)),
+        minOutput.volts(),
+        maxOutput.volts());
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::driveTo(
+    Length x,
+    Length y,
+    Time timeout,
+    Voltage minOutput,
+    Voltage maxOutput)
+{
+    return driveTo(
+        x.inches(),
+        y.inches(),
+        Timeout(neblib::toTimeout(timeout)),
+        minOutput.volts(),
+        maxOutput.volts());
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::driveTo(
+    Length x,
+    Length y,
+    neblib::ChainConditions chain,
+    Time timeout,
+    Voltage minOutput,
+    Voltage maxOutput)
+{
+    return driveTo(
+        x.inches(),
+        y.inches(),
+        chain,
+        Timeout(neblib::toTimeout(timeout)),
+        minOutput.volts(),
+        maxOutput.volts());
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::turnFor(
+    Angle angle,
+    Time timeout,
+    Voltage minOutput,
+    Voltage maxOutput)
+{
+    return turnFor(
+        angle.degrees(),
+        Timeout(neblib::toTimeout(timeout)),
+        minOutput.volts(),
+        maxOutput.volts());
+}
+
+template <class Kinematics>
+typename neblib::Drivetrain<Kinematics>::Elapsed neblib::Drivetrain<Kinematics>::turnTo(
+    Angle heading,
+    Time timeout,
+    Voltage minOutput,
+    Voltage maxOutput)
+{
+    return turnTo(
+        heading.degrees(),
+        Timeout(neblib::toTimeout(timeout)),
+        minOutput.volts(),
+        maxOutput.volts());
+}
+
+template class neblib::Drivetrain<neblib::DifferentialChassis>;
+template class neblib::Drivetrain<neblib::HolonomicChassis<3>>;
+template class neblib::Drivetrain<neblib::HolonomicChassis<4>>;
+template class neblib::Drivetrain<neblib::HolonomicChassis<6>>;
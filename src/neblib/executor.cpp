@@ -0,0 +1,235 @@
+#include "neblib/executor.hpp"
+#include "neblib/trace.hpp"
+
+constexpr std::size_t neblib::Executor::maxJobs;
+
+neblib::Executor::JobStats::JobStats()
+    : runs(0),
+      overruns(0),
+      lastTime(0),
+      maxTime(0),
+      totalTime(0)
+{
+}
+
+neblib::Executor::TickStats::TickStats()
+    : ticks(0),
+      deadlineMisses(0),
+      maxTickTime(0),
+      maxLateness(0),
+      controlTimeouts(0)
+{
+}
+
+neblib::Executor::Executor(int tickMS)
+    : tickMS(tickMS),
+      jobCount(0),
+      running(false),
+      tick(0),
+      tickStats(),
+      controlLock(),
+      controlPoint(0),
+      controlWaiting(0),
+      controlStepping(0)
+{
+}
+
+int neblib::Executor::addJob(
+    const char *name,
+    Stage stage,
+    void (*function)(void *),
+    void *context,
+    int periodTicks,
+    std::uint32_t budget)
+{
+    if (jobCount >= maxJobs || !function)
+        return -1;
+
+    // Insert after every job of the same or an earlier stage
+    std::size_t index = jobCount;
+    while (index > 0 && jobs[index - 1].stage > stage)
+    {
+        jobs[index] = jobs[index - 1];
+        index--;
+    }
+
+    Job &job = jobs[index];
+    job.name = name;
+    job.stage = stage;
+    job.periodTicks = (periodTicks > 0) ? periodTicks : 1;
+    job.budget = (budget > 0) ? budget : static_cast<std::uint32_t>(tickMS) * 1000;
+    job.function = function;
+    job.context = context;
+    job.stats = JobStats();
+    jobCount++;
+
+    return static_cast<int>(index);
+}
+
+int neblib::Executor::begin()
+{
+    const std::uint64_t period = static_cast<std::uint64_t>(tickMS) * 1000;
+    std::uint64_t nextStart = vex::timer::systemHighResolution();
+    running = true;
+
+    while (running)
+    {
+        const std::uint64_t tickStart = vex::timer::systemHighResolution();
+        const std::uint32_t lateness = static_cast<std::uint32_t>((tickStart > nextStart) ? tickStart - nextStart : 0);
+        if (lateness > tickStats.maxLateness)
+            tickStats.maxLateness = lateness;
+
+        // ---------- Run Due Jobs ----------
+        const std::uint32_t currentTick = tick.load();
+        bool handedOff = false;
+        for (std::size_t i = 0; i < jobCount; i++)
+        {
+            Job &job = jobs[i];
+            if (!handedOff && job.stage > Control)
+            {
+                handOffControl(tickStart);
+                handedOff = true;
+            }
+            if (currentTick % job.periodTicks != 0)
+                continue;
+
+            const std::uint64_t jobStart = vex::timer::systemHighResolution();
+            job.function(job.context);
+            const std::uint64_t jobEnd = vex::timer::systemHighResolution();
+            const std::uint32_t jobTime = static_cast<std::uint32_t>(jobEnd - jobStart);
+#if defined(NEBLIB_TRACE)
+            neblib::recordTrace(job.name, jobStart, jobEnd);
+#endif
+
+            job.stats.runs++;
+            job.stats.lastTime = jobTime;
+            job.stats.totalTime += jobTime;
+            if (jobTime > job.stats.maxTime)
+                job.stats.maxTime = jobTime;
+            if (jobTime > job.budget)
+                job.stats.overruns++;
+        }
+        if (!handedOff)
+            handOffControl(tickStart);
+
+        // ---------- Tick Statistics ----------
+        const std::uint64_t tickEnd = vex::timer::systemHighResolution();
+        const std::uint32_t tickTime = static_cast<std::uint32_t>(tickEnd - tickStart);
+        tickStats.ticks++;
+        if (tickTime > tickStats.maxTickTime)
+            tickStats.maxTickTime = tickTime;
+        tick.store(currentTick + 1);
+
+        // ---------- Wait For Next Tick ----------
+        nextStart += period;
+        if (tickEnd > nextStart)
+        {
+            // Missed the deadline, start the next tick now instead of running a burst of late ticks
+            tickStats.deadlineMisses++;
+            nextStart = tickEnd;
+            vex::task::yield();
+        }
+        else
+        {
+            vex::task::sleep(static_cast<std::uint32_t>((nextStart - tickEnd) / 1000));
+        }
+    }
+
+    return 0;
+}
+
+void neblib::Executor::handOffControl(std::uint64_t tickStart)
+{
+    controlLock.lock();
+    controlStepping.store(controlWaiting);
+    controlWaiting = 0;
+    controlPoint.store(controlPoint.load() + 1);
+    controlLock.unlock();
+
+    // Waiting loops run at a lower priority, so the executor has to sleep for them to run
+    const std::uint64_t deadline = tickStart + static_cast<std::uint64_t>(tickMS) * 500;
+    while (controlStepping.load() > 0)
+    {
+        if (vex::timer::systemHighResolution() >= deadline)
+        {
+            tickStats.controlTimeouts++;
+            return;
+        }
+        vex::task::sleep(1);
+    }
+}
+
+void neblib::Executor::stop()
+{
+    running = false;
+}
+
+int neblib::Executor::waitForTick()
+{
+    const std::uint32_t start = tick.load();
+    while (tick.load() == start)
+        vex::task::sleep(1);
+    return tickMS;
+}
+
+int neblib::Executor::waitForControl(std::uint32_t &step)
+{
+    controlLock.lock();
+    // Only count the step against the handoff that woke it, a late loop may come back after the next one
+    const std::uint32_t point = controlPoint.load();
+    if (step == point && controlStepping.load() > 0)
+        controlStepping.fetch_sub(1);
+    controlWaiting++;
+    controlLock.unlock();
+
+    while (controlPoint.load() == point)
+        vex::task::sleep(1);
+    step = point + 1;
+    return tickMS;
+}
+
+void neblib::Executor::leaveControl(std::uint32_t &step)
+{
+    controlLock.lock();
+    const std::uint32_t point = controlPoint.load();
+    if (step == point && controlStepping.load() > 0)
+        controlStepping.fetch_sub(1);
+    controlLock.unlock();
+
+    // A handoff already past, so the loop's next waitForControl() isn't counted as this step again
+    step = point - 1;
+}
+
+std::uint32_t neblib::Executor::getTick()
+{
+    return tick.load();
+}
+
+int neblib::Executor::getTickMS()
+{
+    return tickMS;
+}
+
+std::size_t neblib::Executor::getJobCount()
+{
+    return jobCount;
+}
+
+const char *neblib::Executor::getJobName(std::size_t index)
+{
+    if (index >= jobCount)
+        return nullptr;
+    return jobs[index].name;
+}
+
+neblib::Executor::JobStats neblib::Executor::getJobStats(std::size_t index)
+{
+    if (index >= jobCount)
+        return JobStats();
+    return jobs[index].stats;
+}
+
+neblib::Executor::TickStats neblib::Executor::getTickStats()
+{
+    return tickStats;
+}
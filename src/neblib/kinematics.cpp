@@ -0,0 +1,35 @@
+#include "neblib/kinematics.hpp"
+
+neblib::HolonomicKinematics<4> neblib::xDriveKinematics()
+{
+    return HolonomicKinematics<4>({HolonomicKinematics<4>::Wheel(1.0, 1.0, 1.0),
+                                   HolonomicKinematics<4>::Wheel(1.0, -1.0, -1.0),
+                                   HolonomicKinematics<4>::Wheel(1.0, -1.0, 1.0),
+                                   HolonomicKinematics<4>::Wheel(1.0, 1.0, -1.0)});
+}
+
+neblib::HolonomicKinematics<4> neblib::mecanumKinematics(double strafeGain)
+{
+    return HolonomicKinematics<4>({HolonomicKinematics<4>::Wheel(1.0, strafeGain, 1.0),
+                                   HolonomicKinematics<4>::Wheel(1.0, -strafeGain, -1.0),
+                                   HolonomicKinematics<4>::Wheel(1.0, -strafeGain, 1.0),
+                                   HolonomicKinematics<4>::Wheel(1.0, strafeGain, -1.0)});
+}
+
+neblib::HolonomicKinematics<3> neblib::hDriveKinematics(double strafeGain)
+{
+    return HolonomicKinematics<3>({HolonomicKinematics<3>::Wheel(1.0, 0.0, 1.0),
+                                   HolonomicKinematics<3>::Wheel(1.0, 0.0, -1.0),
+                                   HolonomicKinematics<3>::Wheel(0.0, strafeGain, 0.0)});
+}
+
+neblib::HolonomicKinematics<6> neblib::asteriskKinematics(double centerRatio)
+{
+    // Corner wheels sit at 45 degrees, so only cos(45) of their speed moves the robot forward or sideways
+    return HolonomicKinematics<6>({HolonomicKinematics<6>::Wheel(M_SQRT1_2, M_SQRT1_2, 1.0),
+                                   HolonomicKinematics<6>::Wheel(M_SQRT1_2, -M_SQRT1_2, -1.0),
+                                   HolonomicKinematics<6>::Wheel(M_SQRT1_2, -M_SQRT1_2, 1.0),
+                                   HolonomicKinematics<6>::Wheel(M_SQRT1_2, M_SQRT1_2, -1.0),
+                                   HolonomicKinematics<6>::Wheel(1.0, 0.0, centerRatio),
+                                   HolonomicKinematics<6>::Wheel(1.0, 0.0, -centerRatio)});
+}
@@ -0,0 +1,194 @@
+#include "neblib/loop_stats.hpp"
+#include <cstdio>
+
+constexpr std::size_t neblib::LoopStats::bucketCount;
+
+neblib::LoopStats::Histogram::Histogram(std::uint32_t bucketWidth)
+    : bucketWidth((bucketWidth > 0) ? bucketWidth : 1)
+{
+    reset();
+}
+
+void neblib::LoopStats::Histogram::add(std::uint32_t value)
+{
+    const std::uint32_t index = value / bucketWidth;
+    buckets[(index < bucketCount) ? index : bucketCount - 1]++;
+
+    if (count == 0 || value < min)
+        min = value;
+    if (value > max)
+        max = value;
+    total += value;
+    count++;
+}
+
+void neblib::LoopStats::Histogram::reset()
+{
+    for (std::size_t i = 0; i < bucketCount; i++)
+        buckets[i] = 0;
+    count = 0;
+    min = 0;
+    max = 0;
+    total = 0;
+}
+
+std::uint32_t neblib::LoopStats::Histogram::getPercentile(double percentile) const
+{
+    if (count == 0)
+        return 0;
+
+    // Smallest number of samples at or below the percentile
+    const double rank = (percentile / 100.0) * count;
+    std::uint32_t seen = 0;
+    for (std::size_t i = 0; i < bucketCount; i++)
+    {
+        seen += buckets[i];
+        if (seen > 0 && seen >= rank)
+        {
+            const std::uint32_t upper = static_cast<std::uint32_t>(i + 1) * bucketWidth;
+            return (upper < max) ? upper : max;
+        }
+    }
+    return max;
+}
+
+std::uint32_t neblib::LoopStats::Histogram::getCount() const
+{
+    return count;
+}
+
+std::uint32_t neblib::LoopStats::Histogram::getMin() const
+{
+    return min;
+}
+
+std::uint32_t neblib::LoopStats::Histogram::getMax() const
+{
+    return max;
+}
+
+double neblib::LoopStats::Histogram::getMean() const
+{
+    if (count == 0)
+        return 0.0;
+    return static_cast<double>(total) / count;
+}
+
+std::uint32_t neblib::LoopStats::Histogram::getBucketWidth() const
+{
+    return bucketWidth;
+}
+
+std::uint32_t neblib::LoopStats::Histogram::getBucket(std::size_t index) const
+{
+    if (index >= bucketCount)
+        return 0;
+    return buckets[index];
+}
+
+neblib::LoopStats::LoopStats(
+    const char *name,
+    std::uint32_t targetPeriod,
+    std::uint32_t periodBucketWidth,
+    std::uint32_t executionBucketWidth)
+    : name(name),
+      targetPeriod(targetPeriod),
+      period(periodBucketWidth),
+      execution(executionBucketWidth),
+      overruns(0),
+      iterationStart(0),
+      previousStart(0)
+{
+}
+
+void neblib::LoopStats::startIteration()
+{
+    iterationStart = vex::timer::systemHighResolution();
+    if (previousStart > 0)
+        period.add(static_cast<std::uint32_t>(iterationStart - previousStart));
+    previousStart = iterationStart;
+}
+
+void neblib::LoopStats::endIteration()
+{
+    if (iterationStart == 0)
+        return;
+
+    const std::uint32_t time = static_cast<std::uint32_t>(vex::timer::systemHighResolution() - iterationStart);
+    execution.add(time);
+    if (time > targetPeriod)
+        overruns++;
+    iterationStart = 0;
+}
+
+void neblib::LoopStats::restart()
+{
+    iterationStart = 0;
+    previousStart = 0;
+}
+
+void neblib::LoopStats::reset()
+{
+    period.reset();
+    execution.reset();
+    overruns = 0;
+    restart();
+}
+
+const char *neblib::LoopStats::getName() const
+{
+    return name;
+}
+
+const neblib::LoopStats::Histogram &neblib::LoopStats::getPeriod() const
+{
+    return period;
+}
+
+const neblib::LoopStats::Histogram &neblib::LoopStats::getExecution() const
+{
+    return execution;
+}
+
+std::uint32_t neblib::LoopStats::getOverruns() const
+{
+    return overruns;
+}
+
+int neblib::LoopStats::format(
+    char *buffer,
+    std::size_t size) const
+{
+    return std::snprintf(
+        buffer,
+        size,
+        "%s n=%lu period min/p99/max=%lu/%lu/%lu us exec mean/p99/max=%.0f/%lu/%lu us overruns=%lu",
+        name,
+        static_cast<unsigned long>(execution.getCount()),
+        static_cast<unsigned long>(period.getMin()),
+        static_cast<unsigned long>(period.getPercentile(99.0)),
+        static_cast<unsigned long>(period.getMax()),
+        execution.getMean(),
+        static_cast<unsigned long>(execution.getPercentile(99.0)),
+        static_cast<unsigned long>(execution.getMax()),
+        static_cast<unsigned long>(overruns));
+}
+
+void neblib::LoopStats::print(
+    vex::brain::lcd &screen,
+    int row) const
+{
+    screen.setCursor(row, 1);
+    screen.print(
+        "%s period %lu/%lu/%lu",
+        name,
+        static_cast<unsigned long>(period.getMin()),
+        static_cast<unsigned long>(period.getPercentile(99.0)),
+        static_cast<unsigned long>(period.getMax()));
+    screen.setCursor(row + 1, 1);
+    screen.print(
+        "  exec %lu/%lu over %lu",
+        static_cast<unsigned long>(execution.getPercentile(99.0)),
+        static_cast<unsigned long>(execution.getMax()),
+        static_cast<unsigned long>(overruns));
+}
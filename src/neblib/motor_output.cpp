@@ -0,0 +1,177 @@
+#include "neblib/motor_output.hpp"
+#include <cmath>
+
+constexpr std::size_t neblib::MotorOutput::maxGroups;
+
+neblib::MotorOutput::Limits::Limits(
+    double slew,
+    double jerk)
+    : slew(slew),
+      jerk(jerk)
+{
+}
+
+neblib::MotorOutput::Group::Group()
+    : motors(nullptr),
+      limits(),
+      target(0.0),
+      output(0.0),
+      rate(0.0),
+      sent(0.0),
+      stopped(false),
+      brake(vex::brakeType::coast),
+      hasSent(false)
+{
+}
+
+neblib::MotorOutput::MotorOutput(
+    double maxVoltage,
+    double changeThreshold)
+    : maxVoltage(maxVoltage),
+      changeThreshold(changeThreshold),
+      groupCount(0),
+      previousFlush(0),
+      commandsSent(0),
+      commandsSuppressed(0)
+{
+}
+
+int neblib::MotorOutput::addGroup(
+    vex::motor_group &motors,
+    Limits limits)
+{
+    const int existing = indexOf(motors);
+    if (existing >= 0)
+    {
+        groups[existing].limits = limits;
+        return existing;
+    }
+    if (groupCount >= maxGroups)
+        return -1;
+
+    groups[groupCount] = Group();
+    groups[groupCount].motors = &motors;
+    groups[groupCount].limits = limits;
+    return static_cast<int>(groupCount++);
+}
+
+int neblib::MotorOutput::indexOf(const vex::motor_group &motors) const
+{
+    for (std::size_t i = 0; i < groupCount; i++)
+        if (groups[i].motors == &motors)
+            return static_cast<int>(i);
+    return -1;
+}
+
+void neblib::MotorOutput::setLimits(
+    int group,
+    Limits limits)
+{
+    if (group < 0 || static_cast<std::size_t>(group) >= groupCount)
+        return;
+    groups[group].limits = limits;
+}
+
+void neblib::MotorOutput::set(
+    int group,
+    double voltage)
+{
+    if (group < 0 || static_cast<std::size_t>(group) >= groupCount)
+        return;
+    groups[group].target = neblib::clamp(voltage, -maxVoltage, maxVoltage);
+}
+
+void neblib::MotorOutput::stop(
+    int group,
+    vex::brakeType brakeType)
+{
+    if (group < 0 || static_cast<std::size_t>(group) >= groupCount)
+        return;
+
+    Group &state = groups[group];
+    if (state.stopped && state.brake == brakeType && state.target == 0.0)
+    {
+        commandsSuppressed++;
+        return;
+    }
+
+    state.motors->stop(brakeType);
+    state.brake = brakeType;
+    state.target = 0.0;
+    state.output = 0.0;
+    state.rate = 0.0;
+    state.sent = 0.0;
+    state.stopped = true;
+    state.hasSent = true;
+    commandsSent++;
+}
+
+void neblib::MotorOutput::flush()
+{
+    // Cap the step so a late flush does not skip past the rate limits
+    const std::uint64_t now = vex::timer::systemHighResolution();
+    double dt = (previousFlush > 0) ? (now - previousFlush) / 1e6 : 0.01;
+    if (dt > 0.05)
+        dt = 0.05;
+    previousFlush = now;
+
+    for (std::size_t i = 0; i < groupCount; i++)
+    {
+        Group &state = groups[i];
+
+        // A stopped group stays stopped, holding its brake, until asked to move again
+        if (state.stopped && state.target == 0.0)
+            continue;
+        state.stopped = false;
+
+        // ---------- Rate Limiting ----------
+        const double error = state.target - state.output;
+        double rate = (dt > 0.0) ? error / dt : 0.0;
+        rate = neblib::clamp(rate, -state.limits.slew, state.limits.slew);
+        if (std::isfinite(state.limits.jerk))
+        {
+            // Slow down early enough to reach the target without overshooting it
+            const double stoppingRate = std::sqrt(2.0 * state.limits.jerk * std::abs(error));
+            rate = neblib::clamp(rate, -stoppingRate, stoppingRate);
+            rate = neblib::clamp(rate, state.rate - state.limits.jerk * dt, state.rate + state.limits.jerk * dt);
+        }
+
+        state.output += rate * dt;
+        state.rate = rate;
+        if ((error > 0.0 && state.output > state.target) || (error < 0.0 && state.output < state.target) || error == 0.0)
+        {
+            state.output = state.target;
+            state.rate = 0.0;
+        }
+        state.output = neblib::clamp(state.output, -maxVoltage, maxVoltage);
+
+        // ---------- Change Suppression ----------
+        if (state.hasSent && std::abs(state.output - state.sent) < changeThreshold)
+        {
+            commandsSuppressed++;
+            continue;
+        }
+
+        state.motors->spin(vex::directionType::fwd, state.output, vex::voltageUnits::volt);
+        state.sent = state.output;
+        state.hasSent = true;
+        commandsSent++;
+    }
+}
+
+double neblib::MotorOutput::getOutput(int group) const
+{
+    if (group < 0 || static_cast<std::size_t>(group) >= groupCount)
+        return 0.0;
+    return groups[group].sent;
+}
+
+std::uint32_t neblib::MotorOutput::getCommandsSent() const
+{
+    return commandsSent;
+}
+
+std::uint32_t neblib::MotorOutput::getCommandsSuppressed() const
+{
+    return commandsSuppressed;
+}
@@ -0,0 +1,437 @@
+#include "neblib/path_planner.hpp"
+#include "neblib/util.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const std::uint32_t noParent = 0xFFFFFFFF;
+    const float unvisited = 3.0e38f;
+
+    const int neighborColumns[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    const int neighborRows[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+    const float neighborCosts[8] = {1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f};
+
+    /// @brief Straight line distance between two cells
+    float euclidean(int column0, int row0, int column1, int row1)
+    {
+        const float dx = static_cast<float>(column1 - column0);
+        const float dy = static_cast<float>(row1 - row0);
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    /// @brief Shortest 8-connected distance between two cells
+    float octile(int column0, int row0, int column1, int row1)
+    {
+        const float dx = static_cast<float>(std::abs(column1 - column0));
+        const float dy = static_cast<float>(std::abs(row1 - row0));
+        return (dx > dy) ? dx + 0.41421356f * dy : dy + 0.41421356f * dx;
+    }
+}
+
+neblib::PathPlanner::PathPlanner(
+    const std::uint8_t *occupancy,
+    int width,
+    int height,
+    double cellSize,
+    double robotRadius,
+    double originX,
+    double originY)
+    : width(width),
+      height(height),
+      cellSize(cellSize),
+      originX(originX),
+      originY(originY),
+      blocked(width * height, 0),
+      nodes(width * height),
+      openList(width * height),
+      cellPath(width * height),
+      openSize(0),
+      search(0)
+{
+    // ---------- Inflate Obstacles ----------
+    const double radiusCells = robotRadius / cellSize + 0.5;
+    const int reach = static_cast<int>(std::ceil(radiusCells));
+    const double radiusSquared = radiusCells * radiusCells;
+
+    for (int row = 0; row < height; row++)
+    {
+        for (int column = 0; column < width; column++)
+        {
+            // Field walls block every cell closer than the robot radius
+            const double wallDistance = std::min(
+                std::min(column + 0.5, width - column - 0.5),
+                std::min(row + 0.5, height - row - 0.5));
+            if (wallDistance * cellSize < robotRadius)
+                blocked[row * width + column] = 1;
+
+            if (!occupancy[row * width + column])
+                continue;
+
+            for (int dy = -reach; dy <= reach; dy++)
+            {
+                for (int dx = -reach; dx <= reach; dx++)
+                {
+                    const int stampColumn = column + dx;
+                    const int stampRow = row + dy;
+                    if (stampColumn < 0 || stampColumn >= width || stampRow < 0 || stampRow >= height)
+                        continue;
+                    if (dx * dx + dy * dy <= radiusSquared)
+                        blocked[stampRow * width + stampColumn] = 1;
+                }
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < nodes.size(); i++)
+        nodes[i].search = 0;
+}
+
+bool neblib::PathPlanner::isBlockedCell(
+    int column,
+    int row) const
+{
+    if (column < 0 || column >= width || row < 0 || row >= height)
+        return true;
+    return blocked[row * width + column] != 0;
+}
+
+bool neblib::PathPlanner::lineOfSight(
+    int column0,
+    int row0,
+    int column1,
+    int row1) const
+{
+    // Walks every cell the line between the cell centers passes through
+    int dx = std::abs(column1 - column0);
+    int dy = std::abs(row1 - row0);
+    const int columnStep = (column1 > column0) ? 1 : -1;
+    const int rowStep = (row1 > row0) ? 1 : -1;
+    int column = column0;
+    int row = row0;
+    int error = dx - dy;
+    dx *= 2;
+    dy *= 2;
+
+    for (int remaining = 1 + std::abs(column1 - column0) + std::abs(row1 - row0); remaining > 0; remaining--)
+    {
+        if (isBlockedCell(column, row))
+            return false;
+
+        if (error > 0)
+        {
+            column += columnStep;
+            error -= dy;
+        }
+        else if (error < 0)
+        {
+            row += rowStep;
+            error += dx;
+        }
+        else
+        {
+            // Passes exactly through a corner, both cells next to it must be free
+            if (isBlockedCell(column + columnStep, row) || isBlockedCell(column, row + rowStep))
+                return false;
+            column += columnStep;
+            row += rowStep;
+            error += dx - dy;
+            remaining--;
+        }
+    }
+
+    return true;
+}
+
+neblib::PathPlanner::Node &neblib::PathPlanner::node(std::uint32_t index)
+{
+    Node &n = nodes[index];
+    if (n.search != search)
+    {
+        n.g = unvisited;
+        n.f = unvisited;
+        n.parent = noParent;
+        n.search = search;
+        n.heapIndex = noParent;
+        n.closed = false;
+    }
+    return n;
+}
+
+void neblib::PathPlanner::push(std::uint32_t index)
+{
+    Node &n = nodes[index];
+    if (n.heapIndex == noParent)
+    {
+        n.heapIndex = static_cast<std::uint32_t>(openSize);
+        openList[openSize] = index;
+        openSize++;
+    }
+    siftUp(n.heapIndex);
+}
+
+std::uint32_t neblib::PathPlanner::pop()
+{
+    const std::uint32_t top = openList[0];
+    nodes[top].heapIndex = noParent;
+    openSize--;
+    if (openSize > 0)
+    {
+        openList[0] = openList[openSize];
+        nodes[openList[0]].heapIndex = 0;
+        siftDown(0);
+    }
+    return top;
+}
+
+bool neblib::PathPlanner::before(
+    std::uint32_t a,
+    std::uint32_t b) const
+{
+    // Ties go to the node closer to the goal, which avoids expanding every equal cost cell in open areas
+    if (nodes[a].f != nodes[b].f)
+        return nodes[a].f < nodes[b].f;
+    return nodes[a].g > nodes[b].g;
+}
+
+void neblib::PathPlanner::siftUp(std::size_t position)
+{
+    const std::uint32_t index = openList[position];
+    while (position > 0)
+    {
+        const std::size_t parent = (position - 1) / 2;
+        if (!before(index, openList[parent]))
+            break;
+        openList[position] = openList[parent];
+        nodes[openList[position]].heapIndex = static_cast<std::uint32_t>(position);
+        position = parent;
+    }
+    openList[position] = index;
+    nodes[index].heapIndex = static_cast<std::uint32_t>(position);
+}
+
+void neblib::PathPlanner::siftDown(std::size_t position)
+{
+    const std::uint32_t index = openList[position];
+    while (true)
+    {
+        std::size_t child = 2 * position + 1;
+        if (child >= openSize)
+            break;
+        if (child + 1 < openSize && before(openList[child + 1], openList[child]))
+            child++;
+        if (!before(openList[child], index))
+            break;
+        openList[position] = openList[child];
+        nodes[openList[position]].heapIndex = static_cast<std::uint32_t>(position);
+        position = child;
+    }
+    openList[position] = index;
+    nodes[index].heapIndex = static_cast<std::uint32_t>(position);
+}
+
+bool neblib::PathPlanner::toCell(
+    double x,
+    double y,
+    int &column,
+    int &row) const
+{
+    column = static_cast<int>(std::floor((x - originX) / cellSize));
+    row = static_cast<int>(std::floor((y - originY) / cellSize));
+    return column >= 0 && column < width && row >= 0 && row < height;
+}
+
+bool neblib::PathPlanner::isBlocked(
+    double x,
+    double y) const
+{
+    int column, row;
+    if (!toCell(x, y, column, row))
+        return true;
+    return isBlockedCell(column, row);
+}
+
+std::uint32_t neblib::PathPlanner::getSignature() const
+{
+    // Every field is hashed in order, the doubles bit for bit
+    std::uint32_t signature = neblib::hash(&width, sizeof(width));
+    signature = neblib::hash(&height, sizeof(height), signature);
+    signature = neblib::hash(&cellSize, sizeof(cellSize), signature);
+    signature = neblib::hash(&originX, sizeof(originX), signature);
+    signature = neblib::hash(&originY, sizeof(originY), signature);
+    return neblib::hash(blocked.data(), blocked.size(), signature);
+}
+
+int neblib::PathPlanner::plan(
+    const neblib::Pose &start,
+    const neblib::Pose &goal,
+    neblib::Pose *path,
+    int maxWaypoints,
+    bool anyAngle)
+{
+    int startColumn, startRow, goalColumn, goalRow;
+    if (!toCell(start.x, start.y, startColumn, startRow) || isBlockedCell(startColumn, startRow))
+        return -1;
+    if (!toCell(goal.x, goal.y, goalColumn, goalRow) || isBlockedCell(goalColumn, goalRow))
+        return -2;
+
+    // A new search id invalidates every node without touching the pool
+    search++;
+    if (search == 0)
+    {
+        for (std::size_t i = 0; i < nodes.size(); i++)
+            nodes[i].search = 0;
+        search = 1;
+    }
+    openSize = 0;
+
+    const std::uint32_t startIndex = startRow * width + startColumn;
+    const std::uint32_t goalIndex = goalRow * width + goalColumn;
+    Node &startNode = node(startIndex);
+    startNode.g = 0.0f;
+    startNode.f = (anyAngle) ? euclidean(startColumn, startRow, goalColumn, goalRow) : octile(startColumn, startRow, goalColumn, goalRow);
+    push(startIndex);
+
+    // ---------- Search ----------
+    bool found = false;
+    while (openSize > 0)
+    {
+        const std::uint32_t current = pop();
+        if (current == goalIndex)
+        {
+            found = true;
+            break;
+        }
+
+        Node &currentNode = nodes[current];
+        const int column = current % width;
+        const int row = current / width;
+
+        // Lazy Theta*: the parent was assumed visible when this node was reached, check it now
+        if (anyAngle && currentNode.parent != noParent)
+        {
+            const std::uint32_t parent = currentNode.parent;
+            if (!lineOfSight(parent % width, parent / width, column, row))
+            {
+                // Fall back to the best expanded neighbor
+                currentNode.g = unvisited;
+                for (int i = 0; i < 8; i++)
+                {
+                    const int neighborColumn = column + neighborColumns[i];
+                    const int neighborRow = row + neighborRows[i];
+                    if (isBlockedCell(neighborColumn, neighborRow))
+                        continue;
+                    const std::uint32_t neighbor = neighborRow * width + neighborColumn;
+                    const Node &neighborNode = node(neighbor);
+                    if (!neighborNode.closed)
+                        continue;
+                    const float g = neighborNode.g + neighborCosts[i];
+                    if (g < currentNode.g)
+                    {
+                        currentNode.g = g;
+                        currentNode.parent = neighbor;
+                    }
+                }
+            }
+        }
+        currentNode.closed = true;
+
+        for (int i = 0; i < 8; i++)
+        {
+            const int neighborColumn = column + neighborColumns[i];
+            const int neighborRow = row + neighborRows[i];
+            if (isBlockedCell(neighborColumn, neighborRow))
+                continue;
+            // Diagonal moves may not cut the corner of a blocked cell
+            if (i >= 4 && (isBlockedCell(neighborColumn, row) || isBlockedCell(column, neighborRow)))
+                continue;
+
+            const std::uint32_t neighbor = neighborRow * width + neighborColumn;
+            Node &neighborNode = node(neighbor);
+            if (neighborNode.closed)
+                continue;
+
+            std::uint32_t parent = current;
+            float g = currentNode.g + neighborCosts[i];
+
+            // Theta*: connect straight to the grandparent, visibility is checked when the neighbor is expanded
+            if (anyAngle && currentNode.parent != noParent)
+            {
+                const int parentColumn = currentNode.parent % width;
+                const int parentRow = currentNode.parent / width;
+                parent = currentNode.parent;
+                g = nodes[parent].g + euclidean(parentColumn, parentRow, neighborColumn, neighborRow);
+            }
+
+            if (g >= neighborNode.g)
+                continue;
+
+            neighborNode.g = g;
+            neighborNode.f = g + ((anyAngle) ? euclidean(neighborColumn, neighborRow, goalColumn, goalRow) : octile(neighborColumn, neighborRow, goalColumn, goalRow));
+            neighborNode.parent = parent;
+            push(neighbor);
+        }
+    }
+
+    if (!found)
+        return -3;
+
+    // ---------- Reconstruct Path ----------
+    if (startIndex == goalIndex)
+    {
+        if (maxWaypoints < 1)
+            return -4;
+        path[0] = goal;
+        return 1;
+    }
+
+    std::size_t length = 0;
+    for (std::uint32_t index = goalIndex; index != startIndex; index = nodes[index].parent)
+        cellPath[length++] = index;
+
+    // Only keep cells where the direction changes
+    int count = 0;
+    int previousColumn = startColumn;
+    int previousRow = startRow;
+    double previousX = start.x;
+    double previousY = start.y;
+    for (std::size_t i = length; i-- > 0;)
+    {
+        const int column = cellPath[i] % width;
+        const int row = cellPath[i] / width;
+        if (i > 0)
+        {
+            const int nextColumn = cellPath[i - 1] % width;
+            const int nextRow = cellPath[i - 1] / width;
+            if ((column - previousColumn) * (nextRow - row) == (row - previousRow) * (nextColumn - column))
+                continue;
+        }
+
+        if (count >= maxWaypoints)
+            return -4;
+
+        const double x = (i > 0) ? originX + (column + 0.5) * cellSize : goal.x;
+        const double y = (i > 0) ? originY + (row + 0.5) * cellSize : goal.y;
+        const double heading = (i > 0) ? neblib::wrap(neblib::toDeg(atan2(x - previousX, y - previousY)), 0.0, 360.0) : goal.heading;
+        path[count++] = neblib::Pose(x, y, heading);
+
+        previousColumn = column;
+        previousRow = row;
+        previousX = x;
+        previousY = y;
+    }
+
+    return count;
+}
+
+int neblib::PathPlanner::plan(
+    const neblib::Pose &start,
+    const neblib::Pose &goal,
+    std::vector<neblib::Pose> &path,
+    bool anyAngle)
+{
+    path.resize(cellPath.size());
+    const int count = plan(start, goal, path.data(), static_cast<int>(path.size()), anyAngle);
+    path.resize((count > 0) ? count : 0);
+    return count;
+}
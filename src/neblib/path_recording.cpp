@@ -0,0 +1,310 @@
+#include "neblib/path_recording.hpp"
+#include <cmath>
+
+constexpr std::size_t neblib::PathRecording::headerSize;
+constexpr std::size_t neblib::PathRecording::sampleSize;
+
+namespace
+{
+    const std::uint8_t magic[4] = {'N', 'B', 'P', 'R'};
+    const std::uint16_t version = 1;
+
+    std::int16_t toFixed(double value)
+    {
+        const double rounded = std::floor(value + 0.5);
+        if (rounded > 32767.0)
+            return 32767;
+        if (rounded < -32768.0)
+            return -32768;
+        return static_cast<std::int16_t>(rounded);
+    }
+
+    void writeU16(
+        std::uint8_t *buffer,
+        std::uint16_t value)
+    {
+        buffer[0] = static_cast<std::uint8_t>(value);
+        buffer[1] = static_cast<std::uint8_t>(value >> 8);
+    }
+
+    void writeU32(
+        std::uint8_t *buffer,
+        std::uint32_t value)
+    {
+        writeU16(buffer, static_cast<std::uint16_t>(value));
+        writeU16(buffer + 2, static_cast<std::uint16_t>(value >> 16));
+    }
+
+    std::uint16_t readU16(const std::uint8_t *buffer)
+    {
+        return static_cast<std::uint16_t>(buffer[0] | (buffer[1] << 8));
+    }
+
+    std::uint32_t readU32(const std::uint8_t *buffer)
+    {
+        return readU16(buffer) | (static_cast<std::uint32_t>(readU16(buffer + 2)) << 16);
+    }
+} // namespace
+
+neblib::PathRecording::State::State()
+    : pose(),
+      drive(0.0),
+      strafe(0.0),
+      turn(0.0)
+{
+}
+
+neblib::PathRecording::PathRecording(
+    std::size_t capacity,
+    int periodMS)
+    : samples(),
+      maxSamples(capacity),
+      periodMS((periodMS > 0) ? periodMS : 1)
+{
+    samples.reserve(maxSamples);
+}
+
+neblib::PathRecording::Sample neblib::PathRecording::encode(
+    const Pose &pose,
+    double drive,
+    double strafe,
+    double turn)
+{
+    Sample sample;
+    sample.x = toFixed(pose.x * 100.0);
+    sample.y = toFixed(pose.y * 100.0);
+    sample.heading = static_cast<std::uint16_t>(static_cast<std::int32_t>(std::floor(neblib::wrap(pose.heading, 0.0, 360.0) * 65536.0 / 360.0 + 0.5)));
+    sample.drive = toFixed(drive * 1000.0);
+    sample.strafe = toFixed(strafe * 1000.0);
+    sample.turn = toFixed(turn * 1000.0);
+    return sample;
+}
+
+neblib::PathRecording::State neblib::PathRecording::decode(const Sample &sample)
+{
+    State state;
+    state.pose = Pose(
+        sample.x / 100.0,
+        sample.y / 100.0,
+        sample.heading * 360.0 / 65536.0);
+    state.drive = sample.drive / 1000.0;
+    state.strafe = sample.strafe / 1000.0;
+    state.turn = sample.turn / 1000.0;
+    return state;
+}
+
+void neblib::PathRecording::clear()
+{
+    samples.clear();
+}
+
+bool neblib::PathRecording::add(
+    const Pose &pose,
+    double drive,
+    double strafe,
+    double turn)
+{
+    if (samples.size() >= maxSamples)
+        return false;
+
+    samples.push_back(encode(pose, drive, strafe, turn));
+    return true;
+}
+
+std::size_t neblib::PathRecording::size() const
+{
+    return samples.size();
+}
+
+std::size_t neblib::PathRecording::capacity() const
+{
+    return maxSamples;
+}
+
+int neblib::PathRecording::getPeriod() const
+{
+    return periodMS;
+}
+
+int neblib::PathRecording::getDuration() const
+{
+    return (samples.empty()) ? 0 : static_cast<int>(samples.size() - 1) * periodMS;
+}
+
+neblib::PathRecording::State neblib::PathRecording::get(std::size_t index) const
+{
+    if (samples.empty())
+        return State();
+    return decode(samples[(index < samples.size()) ? index : samples.size() - 1]);
+}
+
+neblib::PathRecording::State neblib::PathRecording::at(double time) const
+{
+    if (samples.empty())
+        return State();
+
+    const double position = neblib::clamp(time / periodMS, 0.0, static_cast<double>(samples.size() - 1));
+    const std::size_t index = static_cast<std::size_t>(position);
+    if (index + 1 >= samples.size())
+        return decode(samples.back());
+
+    const double fraction = position - index;
+    const State from = decode(samples[index]);
+    const State to = decode(samples[index + 1]);
+
+    State state;
+    state.pose = Pose(
+        from.pose.x + (to.pose.x - from.pose.x) * fraction,
+        from.pose.y + (to.pose.y - from.pose.y) * fraction,
+        neblib::wrap(from.pose.heading + neblib::wrap(to.pose.heading - from.pose.heading, -180.0, 180.0) * fraction, 0.0, 360.0));
+    state.drive = from.drive + (to.drive - from.drive) * fraction;
+    state.strafe = from.strafe + (to.strafe - from.strafe) * fraction;
+    state.turn = from.turn + (to.turn - from.turn) * fraction;
+    return state;
+}
+
+int neblib::PathRecording::save(
+    vex::brain::sdcard &sdCard,
+    const char *fileName) const
+{
+    if (!sdCard.isInserted())
+        return -1;
+
+    std::vector<std::uint8_t> buffer(headerSize + samples.size() * sampleSize);
+    buffer[0] = magic[0];
+    buffer[1] = magic[1];
+    buffer[2] = magic[2];
+    buffer[3] = magic[3];
+    writeU16(&buffer[4], version);
+    writeU16(&buffer[6], static_cast<std::uint16_t>(periodMS));
+    writeU32(&buffer[8], static_cast<std::uint32_t>(samples.size()));
+
+    std::uint8_t *out = buffer.data() + headerSize;
+    for (std::size_t i = 0; i < samples.size(); i++, out += sampleSize)
+    {
+        writeU16(out, static_cast<std::uint16_t>(samples[i].x));
+        writeU16(out + 2, static_cast<std::uint16_t>(samples[i].y));
+        writeU16(out + 4, samples[i].heading);
+        writeU16(out + 6, static_cast<std::uint16_t>(samples[i].drive));
+        writeU16(out + 8, static_cast<std::uint16_t>(samples[i].strafe));
+        writeU16(out + 10, static_cast<std::uint16_t>(samples[i].turn));
+    }
+
+    const std::int32_t size = static_cast<std::int32_t>(buffer.size());
+    if (sdCard.savefile(fileName, buffer.data(), size) != size)
+        return -2;
+    return 0;
+}
+
+int neblib::PathRecording::load(
+    vex::brain::sdcard &sdCard,
+    const char *fileName)
+{
+    if (!sdCard.isInserted())
+        return -1;
+    if (!sdCard.exists(fileName))
+        return -2;
+
+    const std::int32_t fileSize = sdCard.size(fileName);
+    if (fileSize < static_cast<std::int32_t>(headerSize))
+        return -3;
+
+    std::vector<std::uint8_t> buffer(fileSize);
+    if (sdCard.loadfile(fileName, buffer.data(), fileSize) != fileSize)
+        return -2;
+
+    if (buffer[0] != magic[0] || buffer[1] != magic[1] || buffer[2] != magic[2] || buffer[3] != magic[3] ||
+        readU16(&buffer[4]) != version)
+        return -3;
+
+    const std::uint16_t period = readU16(&buffer[6]);
+    const std::uint32_t count = readU32(&buffer[8]);
+    if (period == 0 || count > maxSamples || headerSize + count * sampleSize > buffer.size())
+        return -3;
+
+    periodMS = period;
+    samples.resize(count);
+    const std::uint8_t *in = buffer.data() + headerSize;
+    for (std::size_t i = 0; i < count; i++, in += sampleSize)
+    {
+        samples[i].x = static_cast<std::int16_t>(readU16(in));
+        samples[i].y = static_cast<std::int16_t>(readU16(in + 2));
+        samples[i].heading = readU16(in + 4);
+        samples[i].drive = static_cast<std::int16_t>(readU16(in + 6));
+        samples[i].strafe = static_cast<std::int16_t>(readU16(in + 8));
+        samples[i].turn = static_cast<std::int16_t>(readU16(in + 10));
+    }
+    return 0;
+}
+
+neblib::PathRecorder::PathRecorder(
+    neblib::PositionTracking &positionTracking,
+    neblib::PathRecording &recording)
+    : positionTracking(positionTracking),
+      recording(recording),
+      drive(0.0f),
+      strafe(0.0f),
+      turn(0.0f),
+      running(false),
+      dropped(0)
+{
+}
+
+void neblib::PathRecorder::setCommand(
+    double drive,
+    double strafe,
+    double turn)
+{
+    this->drive.store(static_cast<float>(drive), std::memory_order_relaxed);
+    this->strafe.store(static_cast<float>(strafe), std::memory_order_relaxed);
+    this->turn.store(static_cast<float>(turn), std::memory_order_relaxed);
+}
+
+void neblib::PathRecorder::setTankCommand(
+    double left,
+    double right)
+{
+    setCommand((left + right) / 2.0, 0.0, (left - right) / 2.0);
+}
+
+void neblib::PathRecorder::update()
+{
+    const bool added = recording.add(
+        positionTracking.getPose(),
+        drive.load(std::memory_order_relaxed),
+        strafe.load(std::memory_order_relaxed),
+        turn.load(std::memory_order_relaxed));
+    if (!added)
+        dropped++;
+}
+
+int neblib::PathRecorder::begin()
+{
+    recording.clear();
+    dropped = 0;
+    running = true;
+
+    const std::uint32_t period = static_cast<std::uint32_t>(recording.getPeriod());
+    std::uint32_t due = vex::timer::system();
+    while (running)
+    {
+        update();
+        due += period;
+
+        const std::uint32_t now = vex::timer::system();
+        if (static_cast<std::int32_t>(due - now) > 0)
+            vex::task::sleep(due - now);
+    }
+
+    return 0;
+}
+
+void neblib::PathRecorder::stop()
+{
+    running = false;
+}
+
+std::uint32_t neblib::PathRecorder::getDropped()
+{
+    return dropped;
+}
@@ -0,0 +1,373 @@
+#include "neblib/plan_cache.hpp"
+#include "neblib/util.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    const std::uint8_t magic[4] = {'N', 'B', 'P', 'C'};
+    const std::uint32_t version = 1;
+    const std::size_t headerSize = 20;
+    const std::size_t entrySize = 16;
+    const std::size_t poseSize = 24;
+
+    void writeU32(
+        std::uint8_t *buffer,
+        std::uint32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+            buffer[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+
+    std::uint32_t readU32(const std::uint8_t *buffer)
+    {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; i++)
+            value |= static_cast<std::uint32_t>(buffer[i]) << (8 * i);
+        return value;
+    }
+
+    /// @brief Writes a double bit for bit, so a loaded path matches the built one exactly
+    void writeDouble(
+        std::uint8_t *buffer,
+        double value)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeU32(buffer, static_cast<std::uint32_t>(bits));
+        writeU32(buffer + 4, static_cast<std::uint32_t>(bits >> 32));
+    }
+
+    double readDouble(const std::uint8_t *buffer)
+    {
+        const std::uint64_t bits = readU32(buffer) | (static_cast<std::uint64_t>(readU32(buffer + 4)) << 32);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /// @brief Folds a pose into a hash, bit for bit like the saved poses
+    std::uint32_t hashPose(
+        const neblib::Pose &pose,
+        std::uint32_t seed)
+    {
+        seed = neblib::hash(&pose.x, sizeof(pose.x), seed);
+        seed = neblib::hash(&pose.y, sizeof(pose.y), seed);
+        return neblib::hash(&pose.heading, sizeof(pose.heading), seed);
+    }
+} // namespace
+
+neblib::PlanCache::Plan::Plan()
+    : poses(nullptr),
+      count(0)
+{
+}
+
+neblib::PlanCache::PlanCache(
+    std::size_t poseCapacity,
+    std::size_t planCapacity)
+    : poses(poseCapacity),
+      usedPoses(0),
+      entries(),
+      maxEntries(planCapacity),
+      routines(),
+      built(false),
+      failed(false),
+      hashing(false),
+      inputs(0)
+{
+    entries.reserve(maxEntries);
+}
+
+std::uint32_t neblib::PlanCache::key(const char *routine)
+{
+    return neblib::hash(routine, std::strlen(routine));
+}
+
+std::uint32_t neblib::PlanCache::countPlans(std::uint32_t routine) const
+{
+    std::uint32_t count = 0;
+    for (std::size_t i = 0; i < entries.size(); i++)
+        if (entries[i].routine == routine)
+            count++;
+    return count;
+}
+
+int neblib::PlanCache::commit(
+    const char *routine,
+    std::size_t count)
+{
+    Entry entry;
+    entry.routine = key(routine);
+    entry.index = countPlans(entry.routine);
+    entry.offset = static_cast<std::uint32_t>(usedPoses);
+    entry.count = static_cast<std::uint32_t>(count);
+    entries.push_back(entry);
+    usedPoses += count;
+    return static_cast<int>(entry.index);
+}
+
+void neblib::PlanCache::addRoutine(
+    const char *name,
+    BuildFunction build,
+    void *context)
+{
+    Routine routine;
+    routine.name = name;
+    routine.build = build;
+    routine.context = context;
+    routines.push_back(routine);
+}
+
+void neblib::PlanCache::addPlanner(const neblib::PathPlanner &planner)
+{
+    planners.push_back(&planner);
+}
+
+std::uint32_t neblib::PlanCache::getSignature(std::uint32_t version)
+{
+    std::uint32_t signature = neblib::hash(&version, sizeof(version));
+    // Names are hashed with their terminator, so "ab" then "c" differs from "a" then "bc"
+    for (std::size_t i = 0; i < routines.size(); i++)
+        signature = neblib::hash(routines[i].name, std::strlen(routines[i].name) + 1, signature);
+    for (std::size_t i = 0; i < planners.size(); i++)
+    {
+        const std::uint32_t planner = planners[i]->getSignature();
+        signature = neblib::hash(&planner, sizeof(planner), signature);
+    }
+
+    // The build functions fold the starts, goals and poses they add into the signature instead of planning
+    inputs = signature;
+    hashing = true;
+    for (std::size_t i = 0; i < routines.size(); i++)
+        routines[i].build(*this, routines[i].name, routines[i].context);
+    hashing = false;
+    return inputs;
+}
+
+void neblib::PlanCache::clear()
+{
+    entries.clear();
+    usedPoses = 0;
+    built = false;
+    failed = false;
+}
+
+int neblib::PlanCache::build()
+{
+    clear();
+    for (std::size_t i = 0; i < routines.size(); i++)
+        routines[i].build(*this, routines[i].name, routines[i].context);
+
+    if (failed)
+        return -1;
+    built = true;
+    return static_cast<int>(entries.size());
+}
+
+int neblib::PlanCache::prepare(
+    vex::brain::sdcard &sdCard,
+    const char *fileName,
+    std::uint32_t version)
+{
+    const std::uint32_t signature = getSignature(version);
+    if (load(sdCard, fileName, signature) == 0)
+        return 1;
+    if (build() < 0)
+        return -1;
+
+    // A missing card only costs the next boot a rebuild
+    save(sdCard, fileName, signature);
+    return 0;
+}
+
+int neblib::PlanCache::addPath(
+    const char *routine,
+    const neblib::Pose *path,
+    std::size_t count)
+{
+    if (hashing)
+    {
+        inputs = neblib::hash(routine, std::strlen(routine) + 1, inputs);
+        inputs = neblib::hash(&count, sizeof(count), inputs);
+        for (std::size_t i = 0; i < count; i++)
+            inputs = hashPose(path[i], inputs);
+        return 0;
+    }
+
+    if (entries.size() >= maxEntries || count > poses.size() - usedPoses)
+    {
+        failed = true;
+        return -1;
+    }
+
+    std::copy(path, path + count, poses.begin() + usedPoses);
+    return commit(routine, count);
+}
+
+int neblib::PlanCache::addPlan(
+    const char *routine,
+    neblib::PathPlanner &planner,
+    const neblib::Pose &start,
+    const neblib::Pose &goal,
+    bool anyAngle)
+{
+    if (hashing)
+    {
+        const std::uint8_t search = (anyAngle) ? 1 : 0;
+        inputs = neblib::hash(routine, std::strlen(routine) + 1, inputs);
+        inputs = hashPose(start, inputs);
+        inputs = hashPose(goal, inputs);
+        inputs = neblib::hash(&search, sizeof(search), inputs);
+        return 0;
+    }
+
+    if (entries.size() >= maxEntries)
+    {
+        failed = true;
+        return -4;
+    }
+
+    // Plan straight into the free end of the pose array
+    const int count = planner.plan(
+        start,
+        goal,
+        poses.data() + usedPoses,
+        static_cast<int>(poses.size() - usedPoses),
+        anyAngle);
+    if (count < 0)
+    {
+        failed = true;
+        return count;
+    }
+
+    return commit(routine, static_cast<std::size_t>(count));
+}
+
+neblib::PlanCache::Plan neblib::PlanCache::get(
+    const char *routine,
+    std::size_t index) const
+{
+    const std::uint32_t routineKey = key(routine);
+    Plan plan;
+    for (std::size_t i = 0; i < entries.size(); i++)
+    {
+        if (entries[i].routine == routineKey && entries[i].index == index)
+        {
+            plan.poses = poses.data() + entries[i].offset;
+            plan.count = entries[i].count;
+            break;
+        }
+    }
+    return plan;
+}
+
+std::size_t neblib::PlanCache::getPlanCount(const char *routine) const
+{
+    return countPlans(key(routine));
+}
+
+std::size_t neblib::PlanCache::getPoseCount() const
+{
+    return usedPoses;
+}
+
+bool neblib::PlanCache::isBuilt() const
+{
+    return built;
+}
+
+int neblib::PlanCache::save(
+    vex::brain::sdcard &sdCard,
+    const char *fileName,
+    std::uint32_t signature) const
+{
+    if (!built)
+        return -3;
+    if (!sdCard.isInserted())
+        return -1;
+
+    std::vector<std::uint8_t> buffer(headerSize + entries.size() * entrySize + usedPoses * poseSize);
+    std::memcpy(buffer.data(), magic, sizeof(magic));
+    writeU32(&buffer[4], version);
+    writeU32(&buffer[8], signature);
+    writeU32(&buffer[12], static_cast<std::uint32_t>(entries.size()));
+    writeU32(&buffer[16], static_cast<std::uint32_t>(usedPoses));
+
+    std::uint8_t *out = buffer.data() + headerSize;
+    for (std::size_t i = 0; i < entries.size(); i++, out += entrySize)
+    {
+        writeU32(out, entries[i].routine);
+        writeU32(out + 4, entries[i].index);
+        writeU32(out + 8, entries[i].offset);
+        writeU32(out + 12, entries[i].count);
+    }
+    for (std::size_t i = 0; i < usedPoses; i++, out += poseSize)
+    {
+        writeDouble(out, poses[i].x);
+        writeDouble(out + 8, poses[i].y);
+        writeDouble(out + 16, poses[i].heading);
+    }
+
+    const std::int32_t size = static_cast<std::int32_t>(buffer.size());
+    if (sdCard.savefile(fileName, buffer.data(), size) != size)
+        return -2;
+    return 0;
+}
+
+int neblib::PlanCache::load(
+    vex::brain::sdcard &sdCard,
+    const char *fileName,
+    std::uint32_t signature)
+{
+    if (!sdCard.isInserted())
+        return -1;
+    if (!sdCard.exists(fileName))
+        return -2;
+
+    const std::int32_t fileSize = sdCard.size(fileName);
+    if (fileSize < static_cast<std::int32_t>(headerSize))
+        return -3;
+
+    std::vector<std::uint8_t> buffer(fileSize);
+    if (sdCard.loadfile(fileName, buffer.data(), fileSize) != fileSize)
+        return -2;
+
+    if (std::memcmp(buffer.data(), magic, sizeof(magic)) != 0 ||
+        readU32(&buffer[4]) != version ||
+        readU32(&buffer[8]) != signature)
+        return -3;
+
+    const std::uint32_t entryCount = readU32(&buffer[12]);
+    const std::uint32_t poseCount = readU32(&buffer[16]);
+    if (entryCount > maxEntries || poseCount > poses.size() ||
+        headerSize + entryCount * entrySize + poseCount * poseSize != buffer.size())
+        return -3;
+
+    // Check every entry before touching the cache, so a bad file leaves it as it was
+    const std::uint8_t *in = buffer.data() + headerSize;
+    for (std::uint32_t i = 0; i < entryCount; i++)
+    {
+        const std::uint32_t offset = readU32(in + i * entrySize + 8);
+        const std::uint32_t count = readU32(in + i * entrySize + 12);
+        if (offset > poseCount || count > poseCount - offset)
+            return -3;
+    }
+
+    clear();
+    for (std::uint32_t i = 0; i < entryCount; i++, in += entrySize)
+    {
+        Entry entry;
+        entry.routine = readU32(in);
+        entry.index = readU32(in + 4);
+        entry.offset = readU32(in + 8);
+        entry.count = readU32(in + 12);
+        entries.push_back(entry);
+    }
+    for (std::uint32_t i = 0; i < poseCount; i++, in += poseSize)
+        poses[i] = Pose(readDouble(in), readDouble(in + 8), readDouble(in + 16));
+
+    usedPoses = poseCount;
+    built = true;
+    return 0;
+}
@@ -1,4 +1,6 @@
 #include "neblib/position_tracking.hpp"
+#include "neblib/trace.hpp"
+#include "neblib/transform.hpp"
 
 neblib::Pose::Pose(
     double x,
@@ -10,6 +12,16 @@ neblib::Pose::Pose(
 {
 }
 
+neblib::Pose::Pose(
+    Length x,
+    Length y,
+    Angle heading)
+    : x(x.inches()),
+      y(y.inches()),
+      heading(heading.degrees())
+{
+}
+
 neblib::Pose::Pose()
     : x(0.0),
       y(0.0),
@@ -17,6 +29,14 @@ neblib::Pose::Pose()
 {
 }
 
+void neblib::PositionTracking::setPose(
+    double x,
+    double y,
+    double heading)
+{
+    setPose(Pose(x, y, heading));
+}
+
 neblib::Odometry::Odometry(
     neblib::TrackerWheel &parallelTrackerWheel,
     double parallelDistance,
@@ -26,6 +46,7 @@ neblib::Odometry::Odometry(
     : parallelTrackerWheel(parallelTrackerWheel),
       perpendicularTrackerWheel(perpendicularTrackerWheel),
       imu(imu),
+      sensorSnapshot(nullptr),
       parallelDistance(parallelDistance),
       perpendicularDistance(perpendicularDistance),
       mutex(),
@@ -33,7 +54,9 @@ neblib::Odometry::Odometry(
       running(false),
       previousParallel(0.0),
       previousPerpendicular(0.0),
-      previousRotation(0.0)
+      previousRotation(0.0),
+      loopStats("odometry"),
+      resetSequence(0)
 {
 }
 
@@ -42,50 +65,79 @@ int neblib::Odometry::begin()
     running = true;
     while (running)
     {
-        // ---------- Sensor Data ----------
-        const double parallelPosition = parallelTrackerWheel.getPosition();
-        const double perpendicularPosition = perpendicularTrackerWheel.getPosition();
-        const double rotation = neblib::toRad(imu.rotation());
-
-        // ---------- Change in Data ----------
-        const double parallelChange = parallelPosition - previousParallel;
-        const double perpendicularChange = perpendicularPosition - previousPerpendicular;
-        const double rotationChange = rotation - previousRotation;
-
-        // ---------- Calculate Local Position ----------
-        double localX = perpendicularChange;
-        double localY = parallelChange;
-        if (std::abs(rotationChange) > 1e-6)
+        update();
+        vex::task::sleep(10);
+    }
+
+    return 0;
+}
+
+void neblib::Odometry::update()
+{
+    NEBLIB_TRACE_SCOPE("Odometry::update");
+    loopStats.startIteration();
+
+    // ---------- Sensor Data ----------
+    double parallelPosition;
+    double perpendicularPosition;
+    double rotation;
+    double heading;
+    if (sensorSnapshot)
+    {
+        // The snapshot was read before the pose was last set, skip it rather than see a jump
+        if (sensorSnapshot->getSequence() == resetSequence)
         {
-            localX = 2.0 * sin(rotationChange / 2.0) * ((perpendicularChange / rotationChange) + perpendicularDistance);
-            localY = 2.0 * sin(rotationChange / 2.0) * ((parallelChange / rotationChange) + parallelDistance);
+            loopStats.endIteration();
+            return;
         }
-        const double averageRotation = previousRotation + (rotationChange / 2.0);
 
-        // ---------- Calculate Local Polar Coordinate ----------
-        const double radius = hypot(localX, localY);
-        const double angle = atan2(localY, localX) - averageRotation;
+        parallelPosition = sensorSnapshot->position(parallelTrackerWheel);
+        perpendicularPosition = sensorSnapshot->position(perpendicularTrackerWheel);
+        rotation = neblib::toRad(sensorSnapshot->rotation(imu));
+        heading = sensorSnapshot->heading(imu);
+    }
+    else
+    {
+        parallelPosition = parallelTrackerWheel.getPosition();
+        perpendicularPosition = perpendicularTrackerWheel.getPosition();
+        rotation = neblib::toRad(imu.rotation());
+        heading = imu.heading();
+    }
 
-        // ---------- Convert to Cartesian ----------
-        const double xChange = radius * cos(angle);
-        const double yChange = radius * sin(angle);
+    // ---------- Change in Data ----------
+    const double parallelChange = parallelPosition - previousParallel;
+    const double perpendicularChange = perpendicularPosition - previousPerpendicular;
+    const double rotationChange = rotation - previousRotation;
 
-        // ---------- Update Pose ----------
-        mutex.lock();
-        position.x += xChange;
-        position.y += yChange;
-        position.heading = imu.heading();
-        mutex.unlock();
+    // ---------- Calculate Local Position ----------
+    double localX = perpendicularChange;
+    double localY = parallelChange;
+    if (std::abs(rotationChange) > 1e-6)
+    {
+        localX = 2.0 * sin(rotationChange / 2.0) * ((perpendicularChange / rotationChange) + perpendicularDistance);
+        localY = 2.0 * sin(rotationChange / 2.0) * ((parallelChange / rotationChange) + parallelDistance);
+    }
+    const double averageRotation = previousRotation + (rotationChange / 2.0);
 
-        // ---------- Update Previous Values ----------
-        previousParallel = parallelPosition;
-        previousPerpendicular = perpendicularPosition;
-        previousRotation = rotation;
+    // ---------- Rotate to Global ----------
+    // The chord points along the average heading of the arc
+    double xChange;
+    double yChange;
+    neblib::Rotation::fromRadians(averageRotation).toGlobal(localX, localY, xChange, yChange);
 
-        vex::task::sleep(10);
-    }
+    // ---------- Update Pose ----------
+    mutex.lock();
+    position.x += xChange;
+    position.y += yChange;
+    position.heading = heading;
+    mutex.unlock();
 
-    return 0;
+    // ---------- Update Previous Values ----------
+    previousParallel = parallelPosition;
+    previousPerpendicular = perpendicularPosition;
+    previousRotation = rotation;
+
+    loopStats.endIteration();
 }
 
 void neblib::Odometry::stop()
@@ -111,6 +163,8 @@ void neblib::Odometry::setPose(Pose newPose)
     imu.setHeading(newPose.heading, vex::rotationUnits::deg);
     imu.setRotation(newPose.heading, vex::rotationUnits::deg);
     previousRotation = neblib::toRad(newPose.heading);
+    if (sensorSnapshot)
+        resetSequence = sensorSnapshot->getSequence();
     mutex.unlock();
 }
 
@@ -124,6 +178,8 @@ void neblib::Odometry::setPose(
     imu.setHeading(heading, vex::rotationUnits::deg);
     imu.setRotation(heading, vex::rotationUnits::deg);
     previousRotation = neblib::toRad(heading);
+    if (sensorSnapshot)
+        resetSequence = sensorSnapshot->getSequence();
     mutex.unlock();
 }
 
@@ -133,4 +189,16 @@ neblib::Pose neblib::Odometry::getPose()
     Pose copy = position;
     mutex.unlock();
     return copy;
+}
+
+void neblib::Odometry::setSensorSnapshot(neblib::SensorSnapshot *sensorSnapshot)
+{
+    this->sensorSnapshot = sensorSnapshot;
+    if (sensorSnapshot)
+        resetSequence = sensorSnapshot->getSequence();
+}
+
+neblib::LoopStats &neblib::Odometry::getLoopStats()
+{
+    return loopStats;
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "neblib/random.hpp"
+#include <cmath>
+
+namespace
+{
+    // ---------- Ziggurat ----------
+    // Marsaglia and Tsang's ziggurat with Doornik's table layout: layerX[i]
+    // is the right edge of layer i, layer 0 is the base strip holding the
+    // tail beyond tailStart.
+    const int layerCount = 128;
+    const double tailStart = 3.442619855899;
+    const double layerArea = 9.91256303526217e-3;
+
+    double layerX[layerCount + 1];
+    double layerRatio[layerCount]; //< layerX[i + 1] / layerX[i], below it a sample is inside the layer's rectangle
+
+    bool buildLayers()
+    {
+        double density = std::exp(-0.5 * tailStart * tailStart);
+        layerX[0] = layerArea / density;
+        layerX[1] = tailStart;
+        layerX[layerCount] = 0.0;
+        for (int i = 2; i < layerCount; i++)
+        {
+            layerX[i] = std::sqrt(-2.0 * std::log(layerArea / layerX[i - 1] + density));
+            density = std::exp(-0.5 * layerX[i] * layerX[i]);
+        }
+        for (int i = 0; i < layerCount; i++)
+            layerRatio[i] = layerX[i + 1] / layerX[i];
+        return true;
+    }
+
+    /// @brief Builds the tables on first use, so a Random created during static initialization still works
+    void ensureLayers()
+    {
+        static const bool built = buildLayers();
+        (void)built;
+    }
+
+    /// @brief Uniform number from (0, 1), safe to take the log of
+    double openUniform(neblib::Random &random)
+    {
+        return (static_cast<double>(random.next() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    std::uint64_t splitMix(std::uint64_t &seed)
+    {
+        std::uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+} // namespace
+
+neblib::Random::Random(std::uint64_t seed)
+{
+    ensureLayers();
+    this->seed(seed);
+}
+
+void neblib::Random::seed(std::uint64_t seed)
+{
+    // SplitMix64 spreads any seed, including 0, over the whole state
+    for (int i = 0; i < 4; i++)
+        state[i] = splitMix(seed);
+}
+
+void neblib::Random::jump()
+{
+    static const std::uint64_t polynomial[4] = {
+        0x180EC6D33CFD0ABAull,
+        0xD5A61266F0C9392Cull,
+        0xA9582618E03FC9AAull,
+        0x39ABDC4529B1661Cull};
+
+    std::uint64_t jumped[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++)
+    {
+        for (int bit = 0; bit < 64; bit++)
+        {
+            if (polynomial[i] & (1ull << bit))
+            {
+                for (int j = 0; j < 4; j++)
+                    jumped[j] ^= state[j];
+            }
+            next();
+        }
+    }
+    for (int i = 0; i < 4; i++)
+        state[i] = jumped[i];
+}
+
+double neblib::Random::gauss()
+{
+    while (true)
+    {
+        // Top 53 bits give the position in the layer, the low 7 the layer
+        const std::uint64_t bits = next();
+        const double u = static_cast<double>(bits >> 11) * (1.0 / 4503599627370496.0) - 1.0;
+        const int layer = static_cast<int>(bits & (layerCount - 1));
+
+        // Inside the layer's rectangle, which is almost always
+        if (std::abs(u) < layerRatio[layer])
+            return u * layerX[layer];
+
+        // Base strip outside its rectangle: sample the tail
+        if (layer == 0)
+        {
+            double x;
+            double y;
+            do
+            {
+                x = std::log(openUniform(*this)) / tailStart;
+                y = std::log(openUniform(*this));
+            } while (-2.0 * y < x * x);
+            return (u < 0.0) ? x - tailStart : tailStart - x;
+        }
+
+        // Wedge between the rectangle and the curve
+        const double x = u * layerX[layer];
+        const double outer = std::exp(-0.5 * (layerX[layer] * layerX[layer] - x * x));
+        const double inner = std::exp(-0.5 * (layerX[layer + 1] * layerX[layer + 1] - x * x));
+        if (inner + uniform() * (outer - inner) < 1.0)
+            return x;
+    }
+}
+
+void neblib::Random::fillUniform(
+    double *values,
+    std::size_t count,
+    double min,
+    double max)
+{
+    for (std::size_t i = 0; i < count; i++)
+        values[i] = uniform();
+
+    const double range = max - min;
+    for (std::size_t i = 0; i < count; i++)
+        values[i] = min + range * values[i];
+}
+
+void neblib::Random::fillGauss(
+    double *values,
+    std::size_t count,
+    double mean,
+    double stddev)
+{
+    for (std::size_t i = 0; i < count; i++)
+        values[i] = gauss();
+
+    for (std::size_t i = 0; i < count; i++)
+        values[i] = mean + stddev * values[i];
+}
@@ -0,0 +1,172 @@
+#include "neblib/routine.hpp"
+
+constexpr std::size_t neblib::RoutineScheduler::maxRoutines;
+constexpr std::size_t neblib::RoutineScheduler::arenaSize;
+constexpr std::size_t neblib::RoutineScheduler::maxDrivetrains;
+
+neblib::Routine::Routine()
+    : resumePoint(0),
+      wakeTime(0)
+{
+}
+
+bool neblib::Routine::isFinished() const
+{
+    return resumePoint == -1;
+}
+
+neblib::RoutineScheduler::RoutineScheduler(int periodMS)
+    : periodMS(periodMS),
+      executor(nullptr),
+      routineCount(0),
+      arenaUsed(0),
+      ownedCount(0),
+      moverCount(0)
+{
+}
+
+neblib::RoutineScheduler::~RoutineScheduler()
+{
+    cancelAll();
+}
+
+void *neblib::RoutineScheduler::allocate(
+    std::size_t size,
+    std::size_t alignment)
+{
+    const std::size_t start = (arenaUsed + alignment - 1) & ~(alignment - 1);
+    if (start + size > arenaSize)
+        return nullptr;
+
+    arenaUsed = start + size;
+    return arena + start;
+}
+
+int neblib::RoutineScheduler::insert(
+    neblib::Routine *routine,
+    bool isOwned)
+{
+    if (routineCount >= maxRoutines)
+        return -1;
+
+    routines[routineCount] = routine;
+    owned[routineCount] = isOwned;
+    if (isOwned)
+        ownedCount++;
+    return static_cast<int>(routineCount++);
+}
+
+void neblib::RoutineScheduler::remove(std::size_t index)
+{
+    if (owned[index])
+    {
+        routines[index]->~Routine();
+        // Every spawned routine is gone, so the whole arena can be reused
+        if (--ownedCount == 0)
+            arenaUsed = 0;
+    }
+
+    for (std::size_t i = index + 1; i < routineCount; i++)
+    {
+        routines[i - 1] = routines[i];
+        owned[i - 1] = owned[i];
+    }
+    routineCount--;
+}
+
+int neblib::RoutineScheduler::add(neblib::Routine *routine)
+{
+    if (!routine)
+        return -1;
+    return (insert(routine, false) < 0) ? -1 : 0;
+}
+
+bool neblib::RoutineScheduler::step()
+{
+    // Routines added while stepping run from the next tick
+    const std::size_t count = routineCount;
+    for (std::size_t i = 0; i < count; i++)
+        routines[i]->resume();
+
+    // Motions started this tick take their first step now
+    const int elapsed = (executor) ? executor->getTickMS() : periodMS;
+    bool moving = false;
+    for (std::size_t i = 0; i < moverCount; i++)
+        moving = movers[i].step(movers[i].drivetrain, elapsed) || moving;
+
+    std::size_t i = 0;
+    while (i < routineCount)
+    {
+        if (routines[i]->isFinished())
+            remove(i);
+        else
+            i++;
+    }
+
+    return routineCount > 0 || moving;
+}
+
+int neblib::RoutineScheduler::run(int timeout)
+{
+    int time = 0;
+    while (step())
+    {
+        if (time >= timeout)
+        {
+            cancelAll();
+            break;
+        }
+
+        if (executor)
+        {
+            time += executor->waitForTick();
+        }
+        else
+        {
+            vex::task::sleep(periodMS);
+            time += periodMS;
+        }
+    }
+
+    return time;
+}
+
+void neblib::RoutineScheduler::cancelAll()
+{
+    for (std::size_t i = 0; i < moverCount; i++)
+        movers[i].cancel(movers[i].drivetrain);
+
+    while (routineCount > 0)
+        remove(routineCount - 1);
+}
+
+void neblib::RoutineScheduler::setExecutor(neblib::Executor *executor)
+{
+    this->executor = executor;
+}
+
+std::size_t neblib::RoutineScheduler::getCount()
+{
+    return routineCount;
+}
+
+bool neblib::inRegion(
+    neblib::PositionTracking &positionTracking,
+    double minX,
+    double minY,
+    double maxX,
+    double maxY)
+{
+    const neblib::Pose pose = positionTracking.getPose();
+    return pose.x >= minX && pose.x <= maxX && pose.y >= minY && pose.y <= maxY;
+}
+
+bool neblib::withinDistance(
+    neblib::PositionTracking &positionTracking,
+    double x,
+    double y,
+    double distance)
+{
+    const neblib::Pose pose = positionTracking.getPose();
+    return hypot(x - pose.x, y - pose.y) <= distance;
+}
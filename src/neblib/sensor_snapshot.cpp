@@ -0,0 +1,107 @@
+#include "neblib/sensor_snapshot.hpp"
+
+constexpr std::size_t neblib::SensorSnapshot::maxTrackerWheels;
+
+neblib::SensorSnapshot::Data::Data()
+    : timestamp(0),
+      sequence(0),
+      heading(0.0),
+      rotation(0.0)
+{
+    for (std::size_t i = 0; i < maxTrackerWheels; i++)
+        trackerPositions[i] = 0.0;
+}
+
+neblib::SensorSnapshot::SensorSnapshot()
+    : imu(nullptr),
+      trackerWheelCount(0),
+      published(0),
+      sequence(0)
+{
+}
+
+int neblib::SensorSnapshot::indexOf(const neblib::TrackerWheel &trackerWheel) const
+{
+    for (std::size_t i = 0; i < trackerWheelCount; i++)
+        if (trackerWheels[i] == &trackerWheel)
+            return static_cast<int>(i);
+    return -1;
+}
+
+void neblib::SensorSnapshot::setImu(vex::inertial &imu)
+{
+    this->imu = &imu;
+}
+
+int neblib::SensorSnapshot::addTrackerWheel(neblib::TrackerWheel &trackerWheel)
+{
+    const int existing = indexOf(trackerWheel);
+    if (existing >= 0)
+        return existing;
+    if (trackerWheelCount >= maxTrackerWheels)
+        return -1;
+
+    trackerWheels[trackerWheelCount] = &trackerWheel;
+    return static_cast<int>(trackerWheelCount++);
+}
+
+void neblib::SensorSnapshot::update()
+{
+    // Fill the buffer readers are not using, then publish it in one step
+    const int next = 1 - published.load();
+    Data &data = buffers[next];
+
+    data.timestamp = vex::timer::systemHighResolution();
+    data.sequence = sequence++;
+    if (imu)
+    {
+        data.heading = imu->heading();
+        data.rotation = imu->rotation();
+    }
+    for (std::size_t i = 0; i < trackerWheelCount; i++)
+        data.trackerPositions[i] = trackerWheels[i]->getPosition();
+
+    published.store(next);
+}
+
+neblib::SensorSnapshot::Data neblib::SensorSnapshot::get() const
+{
+    return buffers[published.load()];
+}
+
+double neblib::SensorSnapshot::heading(vex::inertial &imu) const
+{
+    if (!hasImu(imu))
+        return imu.heading();
+    return buffers[published.load()].heading;
+}
+
+double neblib::SensorSnapshot::rotation(vex::inertial &imu) const
+{
+    if (!hasImu(imu))
+        return imu.rotation();
+    return buffers[published.load()].rotation;
+}
+
+double neblib::SensorSnapshot::position(neblib::TrackerWheel &trackerWheel) const
+{
+    const int index = indexOf(trackerWheel);
+    if (index < 0 || sequence == 0)
+        return trackerWheel.getPosition();
+    return buffers[published.load()].trackerPositions[index];
+}
+
+bool neblib::SensorSnapshot::hasImu(const vex::inertial &imu) const
+{
+    return this->imu == &imu && sequence > 0;
+}
+
+bool neblib::SensorSnapshot::hasTrackerWheel(const neblib::TrackerWheel &trackerWheel) const
+{
+    return indexOf(trackerWheel) >= 0 && sequence > 0;
+}
+
+std::uint32_t neblib::SensorSnapshot::getSequence() const
+{
+    return sequence;
+}
@@ -1,283 +1,399 @@
 #include "neblib/standard_drive.hpp"
+#include "neblib/trace.hpp"
+#include "neblib/transform.hpp"
+#include <algorithm>
 
-neblib::StandardDrive::StandardDrive(vex::motor_group&& leftMotors, vex::motor_group&& rightMotors, PositionTracking* positionTracking, TrackerWheel &parallelTrackerWheel, vex::inertial &imu) : leftMotors(leftMotors), rightMotors(rightMotors), positionTracking(positionTracking), parallelTrackerWheel(parallelTrackerWheel), imu(imu), turnPID(nullptr), linearPID(nullptr), angularPID(nullptr), swingPID(nullptr)
+neblib::DifferentialChassis::DifferentialChassis(vex::motor_group&& leftMotors, vex::motor_group&& rightMotors, PositionTracking* positionTracking, TrackerWheel &parallelTrackerWheel, vex::inertial &imu) : Chassis(imu, positionTracking), leftMotors(leftMotors), rightMotors(rightMotors), parallelTrackerWheel(parallelTrackerWheel), lead(0.0), settleRadius(3.0), trackWidth(0.0), arcLookahead(6.0)
 {
+    addTelemetryGroup(this->leftMotors);
+    addTelemetryGroup(this->rightMotors);
 }
 
-void neblib::StandardDrive::setTurnPID(PID* turnPID)
+void neblib::DifferentialChassis::setTurnPID(PID* turnPID)
 {
-    this->turnPID = turnPID;
+    setTurnController(turnPID);
 }
 
-void neblib::StandardDrive::setLinearPID(PID* linearPID)
+void neblib::DifferentialChassis::setLinearPID(PID* linearPID)
 {
-    this->linearPID = linearPID;
+    setLinearController(linearPID);
 }
 
-void neblib::StandardDrive::setAngularPID(PID* angularPID)
+void neblib::DifferentialChassis::setAngularPID(PID* angularPID)
 {
-    this->angularPID = angularPID;
+    setAngularController(angularPID);
 }
 
-void neblib::StandardDrive::setSwingPID(PID* swingPID)
+void neblib::DifferentialChassis::setSwingPID(PID* swingPID)
 {
-    this->swingPID = swingPID;
+    setSwingController(swingPID);
 }
 
-void neblib::StandardDrive::tankDrive(double leftInput, double rightInput, vex::velocityUnits unit)
+void neblib::DifferentialChassis::setBoomerang(double lead, double settleRadius)
 {
-    leftMotors.spin(vex::directionType::fwd, leftInput, unit);
-    rightMotors.spin(vex::directionType::fwd, rightInput, unit);
+    this->lead = lead;
+    this->settleRadius = settleRadius;
 }
 
-void neblib::StandardDrive::tankDrive(double leftInput, double rightInput, vex::voltageUnits unit)
+void neblib::DifferentialChassis::setTrackWidth(double trackWidth)
 {
-    leftMotors.spin(vex::directionType::fwd, leftInput, unit);
-    rightMotors.spin(vex::directionType::fwd, rightInput, unit);
+    this->trackWidth = trackWidth;
 }
 
-void neblib::StandardDrive::arcadeDrive(double linearInput, double angularInput, vex::velocityUnits unit)
+void neblib::DifferentialChassis::setArcLookahead(double arcLookahead)
 {
-    leftMotors.spin(vex::directionType::fwd, linearInput + angularInput, unit);
-    rightMotors.spin(vex::directionType::fwd, linearInput - angularInput, unit);
+    this->arcLookahead = arcLookahead;
 }
 
-void neblib::StandardDrive::arcadeDrive(double linearInput, double angularInput, vex::voltageUnits unit)
+void neblib::DifferentialChassis::setMotorOutput(neblib::MotorOutput *motorOutput, neblib::MotorOutput::Limits limits)
 {
-    leftMotors.spin(vex::directionType::fwd, linearInput + angularInput, unit);
-    rightMotors.spin(vex::directionType::fwd, linearInput - angularInput, unit);
+    this->motorOutput = motorOutput;
+    if (!motorOutput)
+        return;
+    motorOutput->addGroup(leftMotors, limits);
+    motorOutput->addGroup(rightMotors, limits);
 }
 
-void neblib::StandardDrive::stop(vex::brakeType stopType)
+void neblib::DifferentialChassis::tankDrive(double leftInput, double rightInput, vex::velocityUnits unit)
 {
-    leftMotors.stop(stopType);
-    rightMotors.stop(stopType);
+    spinMotors(leftMotors, leftInput, unit);
+    spinMotors(rightMotors, rightInput, unit);
 }
 
-double neblib::StandardDrive::turnFor(double degrees, double minOutput, double maxOutput, double timeout)
+void neblib::DifferentialChassis::tankDrive(double leftInput, double rightInput, vex::voltageUnits unit)
 {
-    turnPID->reset();
-    double target = imu.rotation(vex::rotationUnits::deg) + degrees;
-    double time = 0.0;
-
-    while (!turnPID->isSettled() && time < timeout)
-    {
-        double error = target - imu.rotation(vex::rotationUnits::deg);
-        double output = turnPID->getOutput(error, minOutput, maxOutput);
-
-        leftMotors.spin(vex::directionType::fwd, output, vex::voltageUnits::volt);
-        rightMotors.spin(vex::directionType::rev, output, vex::voltageUnits::volt);
-
-        vex::task::sleep(10);
-        time += 0.01;
-    }
+    spinMotors(leftMotors, leftInput, unit);
+    spinMotors(rightMotors, rightInput, unit);
+}
 
-    this->stop(vex::brakeType::hold);
+void neblib::DifferentialChassis::arcadeDrive(double linearInput, double angularInput, vex::velocityUnits unit)
+{
+    spinMotors(leftMotors, linearInput + angularInput, unit);
+    spinMotors(rightMotors, linearInput - angularInput, unit);
+}
 
-    return time;
+void neblib::DifferentialChassis::arcadeDrive(double linearInput, double angularInput, vex::voltageUnits unit)
+{
+    spinMotors(leftMotors, linearInput + angularInput, unit);
+    spinMotors(rightMotors, linearInput - angularInput, unit);
 }
 
-double neblib::StandardDrive::turnFor(double degrees, double timeout)
+void neblib::DifferentialChassis::stop(vex::brakeType stopType)
 {
-    return this->turnFor(degrees, -infinity(), infinity(), timeout);
+    stopMotors(leftMotors, stopType);
+    stopMotors(rightMotors, stopType);
+    chained = false;
 }
 
-double neblib::StandardDrive::turnTo(double heading, double minOutput, double maxOutput, double timeout)
+void neblib::DifferentialChassis::rotate(double output)
 {
-    turnPID->reset();
-    double time = 0.0;
+    spinMotors(leftMotors, output);
+    spinMotors(rightMotors, -output);
+}
 
-    while (!turnPID->isSettled() && time < timeout)
+void neblib::DifferentialChassis::swing(vex::turnType side, double output)
+{
+    if (side == vex::turnType::right)
     {
-        double error = neblib::wrap(heading - imu.heading(vex::rotationUnits::deg), -180.0, 180.0);
-        double output = turnPID->getOutput(error, minOutput, maxOutput);
-
-        leftMotors.spin(vex::directionType::fwd, output, vex::voltageUnits::volt);
-        rightMotors.spin(vex::directionType::rev, output, vex::voltageUnits::volt);
-
-        vex::task::sleep(10);
-        time += 0.01;
+        stopMotors(rightMotors, vex::brakeType::hold);
+        spinMotors(leftMotors, output);
+    } else {
+        stopMotors(leftMotors, vex::brakeType::hold);
+        spinMotors(rightMotors, output);
     }
+}
 
-    this->stop(vex::brakeType::hold);
+double neblib::DifferentialChassis::toElapsed(int milliseconds)
+{
+    return (milliseconds < 0) ? milliseconds : milliseconds / 1000.0;
+}
 
-    return time;
+double neblib::DifferentialChassis::pointHeading(const Pose &current, double x, double y)
+{
+    return neblib::toDeg(atan2(x - current.x, y - current.y));
 }
 
-double neblib::StandardDrive::turnTo(double heading, double timeout)
+double neblib::DifferentialChassis::angularError(const Pose &current, const Pose &target, double distance)
 {
-    return this->turnTo(heading, -infinity(), infinity(), timeout);
+    if (distance < settleRadius)
+        return neblib::wrap(target.heading - current.heading, -180.0, 180.0);
+
+    // Steer at a carrot point behind the target so the robot arrives facing the target heading
+    double carrotX;
+    double carrotY;
+    neblib::Transform(target).toGlobal(0.0, -lead * distance, carrotX, carrotY);
+    return neblib::wrap(pointHeading(current, carrotX, carrotY) - current.heading, -180.0, 180.0);
 }
 
-double neblib::StandardDrive::driveFor(double distance, double heading, double minOutput, double maxOutput, double timeout)
+bool neblib::DifferentialChassis::atPose(const Pose &current, const Pose &target, double distance)
 {
-    linearPID->reset();
-    angularPID->reset();
+    if (distance >= settleRadius)
+        return false;
+
+    // Facing the target heading, driving only removes the error along the heading, so an
+    // overshoot to the side would otherwise hold the robot in place until the timeout
+    double right;
+    double forward;
+    neblib::Transform(current).toLocal(target.x, target.y, right, forward);
+    return std::abs(forward) <= std::abs(right) && (!angularController || angularController->isSettled());
+}
 
-    double target = parallelTrackerWheel.getPosition() + distance;
-    double time = 0.0;
+void neblib::DifferentialChassis::driveToward(const Pose &current, const Pose &target, double drive, double turn)
+{
+    // Only the part of the distance along the robot's heading can be driven, this also reverses after overshooting
+    double right;
+    double forward;
+    neblib::Transform(current).toLocal(target.x, target.y, right, forward);
+    const double distance = hypot(right, forward);
+    const double linear = (distance > 1e-9) ? drive * forward / distance : 0.0;
+
+    spinMotors(leftMotors, linear + turn);
+    spinMotors(rightMotors, linear - turn);
+}
 
-    while (!linearPID->isSettled() && time < timeout)
+void neblib::DifferentialChassis::driveCommand(double drive, double strafe, double turn)
+{
+    // Can't strafe, so steer toward the side instead, which flips when driving backward
+    const double steer = (drive < 0.0) ? -strafe : strafe;
+    double leftOutput = drive + turn + steer;
+    double rightOutput = drive - turn - steer;
+
+    // Scale both sides together so clipping keeps the ratio between them, and the path curvature
+    const double largest = std::max(std::abs(leftOutput), std::abs(rightOutput));
+    if (largest > 12.0)
     {
-        double linearError = target - parallelTrackerWheel.getPosition();
-        double angularError = neblib::wrap(heading - imu.heading(vex::rotationUnits::deg), -180, 180);
-        double linearOutput = linearPID->getOutput(linearError, minOutput, maxOutput);
-        double angularOutput = angularPID->getOutput(angularError, -12.0, 12.0);
-
-        leftMotors.spin(vex::directionType::fwd, linearOutput + angularOutput, vex::voltageUnits::volt);
-        rightMotors.spin(vex::directionType::fwd, linearOutput - angularOutput, vex::voltageUnits::volt);
-
-        vex::task::sleep(10);
-        time += 0.01;
+        leftOutput *= 12.0 / largest;
+        rightOutput *= 12.0 / largest;
     }
 
-    this->stop(vex::brakeType::hold);
-
-    return time;
-}
-
-double neblib::StandardDrive::driveFor(double distance, double minOutput, double maxOutput, double timeout)
-{
-    return this->driveFor(distance, imu.heading(vex::rotationUnits::deg), minOutput, maxOutput, timeout);
+    spinMotors(leftMotors, leftOutput);
+    spinMotors(rightMotors, rightOutput);
 }
 
-double neblib::StandardDrive::driveFor(double distance, double heading, double timeout)
+double neblib::DifferentialChassis::driveFor(double distance, double heading, Time timeout, double minOutput, double maxOutput)
 {
-    return this->driveFor(distance, heading, -infinity(), infinity(), timeout);
+    return this->driveFor(distance, heading, ChainConditions(0.0), timeout, minOutput, maxOutput);
 }
 
-double neblib::StandardDrive::driveFor(double distance, double timeout)
+double neblib::DifferentialChassis::driveFor(double distance, Time timeout, double minOutput, double maxOutput)
 {
-    return this->driveFor(distance, imu.heading(vex::rotationUnits::deg), -infinity(), infinity(), timeout);
+    return this->driveFor(distance, currentHeading(), ChainConditions(0.0), timeout, minOutput, maxOutput);
 }
 
-double neblib::StandardDrive::swingFor(vex::turnType direction, double degrees, double minOutput, double maxOutput, double timeout)
+double neblib::DifferentialChassis::driveFor(double distance, double heading, ChainConditions chain, Time timeout, double minOutput, double maxOutput)
 {
-    swingPID->reset();
-    double time = 0.0;
-    if (direction == vex::turnType::right)
-    {
-        double target = imu.rotation(vex::rotationUnits::deg) + degrees;
+    if (!linearController)
+        return -2;
 
-        while (!swingPID->isSettled() && time < timeout)
-        {
-            double error = target - imu.rotation(vex::rotationUnits::deg);
-            double output = swingPID->getOutput(error, minOutput, maxOutput);
+    resetController(linearController, previousLinearOutput);
+    if (angularController)
+        resetController(angularController, previousAngularOutput);
 
-            rightMotors.stop(vex::brakeType::hold);
-            leftMotors.spin(vex::directionType::fwd, output, vex::voltageUnits::volt);
+    double target = trackerPosition(parallelTrackerWheel) + distance;
+    int time = 0;
+    beginMotion(neblib::TelemetryRecord::Drive);
+    bool exitedEarly = false;
 
-            vex::task::sleep(10);
-            time += 0.01;
+    while (!linearController->isSettled() && time < neblib::toTimeout(timeout) && !motionCancelled())
+    {
+        NEBLIB_TRACE_SCOPE("driveFor");
+        double linearError = target - trackerPosition(parallelTrackerWheel);
+        if (std::abs(linearError) < chain.exitRadius)
+        {
+            exitedEarly = true;
+            break;
         }
-    } else {
-        double target = imu.rotation(vex::rotationUnits::deg) - degrees;
 
-        while (!swingPID->isSettled() && time < timeout)
-        {
-            double error = imu.rotation(vex::rotationUnits::deg) - target;
-            double output = swingPID->getOutput(error, minOutput, maxOutput);
+        double angularError = neblib::wrap(heading - currentHeading(), -180, 180);
+        double linearOutput = linearController->getOutput(linearError, minOutput, maxOutput);
+        double angularOutput = (angularController) ? angularController->getOutput(angularError, -12.0, 12.0) : 0.0;
+        if (std::abs(linearOutput) < chain.minSpeed)
+            linearOutput = (linearError < 0.0) ? -chain.minSpeed : chain.minSpeed;
 
-            leftMotors.stop(vex::brakeType::hold);
-            rightMotors.spin(vex::directionType::fwd, output, vex::voltageUnits::volt);
+        spinMotors(leftMotors, linearOutput + angularOutput);
+        spinMotors(rightMotors, linearOutput - angularOutput);
+        record(TelemetryRecord::Drive, linearError, angularError, linearOutput, angularOutput);
+        previousLinearOutput = linearOutput;
+        previousAngularOutput = angularOutput;
 
-            vex::task::sleep(10);
-            time += 0.01;
-        }
+        time += waitForTick();
     }
 
-    this->stop(vex::brakeType::hold);
+    leaveControl();
+    if (exitedEarly)
+        chained = true;
+    else
+        this->stop(vex::brakeType::hold);
 
-    return time;
+    return toElapsed(time);
 }
 
-double neblib::StandardDrive::swingFor(vex::turnType direction, double degrees, double timeout)
+double neblib::DifferentialChassis::driveFor(double distance, ChainConditions chain, Time timeout, double minOutput, double maxOutput)
 {
-    return this->swingFor(direction, degrees, -infinity(), infinity(), timeout);
+    return this->driveFor(distance, currentHeading(), chain, timeout, minOutput, maxOutput);
 }
 
-double neblib::StandardDrive::swingTo(vex::turnType turnDirection, vex::directionType direction, double heading, double minOutput, double maxOutput, double timeout)
+double neblib::DifferentialChassis::driveFor(Length distance, Angle heading, Time timeout, Voltage minOutput, Voltage maxOutput)
 {
-    swingPID->reset();
-    double time = 0.0;
-    if (turnDirection == vex::turnType::right)
-    {
-        double lower = (direction == vex::directionType::fwd) ? 0.0 : -360.0;
-        double upper = (direction == vex::directionType::fwd) ? 360.0 : 0.0;
-        while (!swingPID->isSettled() && time < timeout)
-        {
-            double error = neblib::wrap(heading - imu.heading(vex::rotationUnits::deg), lower, upper);
-            double output = swingPID->getOutput(error, minOutput, maxOutput);
-
-            rightMotors.stop(vex::brakeType::hold);
-            leftMotors.spin(vex::directionType::fwd, output, vex::voltageUnits::volt);
+    return this->driveFor(distance.inches(), heading.degrees(), timeout, minOutput.volts(), maxOutput.volts());
+}
 
-            vex::task::sleep(10);
-            time += 0.01;
-        }
-    } else {
-        double lower = (direction == vex::directionType::fwd) ? 0.0 : -360.0;
-        double upper = (direction == vex::directionType::fwd) ? 360.0 : 0.0;
-        while (!swingPID->isSettled() && time < timeout)
-        {
-            double error = neblib::wrap(imu.heading(vex::rotationUnits::deg) - heading, lower, upper);
-            double output = swingPID->getOutput(error, minOutput, maxOutput);
+double neblib::DifferentialChassis::driveFor(Length distance, Time timeout, Voltage minOutput, Voltage maxOutput)
+{
+    return this->driveFor(distance.inches(), timeout, minOutput.volts(), maxOutput.volts());
+}
 
-            leftMotors.stop(vex::brakeType::hold);
-            rightMotors.spin(vex::directionType::fwd, output, vex::voltageUnits::volt);
+double neblib::DifferentialChassis::arcTo(double x, double y, double heading, Time timeout, double minOutput, double maxOutput)
+{
+    return this->arcTo(x, y, heading, ChainConditions(0.0), timeout, minOutput, maxOutput);
+}
 
-            vex::task::sleep(10);
-            time += 0.01;
-        }
+double neblib::DifferentialChassis::arcTo(double x, double y, double heading, ChainConditions chain, Time timeout, double minOutput, double maxOutput)
+{
+    if (!positionTracking)
+        return -1;
+
+    const Pose current = positionTracking->getPose();
+    const double dx = current.x - x;
+    const double dy = current.y - y;
+    const double distanceSquared = dx * dx + dy * dy;
+    if (distanceSquared < 1e-12)
+        return 0;
+
+    // Circle tangent to the target heading at the target that passes through the robot,
+    // signed radius is positive when the center is right of the target heading
+    double normalX;
+    double normalY;
+    neblib::Rotation(heading).toGlobal(1.0, 0.0, normalX, normalY);
+    const double normalDistance = dx * normalX + dy * normalY;
+
+    // On the line of the target heading there is no circle, drive the line straight if the target heading leads away from the robot
+    const double distance = std::sqrt(distanceSquared);
+    if (std::abs(normalDistance) < 0.01 * distance)
+    {
+        double headingX;
+        double headingY;
+        neblib::Rotation(heading).toGlobal(0.0, 1.0, headingX, headingY);
+        if (dx * headingX + dy * headingY > 0.0)
+            return -3;
+        if (std::abs(neblib::wrap(heading - current.heading, -180.0, 180.0)) > 90.0)
+            return this->driveFor(-distance, heading + 180.0, chain, timeout, minOutput, maxOutput);
+        return this->driveFor(distance, heading, chain, timeout, minOutput, maxOutput);
     }
 
-    this->stop(vex::brakeType::hold);
+    const double signedRadius = distanceSquared / (2.0 * normalDistance);
+    const double centerX = x + signedRadius * normalX;
+    const double centerY = y + signedRadius * normalY;
 
-    return time;
+    // Driving forward into the target heading circles clockwise around a center on the right
+    const bool clockwise = signedRadius > 0.0;
+    const double startPolar = atan2(current.y - centerY, current.x - centerX);
+    const double endPolar = atan2(y - centerY, x - centerX);
+    double angle = (clockwise) ? startPolar - endPolar : endPolar - startPolar;
+    angle = neblib::wrap(angle, 0.0, 2.0 * M_PI);
+
+    // Back along the same arc if the robot faces away from it, ending opposite the target heading
+    const double tangentHeading = 90.0 - neblib::toDeg(startPolar + ((clockwise) ? -M_PI_2 : M_PI_2));
+    const bool reverse = std::abs(neblib::wrap(tangentHeading - current.heading, -180.0, 180.0)) > 90.0;
+
+    return toElapsed(followArc(centerX, centerY, std::abs(signedRadius), clockwise, reverse, angle, chain, neblib::toTimeout(timeout), minOutput, maxOutput));
 }
 
-double neblib::StandardDrive::swingTo(vex::turnType turnDirection, vex::directionType direction, double heading, double timeout)
+double neblib::DifferentialChassis::arcFor(double radius, double degrees, Time timeout, double minOutput, double maxOutput)
 {
-    return this->swingTo(turnDirection, direction, heading, -infinity(), infinity(), timeout);
+    return this->arcFor(radius, degrees, ChainConditions(0.0), timeout, minOutput, maxOutput);
 }
 
-double neblib::StandardDrive::swingTo(vex::turnType turnDirection, double heading, double minOutput, double maxOutput, double timeout)
+double neblib::DifferentialChassis::arcFor(double radius, double degrees, ChainConditions chain, Time timeout, double minOutput, double maxOutput)
 {
-    swingPID->reset();
-    double time = 0.0;
-    if (turnDirection == vex::turnType::right)
-    {
-        while (!swingPID->isSettled() && time < timeout)
-        {
-            double error = neblib::wrap(heading - imu.heading(vex::rotationUnits::deg), -180.0, 180.0);
-            double output = swingPID->getOutput(error, minOutput, maxOutput);
+    if (!positionTracking)
+        return -1;
+
+    const Pose current = positionTracking->getPose();
+    const bool clockwise = degrees > 0.0;
+    double centerX;
+    double centerY;
+    neblib::Transform(current).toGlobal((clockwise) ? radius : -radius, 0.0, centerX, centerY);
 
-            rightMotors.stop(vex::brakeType::hold);
-            leftMotors.spin(vex::directionType::fwd, output, vex::voltageUnits::volt);
+    return toElapsed(followArc(centerX, centerY, std::abs(radius), clockwise, false, neblib::toRad(std::abs(degrees)), chain, neblib::toTimeout(timeout), minOutput, maxOutput));
+}
 
-            vex::task::sleep(10);
-            time += 0.01;
+int neblib::DifferentialChassis::followArc(double centerX, double centerY, double radius, bool clockwise, bool reverse, double angle, ChainConditions chain, int timeout, double minOutput, double maxOutput)
+{
+    if (!positionTracking)
+        return -1;
+    if (!linearController)
+        return -2;
+
+    resetController(linearController, previousLinearOutput);
+    if (angularController)
+        resetController(angularController, previousAngularOutput);
+
+    const double direction = (clockwise) ? 1.0 : -1.0;
+    Pose current = positionTracking->getPose();
+    double previousPolar = atan2(current.y - centerY, current.x - centerX);
+    double traveled = 0.0;
+    int time = 0;
+    beginMotion(neblib::TelemetryRecord::Arc);
+    bool exitedEarly = false;
+
+    while (!linearController->isSettled() && time < timeout && !motionCancelled())
+    {
+        NEBLIB_TRACE_SCOPE("followArc");
+        current = positionTracking->getPose();
+        const double offsetX = current.x - centerX;
+        const double offsetY = current.y - centerY;
+
+        // ---------- Progress Along the Arc ----------
+        const double polar = atan2(offsetY, offsetX);
+        traveled -= direction * neblib::wrap(polar - previousPolar, -M_PI, M_PI);
+        previousPolar = polar;
+        const double remaining = radius * (angle - traveled);
+        if (std::abs(remaining) < chain.exitRadius)
+        {
+            exitedEarly = true;
+            break;
         }
-    } else {
-        while (!swingPID->isSettled() && time < timeout)
+
+        double linearOutput = linearController->getOutput(remaining, minOutput, maxOutput);
+        if (std::abs(linearOutput) < chain.minSpeed)
+            linearOutput = (remaining < 0.0) ? -chain.minSpeed : chain.minSpeed;
+        if (reverse)
+            linearOutput = -linearOutput;
+
+        // ---------- Heading and Cross-Track Feedback ----------
+        const double crossTrackError = hypot(offsetX, offsetY) - radius;
+        const double tangentHeading = 90.0 - neblib::toDeg(polar - direction * M_PI_2);
+        const double correction = direction * neblib::toDeg(atan(crossTrackError / arcLookahead));
+        const double targetHeading = tangentHeading + correction + ((reverse) ? 180.0 : 0.0);
+        const double angularError = neblib::wrap(targetHeading - current.heading, -180.0, 180.0);
+        const double angularOutput = (angularController) ? angularController->getOutput(angularError, -12.0, 12.0) : 0.0;
+
+        // ---------- Wheel Speed Ratio From Curvature ----------
+        const double curvatureOutput = direction * std::abs(linearOutput) * trackWidth / (2.0 * radius);
+        double leftOutput = linearOutput + curvatureOutput + angularOutput;
+        double rightOutput = linearOutput - curvatureOutput - angularOutput;
+        const double largest = std::max(std::abs(leftOutput), std::abs(rightOutput));
+        if (largest > 12.0)
         {
-            double error = neblib::wrap(imu.heading(vex::rotationUnits::deg) - heading, -180.0, 180.0);
-            double output = swingPID->getOutput(error, minOutput, maxOutput);
+            leftOutput *= 12.0 / largest;
+            rightOutput *= 12.0 / largest;
+        }
 
-            leftMotors.stop(vex::brakeType::hold);
-            rightMotors.spin(vex::directionType::fwd, output, vex::voltageUnits::volt);
+        spinMotors(leftMotors, leftOutput);
+        spinMotors(rightMotors, rightOutput);
+        record(TelemetryRecord::Arc, remaining, angularError, linearOutput, angularOutput);
+        previousLinearOutput = linearOutput;
+        previousAngularOutput = angularOutput;
 
-            vex::task::sleep(10);
-            time += 0.01;
-        }
+        time += waitForTick();
     }
 
-    this->stop(vex::brakeType::hold);
+    leaveControl();
+    if (exitedEarly)
+        chained = true;
+    else
+        this->stop(vex::brakeType::hold);
 
     return time;
 }
-
-double neblib::StandardDrive::swingTo(vex::turnType turnDirection, double heading, double timeout)
-{
-    return this->swingTo(turnDirection, heading, -infinity(), infinity(), timeout);
-}
\ No newline at end of file
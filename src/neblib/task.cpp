@@ -0,0 +1,60 @@
+#include "neblib/task.hpp"
+
+namespace
+{
+    // Zero-initialized, so every slot starts as TaskSlot::Free
+    neblib::TaskSlot taskPool[neblib::maxTasks];
+}
+
+neblib::TaskSlot *neblib::acquireTaskSlot(int references)
+{
+    for (std::size_t i = 0; i < maxTasks; i++)
+    {
+        int expected = TaskSlot::Free;
+        if (taskPool[i].state.compare_exchange_strong(expected, TaskSlot::Running))
+        {
+            taskPool[i].returned.store(false);
+            taskPool[i].references.store(references);
+            return &taskPool[i];
+        }
+    }
+    return nullptr;
+}
+
+void neblib::releaseTaskSlot(neblib::TaskSlot *slot)
+{
+    // Only the owner whose decrement reaches zero gets here, and the slot stays claimed until the state is Free
+    if (slot->references.fetch_sub(1) != 1)
+        return;
+    if (slot->returned.load())
+        slot->destroyResult(*slot);
+    slot->state.store(TaskSlot::Free);
+}
+
+int neblib::runTaskSlot(void *parameters)
+{
+    TaskSlot *slot = static_cast<TaskSlot *>(parameters);
+    slot->run(*slot);
+
+    // If cancel() claimed the slot first, it stops this task and tears the slot down
+    int expected = TaskSlot::Running;
+    if (!slot->state.compare_exchange_strong(expected, TaskSlot::Finished))
+        return 0;
+    slot->destroyCallable(*slot);
+    releaseTaskSlot(slot);
+    return 0;
+}
+
+bool neblib::cancelTaskSlot(neblib::TaskSlot *slot)
+{
+    // Claim the slot before touching it, so a task finishing at the same time leaves the teardown to this side
+    int expected = TaskSlot::Running;
+    if (!slot->state.compare_exchange_strong(expected, TaskSlot::Cancelled))
+        return false;
+
+    slot->task.stop();
+    slot->destroyCallable(*slot);
+    // The stopped task never releases its own ownership
+    releaseTaskSlot(slot);
+    return true;
+}
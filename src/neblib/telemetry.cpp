@@ -0,0 +1,53 @@
+#include "neblib/telemetry.hpp"
+#include "vex.h"
+
+neblib::TelemetryLogger::TelemetryLogger(
+    neblib::TelemetryQueue &queue,
+    void (*sink)(const neblib::TelemetryRecord &record, void *context),
+    void *context,
+    int periodMS)
+    : queue(queue),
+      sink(sink),
+      context(context),
+      periodMS(periodMS),
+      running(false),
+      drained(0)
+{
+}
+
+int neblib::TelemetryLogger::begin()
+{
+    running = true;
+    while (running)
+    {
+        drain();
+        vex::task::sleep(periodMS);
+    }
+    drain();
+
+    return 0;
+}
+
+void neblib::TelemetryLogger::stop()
+{
+    running = false;
+}
+
+int neblib::TelemetryLogger::drain()
+{
+    neblib::TelemetryRecord record;
+    int count = 0;
+    while (queue.pop(record))
+    {
+        if (sink)
+            sink(record, context);
+        count++;
+    }
+    drained += count;
+    return count;
+}
+
+std::uint32_t neblib::TelemetryLogger::getDrained()
+{
+    return drained;
+}
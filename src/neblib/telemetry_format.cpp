@@ -0,0 +1,234 @@
+#include "neblib/telemetry_format.hpp"
+#include <cmath>
+
+namespace
+{
+    constexpr std::size_t fieldCount = 7 + neblib::TelemetryRecord::voltageCount;
+
+    /// @brief Number of float fields in a version 1 record, which has no voltages
+    constexpr std::size_t version1FieldCount = 7;
+
+    /// @brief Fixed point scale of each float field, in the order they are encoded
+    const float fieldScales[fieldCount] = {100.0f, 100.0f, 100.0f, 100.0f, 100.0f, 1000.0f, 1000.0f,
+                                           1000.0f, 1000.0f, 1000.0f, 1000.0f, 1000.0f, 1000.0f};
+
+    void getFields(
+        const neblib::TelemetryRecord &record,
+        float (&fields)[fieldCount])
+    {
+        fields[0] = record.x;
+        fields[1] = record.y;
+        fields[2] = record.heading;
+        fields[3] = record.linearError;
+        fields[4] = record.angularError;
+        fields[5] = record.linearOutput;
+        fields[6] = record.angularOutput;
+        for (std::size_t i = 0; i < neblib::TelemetryRecord::voltageCount; i++)
+            fields[7 + i] = record.voltages[i];
+    }
+
+    void setFields(
+        neblib::TelemetryRecord &record,
+        const float (&fields)[fieldCount])
+    {
+        record.x = fields[0];
+        record.y = fields[1];
+        record.heading = fields[2];
+        record.linearError = fields[3];
+        record.angularError = fields[4];
+        record.linearOutput = fields[5];
+        record.angularOutput = fields[6];
+        for (std::size_t i = 0; i < neblib::TelemetryRecord::voltageCount; i++)
+            record.voltages[i] = fields[7 + i];
+    }
+
+    std::int32_t quantize(
+        float value,
+        float scale)
+    {
+        const double scaled = std::round(static_cast<double>(value) * scale);
+        if (!(scaled == scaled))
+            return 0;
+        if (scaled > 2147483647.0)
+            return 2147483647;
+        if (scaled < -2147483648.0)
+            return -2147483647 - 1;
+        return static_cast<std::int32_t>(scaled);
+    }
+
+    std::size_t writeVarint(
+        std::uint32_t value,
+        std::uint8_t *out)
+    {
+        std::size_t size = 0;
+        while (value >= 0x80)
+        {
+            out[size++] = static_cast<std::uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        out[size++] = static_cast<std::uint8_t>(value);
+        return size;
+    }
+
+    /// @return number of bytes read, 0 if the varint is cut short or too long
+    std::size_t readVarint(
+        const std::uint8_t *in,
+        std::size_t size,
+        std::uint32_t &value)
+    {
+        value = 0;
+        for (std::size_t i = 0; i < size && i < 5; i++)
+        {
+            value |= static_cast<std::uint32_t>(in[i] & 0x7F) << (7 * i);
+            if (!(in[i] & 0x80))
+                return i + 1;
+        }
+        return 0;
+    }
+
+    // Differences wrap modulo 2^32, so any pair of values round trips in 5 bytes
+    std::uint32_t zigzag(std::uint32_t difference)
+    {
+        return (difference << 1) ^ static_cast<std::uint32_t>(-static_cast<std::int32_t>(difference >> 31));
+    }
+
+    std::uint32_t unzigzag(std::uint32_t value)
+    {
+        return (value >> 1) ^ static_cast<std::uint32_t>(-static_cast<std::int32_t>(value & 1));
+    }
+} // namespace
+
+constexpr std::size_t neblib::TelemetryRecord::voltageCount;
+
+neblib::TelemetryRecord::TelemetryRecord()
+    : time(0),
+      source(Drive),
+      loopTime(0),
+      x(0.0f),
+      y(0.0f),
+      heading(0.0f),
+      linearError(0.0f),
+      angularError(0.0f),
+      linearOutput(0.0f),
+      angularOutput(0.0f),
+      voltages()
+{
+}
+
+std::size_t neblib::telemetry_format::writeHeader(std::uint8_t *out)
+{
+    out[0] = 'N';
+    out[1] = 'B';
+    out[2] = 'T';
+    out[3] = 'L';
+    out[4] = version;
+    return headerSize;
+}
+
+int neblib::telemetry_format::readHeader(
+    const std::uint8_t *in,
+    std::size_t size)
+{
+    if (size < headerSize || in[0] != 'N' || in[1] != 'B' || in[2] != 'T' || in[3] != 'L')
+        return -1;
+    return in[4];
+}
+
+void neblib::telemetry_format::writeBlockHeader(
+    std::uint8_t *out,
+    std::uint16_t payloadSize,
+    std::uint16_t count)
+{
+    out[0] = static_cast<std::uint8_t>(payloadSize);
+    out[1] = static_cast<std::uint8_t>(payloadSize >> 8);
+    out[2] = static_cast<std::uint8_t>(count);
+    out[3] = static_cast<std::uint8_t>(count >> 8);
+}
+
+void neblib::telemetry_format::readBlockHeader(
+    const std::uint8_t *in,
+    std::uint16_t &payloadSize,
+    std::uint16_t &count)
+{
+    payloadSize = static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+    count = static_cast<std::uint16_t>(in[2] | (in[3] << 8));
+}
+
+neblib::TelemetryEncoder::TelemetryEncoder()
+{
+    reset();
+}
+
+void neblib::TelemetryEncoder::reset()
+{
+    previousTime = 0;
+    for (std::size_t i = 0; i < fieldCount; i++)
+        previous[i] = 0;
+}
+
+std::size_t neblib::TelemetryEncoder::encode(
+    const neblib::TelemetryRecord &record,
+    std::uint8_t *out)
+{
+    std::size_t size = 0;
+    size += writeVarint(record.time - previousTime, out + size);
+    size += writeVarint(record.source, out + size);
+    size += writeVarint(record.loopTime, out + size);
+    previousTime = record.time;
+
+    float fields[fieldCount];
+    getFields(record, fields);
+    for (std::size_t i = 0; i < fieldCount; i++)
+    {
+        const std::int32_t value = quantize(fields[i], fieldScales[i]);
+        size += writeVarint(zigzag(static_cast<std::uint32_t>(value) - static_cast<std::uint32_t>(previous[i])), out + size);
+        previous[i] = value;
+    }
+
+    return size;
+}
+
+neblib::TelemetryDecoder::TelemetryDecoder(int version)
+    : fieldsPerRecord((version == 1) ? version1FieldCount : fieldCount)
+{
+    reset();
+}
+
+void neblib::TelemetryDecoder::reset()
+{
+    previousTime = 0;
+    for (std::size_t i = 0; i < fieldCount; i++)
+        previous[i] = 0;
+}
+
+std::size_t neblib::TelemetryDecoder::decode(
+    const std::uint8_t *in,
+    std::size_t size,
+    neblib::TelemetryRecord &record)
+{
+    std::size_t position = 0;
+    std::uint32_t values[3 + fieldCount] = {};
+    for (std::size_t i = 0; i < 3 + fieldsPerRecord; i++)
+    {
+        const std::size_t read = readVarint(in + position, size - position, values[i]);
+        if (read == 0)
+            return 0;
+        position += read;
+    }
+
+    previousTime += values[0];
+    record.time = previousTime;
+    record.source = static_cast<std::uint16_t>(values[1]);
+    record.loopTime = static_cast<std::uint16_t>(values[2]);
+
+    // Fields a version 1 log does not have stay zero
+    float fields[fieldCount] = {};
+    for (std::size_t i = 0; i < fieldsPerRecord; i++)
+    {
+        previous[i] = static_cast<std::int32_t>(static_cast<std::uint32_t>(previous[i]) + unzigzag(values[3 + i]));
+        fields[i] = static_cast<float>(previous[i] / static_cast<double>(fieldScales[i]));
+    }
+    setFields(record, fields);
+
+    return position;
+}
@@ -0,0 +1,179 @@
+#include "neblib/telemetry_writer.hpp"
+
+neblib::SdTelemetryWriter::SdTelemetryWriter(
+    vex::brain::sdcard &sdCard,
+    const char *fileName,
+    std::size_t blockSize,
+    int periodMS)
+    : sdCard(sdCard),
+      fileName(fileName),
+      blockSize(blockSize),
+      periodMS(periodMS),
+      activeBuffer(0),
+      activeSize(neblib::telemetry_format::blockHeaderSize),
+      activeCount(0),
+      pendingBuffer(-1),
+      pendingSize(0),
+      encoder(),
+      opened(false),
+      running(false),
+      written(0),
+      dropped(0),
+      bytesWritten(0),
+      writeErrors(0),
+      maxFlushTime(0)
+{
+    const std::size_t minSize = neblib::telemetry_format::blockHeaderSize + neblib::telemetry_format::maxRecordSize;
+    if (this->blockSize < minSize)
+        this->blockSize = minSize;
+    if (this->blockSize > 65535)
+        this->blockSize = 65535;
+
+    buffers[0].resize(this->blockSize);
+    buffers[1].resize(this->blockSize);
+}
+
+int neblib::SdTelemetryWriter::open()
+{
+    if (!sdCard.isInserted())
+        return -1;
+
+    std::uint8_t header[neblib::telemetry_format::headerSize];
+    const std::size_t size = neblib::telemetry_format::writeHeader(header);
+    if (sdCard.savefile(fileName, header, static_cast<std::int32_t>(size)) != static_cast<std::int32_t>(size))
+        return -2;
+
+    opened = true;
+    return 0;
+}
+
+bool neblib::SdTelemetryWriter::write(const neblib::TelemetryRecord &record)
+{
+    if (!opened)
+    {
+        dropped++;
+        return false;
+    }
+
+    if (activeSize + neblib::telemetry_format::maxRecordSize > blockSize && !swapBuffers())
+    {
+        dropped++;
+        return false;
+    }
+
+    activeSize += encoder.encode(record, buffers[activeBuffer].data() + activeSize);
+    activeCount++;
+    return true;
+}
+
+void neblib::SdTelemetryWriter::sink(
+    const neblib::TelemetryRecord &record,
+    void *writer)
+{
+    static_cast<neblib::SdTelemetryWriter *>(writer)->write(record);
+}
+
+bool neblib::SdTelemetryWriter::swapBuffers()
+{
+    if (pendingBuffer.load() != -1)
+        return false;
+
+    neblib::telemetry_format::writeBlockHeader(
+        buffers[activeBuffer].data(),
+        static_cast<std::uint16_t>(activeSize - neblib::telemetry_format::blockHeaderSize),
+        activeCount);
+    pendingSize = activeSize;
+    pendingBuffer.store(activeBuffer);
+
+    activeBuffer ^= 1;
+    activeSize = neblib::telemetry_format::blockHeaderSize;
+    activeCount = 0;
+    encoder.reset();
+    return true;
+}
+
+void neblib::SdTelemetryWriter::writeBuffer(
+    int buffer,
+    std::size_t size)
+{
+    std::uint16_t payloadSize = 0;
+    std::uint16_t count = 0;
+    neblib::telemetry_format::readBlockHeader(buffers[buffer].data(), payloadSize, count);
+
+    const std::uint64_t start = vex::timer::systemHighResolution();
+    const std::int32_t result = sdCard.appendfile(fileName, buffers[buffer].data(), static_cast<std::int32_t>(size));
+    const std::uint32_t flushTime = static_cast<std::uint32_t>(vex::timer::systemHighResolution() - start);
+
+    if (flushTime > maxFlushTime)
+        maxFlushTime = flushTime;
+    if (result != static_cast<std::int32_t>(size))
+    {
+        writeErrors++;
+        return;
+    }
+    bytesWritten += static_cast<std::uint32_t>(size);
+    written += count;
+}
+
+int neblib::SdTelemetryWriter::begin()
+{
+    running = true;
+    while (running)
+    {
+        const int buffer = pendingBuffer.load();
+        if (buffer != -1)
+        {
+            writeBuffer(buffer, pendingSize);
+            pendingBuffer.store(-1);
+        }
+        vex::task::sleep(periodMS);
+    }
+
+    return 0;
+}
+
+void neblib::SdTelemetryWriter::stop()
+{
+    running = false;
+}
+
+void neblib::SdTelemetryWriter::flush()
+{
+    const int buffer = pendingBuffer.load();
+    if (buffer != -1)
+    {
+        writeBuffer(buffer, pendingSize);
+        pendingBuffer.store(-1);
+    }
+
+    if (activeCount > 0 && swapBuffers())
+    {
+        writeBuffer(pendingBuffer.load(), pendingSize);
+        pendingBuffer.store(-1);
+    }
+}
+
+std::uint32_t neblib::SdTelemetryWriter::getWritten()
+{
+    return written;
+}
+
+std::uint32_t neblib::SdTelemetryWriter::getDropped()
+{
+    return dropped;
+}
+
+std::uint32_t neblib::SdTelemetryWriter::getBytesWritten()
+{
+    return bytesWritten;
+}
+
+std::uint32_t neblib::SdTelemetryWriter::getWriteErrors()
+{
+    return writeErrors;
+}
+
+std::uint32_t neblib::SdTelemetryWriter::getMaxFlushTime()
+{
+    return maxFlushTime;
+}
@@ -0,0 +1,99 @@
+#include "neblib/trace.hpp"
+#include <atomic>
+#include <cstdio>
+#include "vex.h"
+
+#if defined(NEBLIB_TRACE)
+namespace
+{
+    neblib::TraceEvent traceEvents[neblib::traceCapacity];
+    std::atomic<std::uint32_t> traceNext(0); //< Number of events recorded since the last clear
+} // namespace
+#endif
+
+void neblib::recordTrace(
+    const char *name,
+    std::uint64_t start,
+    std::uint64_t end)
+{
+#if defined(NEBLIB_TRACE)
+    neblib::TraceEvent &event = traceEvents[traceNext.fetch_add(1) % traceCapacity];
+    event.name = name;
+    event.start = static_cast<std::uint32_t>(start);
+    event.duration = static_cast<std::uint32_t>(end - start);
+    event.task = static_cast<std::int32_t>(vex::this_thread::get_id());
+#else
+    (void)name;
+    (void)start;
+    (void)end;
+#endif
+}
+
+std::size_t neblib::getTraceCount()
+{
+#if defined(NEBLIB_TRACE)
+    const std::uint32_t recorded = traceNext.load();
+    return (recorded < traceCapacity) ? recorded : traceCapacity;
+#else
+    return 0;
+#endif
+}
+
+std::size_t neblib::getTraceLost()
+{
+#if defined(NEBLIB_TRACE)
+    const std::uint32_t recorded = traceNext.load();
+    return (recorded > traceCapacity) ? recorded - traceCapacity : 0;
+#else
+    return 0;
+#endif
+}
+
+void neblib::clearTrace()
+{
+#if defined(NEBLIB_TRACE)
+    traceNext.store(0);
+#endif
+}
+
+int neblib::exportChromeTrace(const char *fileName)
+{
+    std::FILE *file = std::fopen(fileName, "w");
+    if (!file)
+        return -1;
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    int written = 0;
+#if defined(NEBLIB_TRACE)
+    const std::uint32_t recorded = traceNext.load();
+    const std::uint32_t first = (recorded > traceCapacity) ? recorded - traceCapacity : 0;
+    for (std::uint32_t i = first; i < recorded; i++)
+    {
+        const neblib::TraceEvent &event = traceEvents[i % traceCapacity];
+        std::fprintf(
+            file,
+            "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%ld,\"ts\":%lu,\"dur\":%lu}",
+            (written > 0) ? "," : "",
+            event.name,
+            static_cast<long>(event.task),
+            static_cast<unsigned long>(event.start),
+            static_cast<unsigned long>(event.duration));
+        written++;
+    }
+#endif
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+
+    return written;
+}
+
+neblib::TraceScope::TraceScope(const char *name)
+    : name(name),
+      start(vex::timer::systemHighResolution())
+{
+}
+
+neblib::TraceScope::~TraceScope()
+{
+    neblib::recordTrace(name, start, vex::timer::systemHighResolution());
+}
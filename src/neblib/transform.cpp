@@ -0,0 +1,142 @@
+#include "neblib/transform.hpp"
+
+namespace
+{
+    /// @brief sin(angle) / angle and (1 - cos(angle)) / angle, by series near 0 where they lose precision
+    void arcTerms(
+        double angle,
+        double &sinTerm,
+        double &cosTerm)
+    {
+        if (std::abs(angle) < 1e-6)
+        {
+            sinTerm = 1.0 - angle * angle / 6.0;
+            cosTerm = angle / 2.0;
+            return;
+        }
+        sinTerm = std::sin(angle) / angle;
+        cosTerm = (1.0 - std::cos(angle)) / angle;
+    }
+
+    /// @brief Heading of a transform within [0, 360), so adding it to a heading in [0, 360) needs one correction
+    double headingOffset(const neblib::Transform &transform)
+    {
+        return neblib::wrap(transform.getRotation().degrees(), 0.0, 360.0);
+    }
+} // namespace
+
+neblib::Pose neblib::Transform::toPose() const
+{
+    double heading = neblib::wrap(rotation.degrees(), 0.0, 360.0);
+    if (heading >= 360.0)
+        heading = 0.0;
+    return Pose(x, y, heading);
+}
+
+neblib::Transform neblib::Transform::exp(const Twist &twist)
+{
+    const double angle = twist.turn * M_PI / 180.0;
+    double sinTerm;
+    double cosTerm;
+    arcTerms(angle, sinTerm, cosTerm);
+
+    return Transform(
+        twist.right * sinTerm + twist.forward * cosTerm,
+        twist.forward * sinTerm - twist.right * cosTerm,
+        Rotation::fromRadians(angle));
+}
+
+neblib::Twist neblib::Transform::log() const
+{
+    // The shortest turn, so a transform a full turn away gives a small twist
+    const double angle = neblib::wrap(rotation.degrees(), -180.0, 180.0) * M_PI / 180.0;
+    double sinTerm;
+    double cosTerm;
+    arcTerms(angle, sinTerm, cosTerm);
+
+    const double scale = 1.0 / (sinTerm * sinTerm + cosTerm * cosTerm);
+    return Twist(
+        (sinTerm * x - cosTerm * y) * scale,
+        (cosTerm * x + sinTerm * y) * scale,
+        angle * 180.0 / M_PI);
+}
+
+void neblib::transformPoints(
+    const Transform &transform,
+    const double *right,
+    const double *forward,
+    double *x,
+    double *y,
+    std::size_t count)
+{
+    const double sine = transform.getRotation().sin();
+    const double cosine = transform.getRotation().cos();
+    const double offsetX = transform.getX();
+    const double offsetY = transform.getY();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const double localRight = right[i];
+        const double localForward = forward[i];
+        x[i] = offsetX + localRight * cosine + localForward * sine;
+        y[i] = offsetY + localForward * cosine - localRight * sine;
+    }
+}
+
+void neblib::inverseTransformPoints(
+    const Transform &transform,
+    const double *x,
+    const double *y,
+    double *right,
+    double *forward,
+    std::size_t count)
+{
+    const double sine = transform.getRotation().sin();
+    const double cosine = transform.getRotation().cos();
+    const double offsetX = transform.getX();
+    const double offsetY = transform.getY();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const double dx = x[i] - offsetX;
+        const double dy = y[i] - offsetY;
+        right[i] = dx * cosine - dy * sine;
+        forward[i] = dx * sine + dy * cosine;
+    }
+}
+
+void neblib::transformPoses(
+    const Transform &transform,
+    double *x,
+    double *y,
+    double *heading,
+    std::size_t count)
+{
+    transformPoints(transform, x, y, x, y, count);
+
+    const double offset = headingOffset(transform);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const double sum = heading[i] + offset;
+        heading[i] = (sum >= 360.0) ? sum - 360.0 : sum;
+    }
+}
+
+void neblib::transformPoses(
+    const Transform &transform,
+    Pose *poses,
+    std::size_t count)
+{
+    const double sine = transform.getRotation().sin();
+    const double cosine = transform.getRotation().cos();
+    const double offsetX = transform.getX();
+    const double offsetY = transform.getY();
+    const double offset = headingOffset(transform);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const double right = poses[i].x;
+        const double forward = poses[i].y;
+        const double sum = poses[i].heading + offset;
+        poses[i].x = offsetX + right * cosine + forward * sine;
+        poses[i].y = offsetY + forward * cosine - right * sine;
+        poses[i].heading = (sum >= 360.0) ? sum - 360.0 : sum;
+    }
+}
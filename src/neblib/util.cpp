@@ -1,8 +1,10 @@
 #include "neblib/util.hpp"
+#include "neblib/random.hpp"
+#include <cmath>
 
 namespace
 {
-    static std::mt19937 random_generator(std::random_device{}());
+    static neblib::Random random_generator(std::random_device{}());
 }
 
 double neblib::toRad(double degrees)
@@ -26,23 +28,36 @@ double neblib::clamp(double num, double min, double max)
 
 double neblib::wrap(double num, double min, double max)
 {
-    while (num < min)
-        num += (max - min);
-    while (num > max)
-        num -= (max - min);
-    return num;
+    const double range = max - min;
+    if (num >= min && num <= max)
+        return num;
+    if (!(range > 0.0))
+        return num;
+
+    // Same result as repeatedly adding or subtracting the range: values below
+    // the range land in [min, max), values above it land in (min, max]
+    if (num < min)
+    {
+        const double remainder = std::fmod(min - num, range);
+        return (remainder == 0.0) ? min : max - remainder;
+    }
+    const double remainder = std::fmod(num - max, range);
+    return (remainder == 0.0) ? max : min + remainder;
 }
 
 double neblib::gaussRandom(double mean, double stddev)
 {
-    std::normal_distribution<double> dist(mean, stddev);
-    return dist(random_generator);
+    return random_generator.gauss(mean, stddev);
 }
 
 double neblib::uniformRandom(double min, double max)
 {
-    std::uniform_real_distribution<double> dist(min, max);
-    return dist(random_generator);
+    return random_generator.uniform(min, max);
+}
+
+void neblib::seedRandom(std::uint64_t seed)
+{
+    random_generator.seed(seed);
 }
 
 bool neblib::contains(const char *str, const char *substr)
@@ -70,4 +85,15 @@ bool neblib::contains(const char *str, const char *substr)
     }
 
     return false;
-}
\ No newline at end of file
+}
+
+std::uint32_t neblib::hash(const void *data, std::size_t size, std::uint32_t seed)
+{
+    const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        seed ^= bytes[i];
+        seed *= 16777619u;
+    }
+    return seed;
+}
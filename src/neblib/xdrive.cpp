@@ -1,58 +1,73 @@
 #include "neblib/xdrive.hpp"
+#include "neblib/transform.hpp"
 
-neblib::XDrive::XDrive(
-    vex::motor_group &leftFront,
-    vex::motor_group &rightFront,
-    vex::motor_group &leftBack,
-    vex::motor_group &rightBack,
-    vex::inertial &imu,
-    neblib::PositionTracking *positionTracking)
-    : leftFront(leftFront),
-      rightFront(rightFront),
-      leftBack(leftBack),
-      rightBack(rightBack),
-      imu(imu),
-      positionTracking(positionTracking),
-      linearController(nullptr),
-      angularController(nullptr)
+namespace
 {
+    /// @brief Largest velocity a motor accepts in a unit, infinity when it depends on the cartridge
+    double maxOutput(vex::velocityUnits unit)
+    {
+        if (unit == vex::velocityUnits::pct)
+            return 100.0;
+        return neblib::infinity();
+    }
+
+    /// @brief Largest voltage a motor accepts in a unit
+    double maxOutput(vex::voltageUnits unit)
+    {
+        if (unit == vex::voltageUnits::mV)
+            return 12000.0;
+        return 12.0;
+    }
 }
 
-void neblib::XDrive::setLinearController(neblib::FeedbackController *linearController)
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::setKinematics(const neblib::HolonomicKinematics<Wheels> &kinematics)
 {
-    this->linearController = linearController;
+    this->kinematics = kinematics;
 }
 
-void neblib::XDrive::setAngularController(neblib::FeedbackController *angularController)
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::setMotorOutput(
+    neblib::MotorOutput *motorOutput,
+    neblib::MotorOutput::Limits limits)
 {
-    this->angularController = angularController;
+    this->motorOutput = motorOutput;
+    if (!motorOutput)
+        return;
+    for (std::size_t i = 0; i < Wheels; i++)
+        motorOutput->addGroup(*motors[i], limits);
 }
 
-void neblib::XDrive::driveLocal(
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveLocal(
     double drive,
     double strafe,
     double turn,
     vex::velocityUnits unit)
 {
-    leftFront.spin(vex::directionType::fwd, drive + strafe + turn, unit);
-    rightFront.spin(vex::directionType::fwd, drive - strafe - turn, unit);
-    leftBack.spin(vex::directionType::fwd, drive - strafe + turn, unit);
-    rightBack.spin(vex::directionType::fwd, drive + strafe - turn, unit);
+    double outputs[Wheels];
+    kinematics.mix(drive, strafe, turn, maxOutput(unit), outputs);
+
+    for (std::size_t i = 0; i < Wheels; i++)
+        spinMotors(*motors[i], outputs[i], unit);
 }
 
-void neblib::XDrive::driveLocal(
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveLocal(
     double drive,
     double strafe,
     double turn,
     vex::voltageUnits unit)
 {
-    leftFront.spin(vex::directionType::fwd, drive + strafe + turn, unit);
-    rightFront.spin(vex::directionType::fwd, drive - strafe - turn, unit);
-    leftBack.spin(vex::directionType::fwd, drive - strafe + turn, unit);
-    rightBack.spin(vex::directionType::fwd, drive + strafe - turn, unit);
+    double outputs[Wheels];
+    kinematics.mix(drive, strafe, turn, maxOutput(unit), outputs);
+
+    for (std::size_t i = 0; i < Wheels; i++)
+        spinMotors(*motors[i], outputs[i], unit);
 }
 
-void neblib::XDrive::driveAngle(
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveAngle(
     double drive,
     double angle,
     double turn,
@@ -66,7 +81,8 @@ void neblib::XDrive::driveAngle(
         unit);
 }
 
-void neblib::XDrive::driveAngle(
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveAngle(
     double drive,
     double angle,
     double turn,
@@ -80,161 +96,150 @@ void neblib::XDrive::driveAngle(
         unit);
 }
 
-void neblib::XDrive::driveGlobal(
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveField(
     double x,
     double y,
     double turn,
     vex::velocityUnits unit)
 {
-    driveAngle(
-        hypot(y, x),
-        90 - imu.heading() + neblib::toDeg(atan2(y, x)),
+    double strafe;
+    double drive;
+    neblib::Rotation(currentHeading()).toLocal(x, y, strafe, drive);
+    driveLocal(
+        drive,
+        strafe,
         turn,
         unit);
 }
 
-void neblib::XDrive::driveGlobal(
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveField(
     double x,
     double y,
     double turn,
     vex::voltageUnits unit)
 {
-    driveAngle(
-        hypot(y, x),
-        90 - imu.heading() + neblib::toDeg(atan2(y, x)),
+    double strafe;
+    double drive;
+    neblib::Rotation(currentHeading()).toLocal(x, y, strafe, drive);
+    driveLocal(
+        drive,
+        strafe,
         turn,
         unit);
 }
 
-void neblib::XDrive::stop(vex::brakeType brakeType)
-{
-    leftFront.stop(brakeType);
-    rightFront.stop(brakeType);
-    leftBack.stop(brakeType);
-    rightBack.stop(brakeType);
-}
-
-int neblib::XDrive::driveToPose(
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveGlobal(
     double x,
     double y,
-    double heading,
-    int timeout,
-    double minOutput,
-    double maxOutput)
-{
-    if (!positionTracking)
-        return -1;
-    if (!linearController)
-        return -2;
-
-    linearController->reset();
-    if (angularController)
-        angularController->reset();
-    int time = 0;
-
-    while (!linearController->isSettled() && time < timeout)
-    {
-        const neblib::Pose currentPose = positionTracking->getPose();
-        const double drive = linearController->getOutput(
-            hypot(x - currentPose.x, y - currentPose.y),
-            minOutput,
-            maxOutput);
-        double turn = 0.0;
-        if (angularController)
-            turn = angularController->getOutput(
-                neblib::wrap(heading - imu.heading(), -180.0, 180.0),
-                minOutput,
-                maxOutput);
-        const double angle = atan2(y - currentPose.y, x - currentPose.x);
-
-        driveGlobal(drive * cos(angle), drive * -sin(angle), turn, vex::voltageUnits::volt);
-        time += 10;
-        vex::task::sleep(10);
-    }
-
-    stop(vex::brakeType::hold);
-    return time;
+    double turn,
+    vex::velocityUnits unit)
+{
+    driveField(
+        x,
+        -y,
+        turn,
+        unit);
 }
 
-int neblib::XDrive::driveTo(
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveGlobal(
     double x,
     double y,
-    int timeout,
-    double minOutput,
-    double maxOutput)
+    double turn,
+    vex::voltageUnits unit)
 {
-    return driveToPose(
+    driveField(
         x,
-        y,
-        imu.heading(),
-        timeout,
-        minOutput,
-        maxOutput);
+        -y,
+        turn,
+        unit);
 }
 
-int neblib::XDrive::turnFor(
-    double degrees,
-    int timeout,
-    double minOutput,
-    double maxOutput)
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::stop(vex::brakeType brakeType)
 {
-    if (!angularController)
-        return -1;
+    for (std::size_t i = 0; i < Wheels; i++)
+        stopMotors(*motors[i], brakeType);
+    chained = false;
+}
 
-    angularController->reset();
-    int time = 0;
-    double target = imu.rotation() + degrees;
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::rotate(double output)
+{
+    driveLocal(
+        0.0,
+        0.0,
+        output,
+        vex::voltageUnits::volt);
+}
 
-    while (!angularController->isSettled() && time < timeout)
-    {
-        const double output = angularController->getOutput(
-            target - imu.rotation(),
-            minOutput,
-            maxOutput);
-
-        driveLocal(
-            0.0,
-            0.0,
-            output,
-            vex::voltageUnits::volt);
-
-        time += 10;
-        vex::task::sleep(10);
-    }
+template <std::size_t Wheels>
+int neblib::HolonomicChassis<Wheels>::toElapsed(int milliseconds)
+{
+    return milliseconds;
+}
+
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveCommand(
+    double drive,
+    double strafe,
+    double turn)
+{
+    driveLocal(
+        drive,
+        strafe,
+        turn,
+        vex::voltageUnits::volt);
+}
 
-    stop(vex::brakeType::hold);
-    return time;
+template <std::size_t Wheels>
+double neblib::HolonomicChassis<Wheels>::pointHeading(
+    const neblib::Pose & /*current*/,
+    double /*x*/,
+    double /*y*/)
+{
+    return currentHeading();
 }
 
-int neblib::XDrive::turnTo(
-    double heading,
-    int timeout,
-    double minOutput,
-    double maxOutput)
+template <std::size_t Wheels>
+double neblib::HolonomicChassis<Wheels>::angularError(
+    const neblib::Pose & /*current*/,
+    const neblib::Pose &target,
+    double /*distance*/)
 {
-    if (!angularController)
-        return -1;
+    return neblib::wrap(target.heading - currentHeading(), -180.0, 180.0);
+}
 
-    angularController->reset();
-    int time = 0;
+template <std::size_t Wheels>
+bool neblib::HolonomicChassis<Wheels>::atPose(
+    const neblib::Pose & /*current*/,
+    const neblib::Pose & /*target*/,
+    double /*distance*/)
+{
+    return false;
+}
 
-    while (!angularController->isSettled() && time < timeout)
+template <std::size_t Wheels>
+void neblib::HolonomicChassis<Wheels>::driveToward(
+    const neblib::Pose &current,
+    const neblib::Pose &target,
+    double drive,
+    double turn)
+{
+    const double dx = target.x - current.x;
+    const double dy = target.y - current.y;
+    const double distance = hypot(dx, dy);
+    if (distance < 1e-9)
     {
-        const double output = angularController->getOutput(
-            neblib::wrap(heading - imu.heading(), -180.0, 180.0),
-            minOutput,
-            maxOutput);
-
-        driveLocal(
-            0.0,
-            0.0,
-            output,
-            vex::voltageUnits::volt);
-
-        time += 10;
-        vex::task::sleep(10);
+        rotate(turn);
+        return;
     }
-
-    stop(vex::brakeType::hold);
-    return time;
+    driveField(drive * dx / distance, drive * dy / distance, turn, vex::voltageUnits::volt);
 }
+
+template class neblib::HolonomicChassis<3>;
+template class neblib::HolonomicChassis<4>;
+template class neblib::HolonomicChassis<6>;
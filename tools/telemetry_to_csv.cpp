@@ -0,0 +1,130 @@
+// Converts a telemetry log written by neblib::SdTelemetryWriter to CSV
+//
+// Build on a computer from the repository root:
+//   g++ -std=c++11 -O2 -Iinclude tools/telemetry_to_csv.cpp src/neblib/telemetry_format.cpp -o telemetry_to_csv
+//
+// Usage:
+//   telemetry_to_csv log.bin > log.csv
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "neblib/telemetry_format.hpp"
+
+namespace
+{
+    const char *sourceName(std::uint16_t source)
+    {
+        switch (source)
+        {
+        case neblib::TelemetryRecord::Drive:
+            return "drive";
+        case neblib::TelemetryRecord::Turn:
+            return "turn";
+        case neblib::TelemetryRecord::Swing:
+            return "swing";
+        case neblib::TelemetryRecord::Arc:
+            return "arc";
+        case neblib::TelemetryRecord::User:
+            return "user";
+        default:
+            return "unknown";
+        }
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "usage: %s <log file>\n", argv[0]);
+        return 1;
+    }
+
+    std::FILE *file = std::fopen(argv[1], "rb");
+    if (!file)
+    {
+        std::fprintf(stderr, "could not open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<std::uint8_t> data;
+    std::uint8_t chunk[4096];
+    std::size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+        data.insert(data.end(), chunk, chunk + read);
+    std::fclose(file);
+
+    const int version = neblib::telemetry_format::readHeader(data.data(), data.size());
+    if (version < 0)
+    {
+        std::fprintf(stderr, "%s is not a telemetry log\n", argv[1]);
+        return 1;
+    }
+    if (version < 1 || version > neblib::telemetry_format::version)
+    {
+        std::fprintf(stderr, "unsupported log version %d\n", version);
+        return 1;
+    }
+
+    // Voltages are per motor group, left then right on a Standard Drive, and 0 in version 1 logs
+    std::printf("time,source,loop_time,x,y,heading,linear_error,angular_error,linear_output,angular_output");
+    for (std::size_t i = 0; i < neblib::TelemetryRecord::voltageCount; i++)
+        std::printf(",voltage_%zu", i);
+    std::printf("\n");
+
+    std::size_t position = neblib::telemetry_format::headerSize;
+    std::size_t records = 0;
+    std::size_t blocks = 0;
+    neblib::TelemetryDecoder decoder(version);
+    while (position + neblib::telemetry_format::blockHeaderSize <= data.size())
+    {
+        std::uint16_t payloadSize = 0;
+        std::uint16_t count = 0;
+        neblib::telemetry_format::readBlockHeader(data.data() + position, payloadSize, count);
+        position += neblib::telemetry_format::blockHeaderSize;
+        if (position + payloadSize > data.size())
+        {
+            std::fprintf(stderr, "block %zu is cut short, stopping\n", blocks);
+            break;
+        }
+
+        decoder.reset();
+        const std::uint8_t *payload = data.data() + position;
+        std::size_t offset = 0;
+        for (std::uint16_t i = 0; i < count; i++)
+        {
+            neblib::TelemetryRecord record;
+            const std::size_t size = decoder.decode(payload + offset, payloadSize - offset, record);
+            if (size == 0)
+            {
+                std::fprintf(stderr, "block %zu is corrupt after %u records\n", blocks, static_cast<unsigned>(i));
+                break;
+            }
+            offset += size;
+            records++;
+
+            std::printf(
+                "%u,%s,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f",
+                static_cast<unsigned>(record.time),
+                sourceName(record.source),
+                static_cast<unsigned>(record.loopTime),
+                record.x,
+                record.y,
+                record.heading,
+                record.linearError,
+                record.angularError,
+                record.linearOutput,
+                record.angularOutput);
+            for (std::size_t v = 0; v < neblib::TelemetryRecord::voltageCount; v++)
+                std::printf(",%.3f", record.voltages[v]);
+            std::printf("\n");
+        }
+
+        position += payloadSize;
+        blocks++;
+    }
+
+    std::fprintf(stderr, "%zu records in %zu blocks\n", records, blocks);
+    return 0;
+}